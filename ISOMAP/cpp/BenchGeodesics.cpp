@@ -0,0 +1,168 @@
+// Benchmark del motor de geodésicas (todos los pares) sobre:
+//  - un grafo kNN ponderado de puntos sintéticos agrupados (Dijkstra), como el de ISOMAP;
+//  - un grafo social sin pesos de Barabási-Albert (BFS de arriba abajo y de dirección óptima),
+//    como el de colaboraciones entre actores;
+//  - o un grafo dado (--graph): CSR de isomap-cpp, o colaboraciones.edges de grafo-cpp.
+// Informa tiempo, pares/s, aristas examinadas por segundo y robos, y comprueba que las dos
+// variantes de BFS dan la misma matriz. Con --save DIR guarda cada grafo (.csr) y su matriz
+// (.geo) para compararlos con scipy (compare_scipy.py).
+// Uso: bench-geodesics [--graph RUTA] [--knn-samples N] [--dims N] [--k N] [--social-nodes N]
+//                      [--attach N] [--threads N] [--seed N] [--save DIR]
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "Geodesics.h"
+#include "NeighborGraph.h"
+
+static bool endsWith(const std::string& s, const std::string& suffix) {
+    return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+// Grafo de Barabási-Albert: cada nodo nuevo se une a `attach` nodos elegidos con
+// probabilidad proporcional a su grado
+static CsrGraph barabasiAlbert(size_t n, unsigned attach, std::mt19937& rng) {
+    std::vector<uint32_t> ends;   // Cada nodo aparece tantas veces como su grado
+    std::vector<std::pair<uint32_t, uint32_t>> edges;
+    for (uint32_t u = 1; u <= attach && u < n; ++u) {
+        edges.emplace_back(0, u);
+        ends.push_back(0);
+        ends.push_back(u);
+    }
+    std::vector<uint32_t> chosen;
+    for (uint32_t u = attach + 1; u < n; ++u) {
+        chosen.clear();
+        while (chosen.size() < attach) {
+            uint32_t v = ends[rng() % ends.size()];
+            if (std::find(chosen.begin(), chosen.end(), v) == chosen.end()) chosen.push_back(v);
+        }
+        for (uint32_t v : chosen) {
+            edges.emplace_back(v, u);
+            ends.push_back(v);
+            ends.push_back(u);
+        }
+    }
+    CsrGraph graph;
+    graph.offsets.assign(n + 1, 0);
+    for (const auto& [u, v] : edges) {
+        ++graph.offsets[u + 1];
+        ++graph.offsets[v + 1];
+    }
+    for (size_t u = 0; u < n; ++u) graph.offsets[u + 1] += graph.offsets[u];
+    graph.targets.resize(graph.offsets[n]);
+    std::vector<uint64_t> fill(graph.offsets.begin(), graph.offsets.end() - 1);
+    for (const auto& [u, v] : edges) {
+        graph.targets[fill[u]++] = v;
+        graph.targets[fill[v]++] = u;
+    }
+    for (size_t u = 0; u < n; ++u) std::sort(graph.targets.begin() + graph.offsets[u], graph.targets.begin() + graph.offsets[u + 1]);
+    return graph;
+}
+
+// Grafo kNN de nubes gaussianas
+static CsrGraph syntheticKnn(size_t n, size_t dims, unsigned k, unsigned threads, std::mt19937& rng) {
+    std::normal_distribution<float> noise(0.0f, 1.0f);
+    std::uniform_real_distribution<float> center(0.0f, 100.0f);
+    const size_t clusters = std::max<size_t>(1, n / 1000);
+    Matrix centers(clusters, dims), points(n, dims);
+    for (size_t c = 0; c < clusters; ++c)
+        for (size_t d = 0; d < dims; ++d) centers(c, d) = center(rng);
+    for (size_t i = 0; i < n; ++i) {
+        size_t c = i % clusters;
+        for (size_t d = 0; d < dims; ++d) points(i, d) = centers(c, d) + 20.0f * noise(rng);
+    }
+    NeighborOptions options;
+    options.threads = threads;
+    return knnGraph(nearestNeighbors(points, k, options), threads);
+}
+
+// Calcula y resume todas las geodésicas de un grafo
+static DistanceMatrix measure(const std::string& name, const CsrGraph& graph, GeodesicOptions options) {
+    GeodesicStats stats;
+    DistanceMatrix matrix = allPairsGeodesics(viewOf(graph), options, &stats);
+    const double n = static_cast<double>(graph.numNodes());
+    std::cout << std::left << std::setw(34) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(8) << stats.seconds << " s  " << std::setw(8) << n * n / stats.seconds / 1e6
+              << " M pares/s  " << std::setw(8) << stats.edgesExamined / stats.seconds / 1e6 << " M aristas/s  "
+              << stats.steals << " robos" << (stats.fileBacked ? "  (archivo)" : "") << "\n";
+    if (stats.unreachablePairs) std::cout << "  " << stats.unreachablePairs << " pares sin camino\n";
+    return matrix;
+}
+
+static void describe(const std::string& name, const CsrGraph& graph) {
+    std::cout << name << ": " << graph.numNodes() << " nodos, " << graph.numEdges() << " aristas"
+              << (graph.weights.empty() ? " (sin pesos)" : " (ponderado)") << "\n";
+}
+
+static int run(int argc, char* argv[]) {
+    std::string graphPath, saveDir;
+    size_t knnSamples = 4000, dims = 16, socialNodes = 10000;
+    unsigned k = 10, attach = 5, seed = 42;
+    GeodesicOptions options;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i], val = argv[i + 1];
+        if (arg == "--graph") graphPath = val;
+        else if (arg == "--save") saveDir = val;
+        else if (arg == "--knn-samples") knnSamples = std::stoul(val);
+        else if (arg == "--dims") dims = std::max(1ul, std::stoul(val));
+        else if (arg == "--k") k = static_cast<unsigned>(std::max(1ul, std::stoul(val)));
+        else if (arg == "--social-nodes") socialNodes = std::stoul(val);
+        else if (arg == "--attach") attach = static_cast<unsigned>(std::max(1ul, std::stoul(val)));
+        else if (arg == "--threads") options.threads = static_cast<unsigned>(std::max(1ul, std::stoul(val)));
+        else if (arg == "--seed") seed = static_cast<unsigned>(std::stoul(val));
+    }
+    std::cout << options.threads << " hilos\n";
+
+    // Guarda el grafo y escribe su matriz en un archivo (para compare_scipy.py)
+    auto spillTo = [&](const std::string& stem, const CsrGraph& graph) {
+        GeodesicOptions o = options;
+        if (!saveDir.empty()) {
+            writeCsr(graph, saveDir + "/" + stem + ".csr");
+            o.spillFile = saveDir + "/" + stem + ".geo";
+        }
+        return o;
+    };
+
+    if (!graphPath.empty()) {
+        CsrGraph graph;
+        bool ok = endsWith(graphPath, ".edges") || endsWith(graphPath, ".bin") ? readCollaborationEdges(graphPath, graph)
+                                                                                : readCsr(graphPath, graph);
+        if (!ok) {
+            std::cerr << "No se pudo leer " << graphPath << "\n";
+            return 1;
+        }
+        describe(graphPath, graph);
+        measure(graph.weights.empty() ? "BFS de dirección óptima" : "Dijkstra", graph, spillTo("grafo", graph));
+        return 0;
+    }
+
+    std::mt19937 rng(seed);
+    CsrGraph knn = syntheticKnn(knnSamples, dims, k, options.threads, rng);
+    describe("kNN sintético (k=" + std::to_string(k) + ")", knn);
+    measure("Dijkstra", knn, spillTo("knn", knn));
+
+    CsrGraph social = barabasiAlbert(socialNodes, attach, rng);
+    describe("Barabási-Albert (m=" + std::to_string(attach) + ")", social);
+    GeodesicOptions topDown = options;
+    topDown.directionOptimizing = false;
+    DistanceMatrix a = measure("BFS de arriba abajo", social, topDown);
+    DistanceMatrix b = measure("BFS de dirección óptima", social, spillTo("social", social));
+    bool same = true;
+    for (size_t i = 0; i < social.numNodes() && same; ++i)
+        for (size_t j = 0; j < social.numNodes() && same; ++j) same = a.at(i, j) == b.at(i, j);
+    std::cout << "Matrices BFS " << (same ? "idénticas" : "DIFERENTES") << "\n";
+    return same ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        return run(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
@@ -0,0 +1,139 @@
+// Benchmark de ISOMAP con landmarks frente al clásico sobre un rollo suizo (3D, variedad de
+// dimensión 2) de tamaño creciente: para cada n, ISOMAP clásico (si n <= --full-max, su matriz
+// de geodésicas es n x n) y con m landmarks elegidos al azar y con MaxMin. Informa el tiempo de
+// cada fase, la memoria de trabajo y el error de Procrustes (tras centrar y la mejor rotación o
+// reflexión) respecto al clásico.
+// Uso: bench-isomap [--samples N,N,...] [--landmarks M,M,...] [--k N] [--full-max N]
+//                   [--threads N] [--seed N]
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <numbers>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "Isomap.h"
+#include "NeighborGraph.h"
+#include "SymmetricEigen.h"
+
+static std::vector<size_t> parseList(const std::string& s) {
+    std::vector<size_t> out;
+    std::stringstream in(s);
+    for (std::string item; std::getline(in, item, ',');) out.push_back(std::stoul(item));
+    return out;
+}
+
+// Rollo suizo: t en [1.5π, 4.5π], altura en [0, 21], con ruido gaussiano pequeño
+static Matrix swissRoll(size_t n, std::mt19937& rng) {
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::normal_distribution<float> noise(0.0f, 0.05f);
+    Matrix points(n, 3);
+    for (size_t i = 0; i < n; ++i) {
+        const float t = 1.5f * std::numbers::pi_v<float> * (1.0f + 2.0f * unit(rng));
+        points(i, 0) = t * std::cos(t) + noise(rng);
+        points(i, 1) = 21.0f * unit(rng) + noise(rng);
+        points(i, 2) = t * std::sin(t) + noise(rng);
+    }
+    return points;
+}
+
+// Error relativo ||Y - X R|| / ||Y|| con la mejor matriz ortogonal R (ambas centradas):
+// ||Y||² + ||X||² - 2 * (suma de valores singulares de X^T Y)
+static double procrustesError(const IsomapEmbedding& reference, const IsomapEmbedding& other) {
+    const size_t n = reference.numPoints(), k = reference.components;
+    std::vector<double> meanY(k, 0.0), meanX(k, 0.0);
+    for (size_t i = 0; i < n; ++i)
+        for (size_t c = 0; c < k; ++c) {
+            meanY[c] += reference.point(i)[c] / n;
+            meanX[c] += other.point(i)[c] / n;
+        }
+    double normY = 0, normX = 0;
+    std::vector<double> M(k * k, 0.0);   // X^T Y
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t a = 0; a < k; ++a) {
+            const double x = other.point(i)[a] - meanX[a], y = reference.point(i)[a] - meanY[a];
+            normX += x * x;
+            normY += y * y;
+            for (size_t b = 0; b < k; ++b) M[a * k + b] += x * (reference.point(i)[b] - meanY[b]);
+        }
+    }
+    // Valores singulares: raíces de los valores propios de M^T M (k x k)
+    auto multiply = [&](const double* v, double* out) {
+        std::vector<double> t(k, 0.0);
+        for (size_t a = 0; a < k; ++a)
+            for (size_t b = 0; b < k; ++b) t[a] += M[a * k + b] * v[b];
+        for (size_t b = 0; b < k; ++b) {
+            out[b] = 0;
+            for (size_t a = 0; a < k; ++a) out[b] += M[a * k + b] * t[a];
+        }
+    };
+    double nuclear = 0;
+    for (double value : lanczosTopEigen(k, k, multiply).values) nuclear += std::sqrt(std::max(0.0, value));
+    return std::sqrt(std::max(0.0, normY + normX - 2.0 * nuclear) / normY);
+}
+
+static void report(const std::string& name, size_t m, const IsomapEmbedding& e, const IsomapEmbedding* reference) {
+    const double total = e.geodesicSeconds + e.eigenSeconds + e.triangulationSeconds;
+    std::cout << "  " << std::left << std::setw(9) << name << std::right << std::setw(7) << m << std::fixed
+              << std::setprecision(3) << std::setw(10) << e.geodesicSeconds << std::setw(10) << e.eigenSeconds
+              << std::setw(10) << e.triangulationSeconds << std::setw(10) << total << std::setprecision(1)
+              << std::setw(10) << e.workingBytes / 1048576.0 << std::setw(6) << e.lanczosIterations;
+    if (reference) std::cout << std::setprecision(4) << std::setw(10) << procrustesError(*reference, e);
+    std::cout << "\n";
+}
+
+static int run(int argc, char* argv[]) {
+    std::vector<size_t> samples = {2000, 4000, 8000, 32000}, landmarks = {25, 50, 100, 200};
+    size_t fullMax = 8000;
+    unsigned k = 10, seed = 42, threads = defaultThreadCount();
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i], val = argv[i + 1];
+        if (arg == "--samples") samples = parseList(val);
+        else if (arg == "--landmarks") landmarks = parseList(val);
+        else if (arg == "--k") k = static_cast<unsigned>(std::max(1ul, std::stoul(val)));
+        else if (arg == "--full-max") fullMax = std::stoul(val);
+        else if (arg == "--threads") threads = static_cast<unsigned>(std::max(1ul, std::stoul(val)));
+        else if (arg == "--seed") seed = static_cast<unsigned>(std::stoul(val));
+    }
+    std::cout << threads << " hilos, k=" << k << "\n";
+
+    std::mt19937 rng(seed);
+    for (size_t n : samples) {
+        NeighborOptions neighbors;
+        neighbors.threads = threads;
+        CsrGraph graph = knnGraph(nearestNeighbors(swissRoll(n, rng), k, neighbors), threads);
+        std::cout << "Rollo suizo, " << n << " puntos, " << graph.numEdges() << " aristas\n"
+                  << "  método    landmarks  geodés.(s) Lanczos(s) triang.(s)  total(s)   MiB  pasos  error\n";
+        IsomapOptions options;
+        options.threads = threads;
+        options.seed = seed;
+        IsomapEmbedding full;
+        const bool haveFull = n <= fullMax;
+        if (haveFull) {
+            full = isomap(viewOf(graph), options);
+            report("clásico", n, full, nullptr);
+        }
+        for (size_t m : landmarks) {
+            if (m >= n) continue;
+            options.landmarks = m;
+            for (LandmarkSelection selection : {LandmarkSelection::Random, LandmarkSelection::MaxMin}) {
+                options.selection = selection;
+                IsomapEmbedding e = isomap(viewOf(graph), options);
+                report(selection == LandmarkSelection::Random ? "aleatorio" : "MaxMin", m, e, haveFull ? &full : nullptr);
+            }
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        return run(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
@@ -0,0 +1,103 @@
+// Benchmark del núcleo de distancias y de los grafos de vecindad sobre datos sintéticos
+// (nubes gaussianas alrededor de centros aleatorios, como perfiles de expresión agrupados).
+// 1) Rendimiento de cada nivel SIMD soportado sobre un bloque de distancias fijo, en GFLOP/s
+//    (3 operaciones por elemento: resta, producto y suma) y diferencia relativa con el escalar.
+// 2) kNN exacto + grafo kNN simétrico + grafo ε con todas las muestras y el mejor nivel.
+// Uso: bench-knn [--samples N] [--dims N] [--k N] [--threads N] [--tile N] [--seed N]
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Distances.h"
+#include "NeighborGraph.h"
+
+static double seconds(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+int main(int argc, char* argv[]) {
+    size_t samples = 20000, dims = 512, tile = 2048;
+    unsigned k = 10, seed = 42;
+    NeighborOptions options;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        long val = 0;
+        try {
+            val = std::stol(argv[i + 1]);
+        } catch (const std::logic_error&) {   // invalid_argument u out_of_range
+            std::cerr << "Valor no válido para " << arg << ": " << argv[i + 1] << "\n";
+            return 2;
+        }
+        if (arg == "--samples") samples = static_cast<size_t>(std::max(2L, val));
+        else if (arg == "--dims") dims = static_cast<size_t>(std::max(1L, val));
+        else if (arg == "--k") k = static_cast<unsigned>(std::max(1L, val));
+        else if (arg == "--threads") options.threads = static_cast<unsigned>(std::max(1L, val));
+        else if (arg == "--tile") tile = static_cast<size_t>(std::max(1L, val));
+        else if (arg == "--seed") seed = static_cast<unsigned>(val);
+    }
+    tile = std::min(tile, samples);
+    k = std::min<unsigned>(k, static_cast<unsigned>(samples - 1));
+
+    std::mt19937 rng(seed);
+    std::normal_distribution<float> noise(0.0f, 1.0f);
+    std::uniform_real_distribution<float> center(0.0f, 1000.0f);
+    const size_t clusters = std::max<size_t>(1, samples / 500);
+    Matrix centers(clusters, dims), points(samples, dims);
+    for (size_t c = 0; c < clusters; ++c)
+        for (size_t d = 0; d < dims; ++d) centers(c, d) = center(rng);
+    for (size_t i = 0; i < samples; ++i) {
+        size_t c = rng() % clusters;
+        for (size_t d = 0; d < dims; ++d) points(i, d) = centers(c, d) + 50.0f * noise(rng);
+    }
+    std::cout << "Datos sintéticos: " << samples << " muestras x " << dims << " dimensiones, " << clusters
+              << " grupos\n";
+
+    // 1) Núcleo aislado sobre un bloque tile x tile
+    std::cout << std::fixed << std::setprecision(2);
+    std::vector<float> reference(tile * tile), out(tile * tile);
+    const double flops = 3.0 * tile * tile * dims;
+    const SimdLevel best = detectSimdLevel();
+    for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::Avx2, SimdLevel::Avx512}) {
+        if (level > best) break;
+        std::vector<float>& dst = level == SimdLevel::Scalar ? reference : out;
+        double secs = 1e30;
+        for (int round = 0; round < 3; ++round) {
+            auto t0 = std::chrono::steady_clock::now();
+            squaredDistances(points, 0, tile, points, 0, tile, dst.data(), tile, level);
+            secs = std::min(secs, seconds(t0));
+        }
+        double maxRel = 0.0;
+        for (size_t e = 0; e < dst.size(); ++e) {
+            maxRel = std::max(maxRel, std::abs(double(dst[e]) - reference[e]) / std::max(1.0f, reference[e]));
+        }
+        std::cout << std::left << std::setw(8) << simdLevelName(level) << std::right << "  bloque " << tile << "x"
+                  << tile << ": " << std::setw(8) << secs * 1000 << " ms  " << std::setw(7) << flops / secs / 1e9
+                  << " GFLOP/s  dif. relativa máx. " << std::scientific << maxRel << std::fixed << "\n";
+    }
+
+    // 2) Grafos completos con el mejor nivel
+    options.simd = best;
+    auto t0 = std::chrono::steady_clock::now();
+    KnnTable table = nearestNeighbors(points, k, options);
+    double knnSecs = seconds(t0);
+    t0 = std::chrono::steady_clock::now();
+    CsrGraph knn = knnGraph(table, options.threads);
+    double graphSecs = seconds(t0);
+    float epsilon = kthNeighborRadius(table);
+    t0 = std::chrono::steady_clock::now();
+    CsrGraph eps = epsilonGraph(points, epsilon, options);
+    double epsSecs = seconds(t0);
+
+    const double pairs = double(samples) * samples;
+    std::cout << "kNN exacto (k=" << k << ", " << simdLevelName(best) << ", " << options.threads << " hilos): "
+              << knnSecs << " s, " << pairs / knnSecs / 1e6 << " M pares/s, " << 3.0 * pairs * dims / knnSecs / 1e9
+              << " GFLOP/s\n";
+    std::cout << "Grafo kNN simétrico: " << knn.numEdges() << " aristas en " << graphSecs * 1000 << " ms\n";
+    std::cout << "Grafo ε (ε=" << epsilon << "): " << eps.numEdges() << " aristas en " << epsSecs << " s\n";
+    return 0;
+}
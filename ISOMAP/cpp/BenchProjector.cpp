@@ -0,0 +1,121 @@
+// Benchmark del proyector de muestras nuevas: entrena ISOMAP con landmarks sobre un rollo
+// suizo sumergido en muchas dimensiones (como la expresión génica: pocas variables latentes y
+// muchas medidas), guarda el modelo, lo abre mapeado y proyecta muestras nuevas con varios
+// tamaños de lote. Informa muestras/s y la latencia por lote (lo que espera cada muestra), y
+// comprueba que proyectar los puntos de entrenamiento reproduce sus coordenadas.
+// Uso: bench-projector [--train N] [--queries N] [--dims N] [--k N] [--landmarks M]
+//                      [--batches B,B,...] [--model RUTA] [--threads N] [--seed N]
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <numbers>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "IsomapModel.h"
+
+static std::vector<size_t> parseList(const std::string& s) {
+    std::vector<size_t> out;
+    std::stringstream in(s);
+    for (std::string item; std::getline(in, item, ',');) out.push_back(std::max(1ul, std::stoul(item)));
+    return out;
+}
+
+// n puntos de un rollo suizo (3D) llevados a dims dimensiones con una matriz fija al azar
+static Matrix embeddedSwissRoll(size_t n, size_t dims, const std::vector<float>& lift, std::mt19937& rng) {
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::normal_distribution<float> noise(0.0f, 0.05f);
+    Matrix points(n, dims);
+    for (size_t i = 0; i < n; ++i) {
+        const float t = 1.5f * std::numbers::pi_v<float> * (1.0f + 2.0f * unit(rng));
+        const float x[3] = {t * std::cos(t), 21.0f * unit(rng), t * std::sin(t)};
+        for (size_t d = 0; d < dims; ++d) {
+            points(i, d) = x[0] * lift[d * 3] + x[1] * lift[d * 3 + 1] + x[2] * lift[d * 3 + 2] + noise(rng);
+        }
+    }
+    return points;
+}
+
+static int run(int argc, char* argv[]) {
+    size_t train = 8000, queries = 20000, dims = 256, landmarks = 200;
+    unsigned k = 10, seed = 42;
+    std::vector<size_t> batches = {1, 16, 256, 4096};
+    std::string modelPath = "/tmp/bench-projector.model";
+    ProjectorOptions options;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i], val = argv[i + 1];
+        if (arg == "--train") train = std::stoul(val);
+        else if (arg == "--queries") queries = std::stoul(val);
+        else if (arg == "--dims") dims = std::max(3ul, std::stoul(val));
+        else if (arg == "--k") k = static_cast<unsigned>(std::max(1ul, std::stoul(val)));
+        else if (arg == "--landmarks") landmarks = std::stoul(val);
+        else if (arg == "--batches") batches = parseList(val);
+        else if (arg == "--model") modelPath = val;
+        else if (arg == "--threads") options.threads = static_cast<unsigned>(std::max(1ul, std::stoul(val)));
+        else if (arg == "--seed") seed = static_cast<unsigned>(std::stoul(val));
+    }
+    std::cout << options.threads << " hilos, núcleo " << simdLevelName(options.simd) << "\n";
+
+    // Entrenamiento y modelo
+    std::mt19937 rng(seed);
+    std::normal_distribution<float> gauss(0.0f, 1.0f);
+    std::vector<float> lift(dims * 3);
+    for (float& v : lift) v = gauss(rng);
+    Matrix points = embeddedSwissRoll(train, dims, lift, rng);
+    NeighborOptions neighbors;
+    neighbors.threads = options.threads;
+    CsrGraph graph = knnGraph(nearestNeighbors(points, k, neighbors), options.threads);
+    IsomapOptions isomapOptions;
+    isomapOptions.landmarks = landmarks;
+    isomapOptions.threads = options.threads;
+    IsomapEmbedding embedding = isomap(viewOf(graph), isomapOptions);
+    std::vector<std::string> genes(dims);
+    for (size_t d = 0; d < dims; ++d) genes[d] = "g" + std::to_string(d);
+    if (!saveIsomapModel(modelPath, points, genes, graph, k, embedding)) {
+        std::cerr << "No se pudo escribir " << modelPath << "\n";
+        return 1;
+    }
+    auto t0 = std::chrono::steady_clock::now();
+    IsomapModel model = IsomapModel::open(modelPath);
+    const double openMs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count() * 1000;
+    std::cout << "Modelo: " << train << " muestras x " << dims << " dimensiones, " << model.numLandmarks()
+              << " landmarks, k=" << k << std::fixed << std::setprecision(1) << ", "
+              << model.fileBytes() / 1048576.0 << " MiB (abierto en " << std::setprecision(2) << openMs << " ms)\n";
+
+    // Los puntos de entrenamiento deben caer en sus propias coordenadas
+    std::vector<double> again = projectSamples(model, points, options);
+    double worst = 0, scale = 0;
+    for (size_t i = 0; i < again.size(); ++i) {
+        worst = std::max(worst, std::abs(again[i] - embedding.coordinates[i]));
+        scale = std::max(scale, std::abs(embedding.coordinates[i]));
+    }
+    std::cout << "Reproyección del entrenamiento: error máximo " << std::scientific << std::setprecision(1)
+              << worst / scale << " (relativo al mayor valor)\n" << std::fixed;
+
+    Matrix fresh = embeddedSwissRoll(queries, dims, lift, rng);
+    std::cout << "Muestras nuevas: " << queries << "\n"
+              << "     lote   muestras/s   ms/lote (media)   ms/lote (máx.)   vecinos\n";
+    for (size_t batch : batches) {
+        options.batch = batch;
+        ProjectionStats stats;
+        projectSamples(model, fresh, options, &stats);
+        std::cout << std::setw(9) << batch << std::setprecision(0) << std::setw(13) << stats.samples / stats.seconds
+                  << std::setprecision(3) << std::setw(18) << stats.seconds / stats.batches * 1000 << std::setw(17)
+                  << stats.maxBatchSeconds * 1000 << std::setprecision(0) << std::setw(9)
+                  << 100 * stats.knnSeconds / stats.seconds << " %\n";
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        return run(argc, argv);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
@@ -0,0 +1,170 @@
+#include "Distances.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define ISOMAP_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// Floats de cada fila por pasada: una tira de 4 filas de b (16 KiB) se queda en L1 mientras se
+// recorren las tiras de a del bloque
+constexpr size_t kDepth = 1024;
+
+// Micronúcleo: partial[r * NR + c] = sum_k (a[r][k] - b[c][k])² para k en [0, len)
+using MicroKernel = void (*)(const float* const* a, const float* const* b, size_t len, float* partial);
+
+template <int MR, int NR>
+void microScalar(const float* const* a, const float* const* b, size_t len, float* partial) {
+    for (int r = 0; r < MR; ++r) {
+        for (int c = 0; c < NR; ++c) {
+            float sum = 0.0f;
+            for (size_t k = 0; k < len; ++k) {
+                float d = a[r][k] - b[c][k];
+                sum += d * d;
+            }
+            partial[r * NR + c] = sum;
+        }
+    }
+}
+
+#ifdef ISOMAP_X86_SIMD
+// Suma horizontal de 8 floats
+__attribute__((target("avx"))) inline float horizontalSum(__m256 v) {
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    s = _mm_add_ss(s, _mm_movehdup_ps(s));
+    return _mm_cvtss_f32(s);
+}
+
+// Los bucles de trip fijo se desenrollan del todo para que GCC mantenga los acumuladores en
+// registros (con -O2 y sin desenrollar los deja en la pila)
+
+// AVX2 + FMA: 3 x 3 acumuladores de 8 floats (9 + 3 + 2 de los 16 registros ymm)
+__attribute__((target("avx2,fma"))) void microAvx2(const float* const* a, const float* const* b, size_t len,
+                                                   float* partial) {
+    __m256 acc[9];
+#pragma GCC unroll 9
+    for (int t = 0; t < 9; ++t) acc[t] = _mm256_setzero_ps();
+    for (size_t k = 0; k < len; k += 8) {
+        __m256 av[3];
+#pragma GCC unroll 3
+        for (int r = 0; r < 3; ++r) av[r] = _mm256_load_ps(a[r] + k);
+#pragma GCC unroll 3
+        for (int c = 0; c < 3; ++c) {
+            __m256 bv = _mm256_load_ps(b[c] + k);
+#pragma GCC unroll 3
+            for (int r = 0; r < 3; ++r) {
+                __m256 d = _mm256_sub_ps(av[r], bv);
+                acc[r * 3 + c] = _mm256_fmadd_ps(d, d, acc[r * 3 + c]);
+            }
+        }
+    }
+#pragma GCC unroll 9
+    for (int t = 0; t < 9; ++t) partial[t] = horizontalSum(acc[t]);
+}
+
+// AVX-512: 4 x 4 acumuladores de 16 floats (16 + 4 + 2 de los 32 registros zmm)
+__attribute__((target("avx512f"))) void microAvx512(const float* const* a, const float* const* b, size_t len,
+                                                    float* partial) {
+    __m512 acc[16];
+#pragma GCC unroll 16
+    for (int t = 0; t < 16; ++t) acc[t] = _mm512_setzero_ps();
+    for (size_t k = 0; k < len; k += 16) {
+        __m512 av[4];
+#pragma GCC unroll 4
+        for (int r = 0; r < 4; ++r) av[r] = _mm512_load_ps(a[r] + k);
+#pragma GCC unroll 4
+        for (int c = 0; c < 4; ++c) {
+            __m512 bv = _mm512_load_ps(b[c] + k);
+#pragma GCC unroll 4
+            for (int r = 0; r < 4; ++r) {
+                __m512 d = _mm512_sub_ps(av[r], bv);
+                acc[r * 4 + c] = _mm512_fmadd_ps(d, d, acc[r * 4 + c]);
+            }
+        }
+    }
+    // Mitad alta sobre la baja y suma de 8 (las extracciones de avx512fintrin.h avisan de
+    // variables sin inicializar con -Wall en GCC 12; pasar por memoria cuesta lo mismo aquí)
+    alignas(64) float lanes[16];
+    for (int t = 0; t < 16; ++t) {
+        _mm512_store_ps(lanes, acc[t]);
+        partial[t] = horizontalSum(_mm256_add_ps(_mm256_load_ps(lanes), _mm256_load_ps(lanes + 8)));
+    }
+}
+#endif
+
+// Recorrido por bloques común a todos los niveles. Las tiras incompletas del borde repiten la
+// última fila válida y descartan esos resultados, así el micronúcleo no tiene casos especiales.
+template <int MR, int NR>
+void blocked(MicroKernel micro, const Matrix& a, size_t i0, size_t i1, const Matrix& b, size_t j0, size_t j1,
+             float* out, size_t ldo) {
+    for (size_t i = i0; i < i1; ++i) std::fill_n(out + (i - i0) * ldo, j1 - j0, 0.0f);
+    const size_t dim = a.stride();
+    float partial[MR * NR];
+    const float* ap[MR];
+    const float* bp[NR];
+    for (size_t k0 = 0; k0 < dim; k0 += kDepth) {
+        const size_t len = std::min(kDepth, dim - k0);
+        for (size_t j = j0; j < j1; j += NR) {
+            const int nr = static_cast<int>(std::min<size_t>(NR, j1 - j));
+            for (int c = 0; c < NR; ++c) bp[c] = b.row(j + std::min(c, nr - 1)) + k0;
+            for (size_t i = i0; i < i1; i += MR) {
+                const int mr = static_cast<int>(std::min<size_t>(MR, i1 - i));
+                for (int r = 0; r < MR; ++r) ap[r] = a.row(i + std::min(r, mr - 1)) + k0;
+                micro(ap, bp, len, partial);
+                for (int r = 0; r < mr; ++r) {
+                    float* dst = out + (i + r - i0) * ldo + (j - j0);
+                    for (int c = 0; c < nr; ++c) dst[c] += partial[r * NR + c];
+                }
+            }
+        }
+    }
+}
+
+} // namespace
+
+// Nivel SIMD disponible
+SimdLevel detectSimdLevel() {
+#ifdef ISOMAP_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return SimdLevel::Avx512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return SimdLevel::Avx2;
+#endif
+    return SimdLevel::Scalar;
+}
+
+// Nombre del nivel
+const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::Avx512: return "AVX-512";
+        case SimdLevel::Avx2: return "AVX2";
+        case SimdLevel::Scalar: break;
+    }
+    return "escalar";
+}
+
+// Nivel de la opción --simd
+SimdLevel parseSimdLevel(const std::string& name) {
+    if (name == "escalar") return SimdLevel::Scalar;
+    if (name == "avx2") return SimdLevel::Avx2;
+    if (name == "avx512") return SimdLevel::Avx512;
+    throw std::invalid_argument("parseSimdLevel: " + name);
+}
+
+// Bloque de distancias al cuadrado
+void squaredDistances(const Matrix& a, size_t i0, size_t i1, const Matrix& b, size_t j0, size_t j1,
+                      float* out, size_t ldo, SimdLevel level) {
+    if (a.cols() != b.cols()) throw std::invalid_argument("squaredDistances: dimensiones distintas");
+    if (i0 >= i1 || j0 >= j1) return;
+    static const SimdLevel supported = detectSimdLevel();
+    level = std::min(level, supported);
+#ifdef ISOMAP_X86_SIMD
+    if (level == SimdLevel::Avx512) return blocked<4, 4>(microAvx512, a, i0, i1, b, j0, j1, out, ldo);
+    if (level == SimdLevel::Avx2) return blocked<3, 3>(microAvx2, a, i0, i1, b, j0, j1, out, ldo);
+#endif
+    blocked<4, 4>(microScalar<4, 4>, a, i0, i1, b, j0, j1, out, ldo);
+}
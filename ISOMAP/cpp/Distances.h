@@ -0,0 +1,27 @@
+// Distances.h
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include "Matrix.h"
+
+// Juego de instrucciones del núcleo de distancias
+enum class SimdLevel { Scalar, Avx2, Avx512 };
+
+// Mejor nivel soportado por la CPU (y el sistema operativo) en tiempo de ejecución
+SimdLevel detectSimdLevel();
+// Nombre legible ("escalar", "AVX2", "AVX-512")
+const char* simdLevelName(SimdLevel level);
+// Nivel de la opción --simd ("escalar", "avx2" o "avx512"); lanza std::invalid_argument con otro valor
+SimdLevel parseSimdLevel(const std::string& name);
+
+// Bloque de distancias euclídeas al cuadrado entre las filas [i0, i1) de a y [j0, j1) de b:
+// out[(i - i0) * ldo + (j - j0)] = ||a_i - b_j||². a y b deben tener el mismo número de
+// columnas. Se recorre como un GEMM por bloques (tiras de filas de b reutilizadas desde L1
+// contra tiras de a, en tramos de dimensiones que caben en caché), pero sumando (a - b)²
+// directamente en vez de ||a||² + ||b||² - 2ab: cuesta una resta más por elemento y evita la
+// cancelación catastrófica en float con valores de expresión de hasta decenas de miles.
+// Con a == b el resultado es exactamente simétrico. Un nivel no soportado por la CPU cae al
+// mejor disponible.
+void squaredDistances(const Matrix& a, size_t i0, size_t i1, const Matrix& b, size_t j0, size_t j1,
+                      float* out, size_t ldo, SimdLevel level);
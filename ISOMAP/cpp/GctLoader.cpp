@@ -0,0 +1,178 @@
+#include "GctLoader.h"
+
+#include <charconv>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+
+namespace {
+
+[[noreturn]] void formatError(const std::string& filename, size_t line, const std::string& what) {
+    throw std::runtime_error("loadGct: " + filename + ":" + std::to_string(line) + ": " + what);
+}
+
+// Quita espacios y fin de línea (\r\n) en los extremos, como str.strip()
+std::string_view trim(std::string_view s) {
+    const char* ws = " \t\r\n";
+    size_t begin = s.find_first_not_of(ws);
+    if (begin == std::string_view::npos) return {};
+    return s.substr(begin, s.find_last_not_of(ws) - begin + 1);
+}
+
+// Siguiente campo separado por tabuladores; avanza pos tras el separador (vacío al final)
+std::string_view nextField(std::string_view line, size_t& pos) {
+    if (pos > line.size()) return {};
+    size_t end = line.find('\t', pos);
+    if (end == std::string_view::npos) end = line.size();
+    std::string_view field = line.substr(pos, end - pos);
+    pos = end + 1;
+    return field;
+}
+
+bool parseFloat(std::string_view s, float& out) {
+    s = trim(s);
+    if (!s.empty() && s.front() == '+') s.remove_prefix(1);
+    auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), out);
+    return ec == std::errc() && ptr == s.data() + s.size() && !s.empty();
+}
+
+} // namespace
+
+// Carga un GCT traspuesto a muestras x genes
+GctData loadGct(const std::string& filename) {
+    std::ifstream in(filename, std::ios::binary);
+    if (!in) throw std::runtime_error("loadGct: no se pudo abrir " + filename);
+    std::vector<char> readBuffer(size_t(1) << 20);
+    in.rdbuf()->pubsetbuf(readBuffer.data(), static_cast<std::streamsize>(readBuffer.size()));
+
+    std::string line;
+    size_t lineNo = 0;
+    auto readLine = [&](const char* what) {
+        if (!std::getline(in, line)) formatError(filename, lineNo + 1, std::string("falta ") + what);
+        ++lineNo;
+        return trim(line);
+    };
+
+    if (readLine("la versión").substr(0, 3) != "#1.") formatError(filename, lineNo, "no es un archivo GCT");
+    std::string_view dims = readLine("la línea de dimensiones");
+    size_t geneCount = 0, sampleCount = 0;
+    {
+        // Separadas por tabulador según el formato, aunque se aceptan espacios
+        const char* end = dims.data() + dims.size();
+        auto r1 = std::from_chars(dims.data(), end, geneCount);
+        const char* next = r1.ptr;
+        while (next < end && (*next == ' ' || *next == '\t')) ++next;
+        auto r2 = std::from_chars(next, end, sampleCount);
+        if (r1.ec != std::errc() || r2.ec != std::errc() || next == r1.ptr) {
+            formatError(filename, lineNo, "dimensiones inválidas");
+        }
+    }
+
+    GctData data;
+    std::string_view header = readLine("la cabecera");
+    {
+        size_t pos = 0;
+        nextField(header, pos);
+        nextField(header, pos);
+        while (pos <= header.size()) data.samples.emplace_back(trim(nextField(header, pos)));
+    }
+    if (data.samples.size() != sampleCount) {
+        formatError(filename, lineNo, "la cabecera tiene " + std::to_string(data.samples.size()) +
+                                          " muestras y se declararon " + std::to_string(sampleCount));
+    }
+
+    data.genes.reserve(geneCount);
+    data.values = Matrix(sampleCount, geneCount);
+    std::vector<float> rowValues(sampleCount);
+    while (std::getline(in, line)) {
+        ++lineNo;
+        std::string_view row = trim(line);
+        if (row.empty()) continue;
+        if (data.genes.size() == geneCount) formatError(filename, lineNo, "más genes de los declarados");
+        size_t pos = 0;
+        data.genes.emplace_back(nextField(row, pos));
+        nextField(row, pos);
+        size_t count = 0;
+        bool numeric = true;
+        while (pos <= row.size()) {
+            std::string_view field = nextField(row, pos);
+            if (count < sampleCount) numeric = parseFloat(field, rowValues[count]) && numeric;
+            ++count;
+        }
+        if (count != sampleCount) {
+            formatError(filename, lineNo, std::to_string(count) + " valores, se esperaban " + std::to_string(sampleCount));
+        }
+        size_t g = data.genes.size() - 1;
+        for (size_t s = 0; s < sampleCount; ++s) {
+            data.values(s, g) = numeric ? rowValues[s] : std::numeric_limits<float>::quiet_NaN();
+        }
+    }
+    if (data.genes.size() != geneCount) {
+        formatError(filename, lineNo, std::to_string(data.genes.size()) + " genes, se declararon " + std::to_string(geneCount));
+    }
+    return data;
+}
+
+// Concatena muestras sobre los genes comunes sin NaN
+GctData concatSamples(const GctData& a, const GctData& b) {
+    std::unordered_map<std::string_view, size_t> inB;
+    inB.reserve(b.genes.size());
+    for (size_t g = 0; g < b.genes.size(); ++g) inB.emplace(b.genes[g], g);
+
+    auto finiteColumn = [](const Matrix& m, size_t g) {
+        for (size_t s = 0; s < m.rows(); ++s) {
+            if (std::isnan(m(s, g))) return false;
+        }
+        return true;
+    };
+    std::vector<std::pair<size_t, size_t>> keep;   // (columna en a, columna en b)
+    const bool onlyA = b.genes.empty() && b.samples.empty();
+    for (size_t g = 0; g < a.genes.size(); ++g) {
+        if (onlyA) {
+            if (finiteColumn(a.values, g)) keep.emplace_back(g, 0);
+            continue;
+        }
+        auto it = inB.find(a.genes[g]);
+        if (it != inB.end() && finiteColumn(a.values, g) && finiteColumn(b.values, it->second)) {
+            keep.emplace_back(g, it->second);
+        }
+    }
+
+    GctData out;
+    out.samples = a.samples;
+    out.samples.insert(out.samples.end(), b.samples.begin(), b.samples.end());
+    out.genes.reserve(keep.size());
+    for (const auto& [ga, _] : keep) out.genes.push_back(a.genes[ga]);
+    out.values = Matrix(out.samples.size(), keep.size());
+    for (size_t s = 0; s < a.samples.size(); ++s) {
+        for (size_t c = 0; c < keep.size(); ++c) out.values(s, c) = a.values(s, keep[c].first);
+    }
+    for (size_t s = 0; s < b.samples.size(); ++s) {
+        for (size_t c = 0; c < keep.size(); ++c) out.values(a.samples.size() + s, c) = b.values(s, keep[c].second);
+    }
+    return out;
+}
+
+// Columnas por nombre de gen
+Matrix selectGenes(const GctData& data, const std::vector<std::string>& genes) {
+    std::unordered_map<std::string_view, size_t> column;
+    column.reserve(data.genes.size());
+    for (size_t g = 0; g < data.genes.size(); ++g) column.emplace(data.genes[g], g);
+    Matrix out(data.samples.size(), genes.size());
+    for (size_t c = 0; c < genes.size(); ++c) {
+        auto it = column.find(genes[c]);
+        if (it == column.end()) throw std::runtime_error("selectGenes: falta el gen " + genes[c]);
+        for (size_t s = 0; s < data.samples.size(); ++s) out(s, c) = data.values(s, it->second);
+    }
+    return out;
+}
+
+// Etiqueta de clase de la muestra
+std::string sampleLabel(const std::string& sample) {
+    size_t all = sample.find("ALL"), aml = sample.find("AML");
+    if (all == std::string::npos && aml == std::string::npos) return "";
+    return all < aml ? "ALL" : "AML";
+}
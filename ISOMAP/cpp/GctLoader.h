@@ -0,0 +1,30 @@
+// GctLoader.h
+#pragma once
+
+#include <string>
+#include <vector>
+#include "Matrix.h"
+
+// Contenido de un archivo GCT (#1.2) ya traspuesto: una fila por muestra, una columna por gen
+struct GctData {
+    std::vector<std::string> samples;   // Nombres de muestra (cabecera, columnas 3..)
+    std::vector<std::string> genes;     // Identificadores de gen (columna Name)
+    Matrix values;                      // samples.size() x genes.size()
+};
+
+// Lee un GCT en streaming, fila de genes a fila de genes, escribiendo cada valor directamente
+// en su posición traspuesta. Una fila con algún valor no numérico queda entera a NaN (como el
+// script de Python). Lanza std::runtime_error si el archivo no existe o no respeta el formato.
+GctData loadGct(const std::string& filename);
+
+// Une las muestras de a y b (a primero) sobre los genes presentes en ambos, en el orden de a,
+// y descarta los genes con algún NaN (equivale a pd.concat + eliminar columnas con NaN).
+// Con b vacío (sin muestras ni genes) solo se descartan los genes con NaN de a.
+GctData concatSamples(const GctData& a, const GctData& b);
+
+// Columnas de data en el orden de genes (p. ej. los de un modelo ya entrenado). Lanza
+// std::runtime_error si falta alguno.
+Matrix selectGenes(const GctData& data, const std::vector<std::string>& genes);
+
+// Etiqueta ALL/AML contenida en el nombre de la muestra ("" si no tiene)
+std::string sampleLabel(const std::string& sample);
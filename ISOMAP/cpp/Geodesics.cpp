@@ -0,0 +1,309 @@
+#include "Geodesics.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr char kMatrixMagic[8] = {'I', 'S', 'O', 'M', 'P', 'G', 'E', 'O'};
+constexpr uint32_t kMatrixVersion = 1;
+constexpr size_t kHeaderBytes = 4096;
+
+// Umbrales de Beamer et al. para cambiar de dirección
+constexpr uint64_t kAlpha = 14;
+constexpr size_t kBeta = 24;
+
+constexpr float kInf = std::numeric_limits<float>::infinity();
+
+struct MatrixHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t block;
+    uint64_t n;
+};
+
+// Región mapeada que se desmapea al soltar la última referencia
+std::shared_ptr<void> mapping(void* addr, size_t size) {
+    return std::shared_ptr<void>(addr, [size](void* p) { ::munmap(p, size); });
+}
+
+size_t physicalMemory() {
+    long pages = ::sysconf(_SC_PHYS_PAGES), pageSize = ::sysconf(_SC_PAGE_SIZE);
+    return pages > 0 && pageSize > 0 ? static_cast<size_t>(pages) * static_cast<size_t>(pageSize) : size_t(1) << 32;
+}
+
+} // namespace
+
+// Espacio de trabajo dimensionado para el grafo
+ShortestPaths::ShortestPaths(const GraphView& graph, bool directionOptimizing)
+    : g(graph), bottomUp(directionOptimizing) {
+    const size_t n = g.numNodes();
+    if (g.weighted()) {
+        dist.resize(n);
+    } else {
+        frontier.reserve(n);
+        next.reserve(n);
+        if (bottomUp) {
+            inFrontier.resize((n + 63) / 64);
+            inNext.resize((n + 63) / 64);
+        }
+    }
+}
+
+// Distancias desde un origen
+void ShortestPaths::run(uint32_t source, float* out) {
+    if (g.weighted()) dijkstra(source, out);
+    else bfs(source, out);
+}
+
+// Dijkstra con borrado perezoso. Las entradas del montículo son (distancia en float, nodo)
+// empaquetadas en un uint64: con distancias no negativas los bits del float ordenan igual que
+// su valor, así que se compara un entero en vez de un par; dist sigue en double.
+void ShortestPaths::dijkstra(uint32_t source, float* out) {
+    const size_t n = g.numNodes();
+    auto key = [](double d, uint32_t v) {
+        float f = static_cast<float>(d);
+        uint32_t bits;
+        std::memcpy(&bits, &f, sizeof(bits));
+        return uint64_t(bits) << 32 | v;
+    };
+    std::fill(dist.begin(), dist.end(), std::numeric_limits<double>::infinity());
+    dist[source] = 0;
+    heap.clear();
+    heap.push_back(key(0, source));
+    const auto later = std::greater<uint64_t>();
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), later);
+        uint64_t top = heap.back();
+        heap.pop_back();
+        uint32_t u = static_cast<uint32_t>(top);
+        double d = dist[u];
+        if (top > key(d, u)) continue;   // Entrada obsoleta
+        for (uint64_t e = g.offsets[u]; e < g.offsets[u + 1]; ++e) {
+            uint32_t v = g.targets[e];
+            double nd = d + g.weights[e];
+            if (nd < dist[v]) {
+                dist[v] = nd;
+                heap.push_back(key(nd, v));
+                std::push_heap(heap.begin(), heap.end(), later);
+            }
+        }
+        examined += g.offsets[u + 1] - g.offsets[u];
+    }
+    for (size_t v = 0; v < n; ++v) out[v] = static_cast<float>(dist[v]);
+}
+
+// BFS de dirección óptima; out hace de marca de visitado (+inf = sin visitar)
+void ShortestPaths::bfs(uint32_t source, float* out) {
+    const size_t n = g.numNodes();
+    auto degree = [&](uint32_t u) { return g.offsets[u + 1] - g.offsets[u]; };
+    std::fill(out, out + n, kInf);
+    out[source] = 0;
+    frontier.assign(1, source);
+    size_t count = 1;
+    uint64_t frontierEdges = degree(source);
+    uint64_t remainingEdges = g.offsets[n] - frontierEdges;
+    bool bottom = false;
+    for (float level = 1; count > 0; ++level) {
+        if (!bottom && bottomUp && frontierEdges > remainingEdges / kAlpha) {
+            bottom = true;
+            std::fill(inFrontier.begin(), inFrontier.end(), 0);
+            for (uint32_t u : frontier) inFrontier[u >> 6] |= uint64_t(1) << (u & 63);
+        } else if (bottom && count < n / kBeta) {
+            bottom = false;
+            frontier.clear();
+            for (size_t w = 0; w < inFrontier.size(); ++w) {
+                for (uint64_t bits = inFrontier[w]; bits; bits &= bits - 1) {
+                    frontier.push_back(static_cast<uint32_t>(w * 64 + __builtin_ctzll(bits)));
+                }
+            }
+        }
+        frontierEdges = 0;
+        count = 0;
+        if (!bottom) {
+            next.clear();
+            for (uint32_t u : frontier) {
+                for (uint64_t e = g.offsets[u]; e < g.offsets[u + 1]; ++e) {
+                    uint32_t v = g.targets[e];
+                    if (out[v] == kInf) {
+                        out[v] = level;
+                        next.push_back(v);
+                        frontierEdges += degree(v);
+                    }
+                }
+                examined += degree(u);
+            }
+            frontier.swap(next);
+            count = frontier.size();
+        } else {
+            std::fill(inNext.begin(), inNext.end(), 0);
+            for (uint32_t v = 0; v < n; ++v) {
+                if (out[v] != kInf) continue;
+                for (uint64_t e = g.offsets[v]; e < g.offsets[v + 1]; ++e) {
+                    uint32_t u = g.targets[e];
+                    if (inFrontier[u >> 6] >> (u & 63) & 1) {
+                        out[v] = level;
+                        inNext[v >> 6] |= uint64_t(1) << (v & 63);
+                        ++count;
+                        frontierEdges += degree(v);
+                        examined += e - g.offsets[v] + 1;
+                        break;
+                    }
+                }
+                if (out[v] == kInf) examined += degree(v);
+            }
+            inFrontier.swap(inNext);
+        }
+        remainingEdges -= std::min(remainingEdges, frontierEdges);
+    }
+}
+
+// Matriz en memoria
+DistanceMatrix::DistanceMatrix(size_t size) : n(size), stripes((size + kBlock - 1) / kBlock) {
+    if (bytes() == 0) return;
+    void* p = std::aligned_alloc(64, bytes());
+    if (!p) throw std::bad_alloc();
+    storage = std::shared_ptr<void>(p, [](void* q) { std::free(q); });
+    base = static_cast<float*>(p);
+}
+
+// Matriz en un archivo nuevo
+DistanceMatrix DistanceMatrix::createFile(size_t size, const std::string& filename) {
+    DistanceMatrix m;
+    m.n = size;
+    m.stripes = (size + kBlock - 1) / kBlock;
+    const size_t total = kHeaderBytes + m.bytes();
+    int fd = ::open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) throw std::runtime_error("DistanceMatrix: no se pudo crear " + filename);
+    void* addr = MAP_FAILED;
+    if (::ftruncate(fd, static_cast<off_t>(total)) == 0) {
+        addr = ::mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+    if (addr == MAP_FAILED) throw std::runtime_error("DistanceMatrix: no se pudo mapear " + filename);
+    MatrixHeader header{};
+    std::memcpy(header.magic, kMatrixMagic, sizeof(kMatrixMagic));
+    header.version = kMatrixVersion;
+    header.block = kBlock;
+    header.n = size;
+    std::memcpy(addr, &header, sizeof(header));
+    m.storage = mapping(addr, total);
+    m.base = reinterpret_cast<float*>(static_cast<char*>(addr) + kHeaderBytes);
+    m.mapped = true;
+    return m;
+}
+
+// Matriz guardada, en solo lectura
+DistanceMatrix DistanceMatrix::openFile(const std::string& filename) {
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("DistanceMatrix: no se pudo abrir " + filename);
+    struct stat st {};
+    size_t total = 0;
+    void* addr = MAP_FAILED;
+    if (::fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) >= kHeaderBytes) {
+        total = static_cast<size_t>(st.st_size);
+        addr = ::mmap(nullptr, total, PROT_READ, MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+    if (addr == MAP_FAILED) throw std::runtime_error("DistanceMatrix: " + filename + " no es una matriz de distancias");
+    std::shared_ptr<void> guard = mapping(addr, total);
+    MatrixHeader header;
+    std::memcpy(&header, addr, sizeof(header));
+    DistanceMatrix m;
+    m.n = header.n;
+    m.stripes = (header.n + kBlock - 1) / kBlock;
+    if (std::memcmp(header.magic, kMatrixMagic, sizeof(kMatrixMagic)) != 0 || header.version != kMatrixVersion ||
+        header.block != kBlock || header.n > UINT32_MAX || kHeaderBytes + m.bytes() != total) {
+        throw std::runtime_error("DistanceMatrix: " + filename + " no es una matriz de distancias");
+    }
+    m.storage = std::move(guard);
+    m.base = reinterpret_cast<float*>(static_cast<char*>(addr) + kHeaderBytes);
+    m.mapped = true;
+    return m;
+}
+
+// Fila i a un vector contiguo
+void DistanceMatrix::copyRow(size_t i, float* out) const {
+    const float* src = base + (i / kBlock) * stripeFloats() + (i % kBlock) * kBlock;
+    for (size_t j0 = 0; j0 < n; j0 += kBlock, src += kBlock * kBlock) {
+        std::memcpy(out + j0, src, std::min(kBlock, n - j0) * sizeof(float));
+    }
+}
+
+// Fila i desde un vector contiguo
+void DistanceMatrix::storeRow(size_t i, const float* row) {
+    float* dst = base + (i / kBlock) * stripeFloats() + (i % kBlock) * kBlock;
+    for (size_t j0 = 0; j0 < n; j0 += kBlock, dst += kBlock * kBlock) {
+        std::memcpy(dst, row + j0, std::min(kBlock, n - j0) * sizeof(float));
+    }
+}
+
+// Suelta las páginas de una franja terminada (las franjas ocupan múltiplos de 16 KiB y los
+// datos empiezan en una página, así que las direcciones están alineadas)
+void DistanceMatrix::releaseStripe(size_t stripe) {
+    if (!mapped) return;
+    void* addr = base + stripe * stripeFloats();
+    const size_t len = stripeFloats() * sizeof(float);
+    ::msync(addr, len, MS_ASYNC);
+    ::madvise(addr, len, MADV_DONTNEED);
+}
+
+// Todas las geodésicas
+DistanceMatrix allPairsGeodesics(const GraphView& graph, const GeodesicOptions& options, GeodesicStats* stats) {
+    auto t0 = std::chrono::steady_clock::now();
+    const size_t n = graph.numNodes();
+    if (graph.weighted() && graph.weights.size() != graph.targets.size()) {
+        throw std::invalid_argument("allPairsGeodesics: pesos y destinos de distinto tamaño");
+    }
+    const size_t budget = options.memoryBudget ? options.memoryBudget : physicalMemory() / 2;
+    const size_t stripes = (n + DistanceMatrix::kBlock - 1) / DistanceMatrix::kBlock;
+    const size_t bytes = stripes * DistanceMatrix::kBlock * stripes * DistanceMatrix::kBlock * sizeof(float);
+    DistanceMatrix matrix;
+    if (!options.spillFile.empty()) {
+        matrix = DistanceMatrix::createFile(n, options.spillFile);
+    } else if (bytes > budget) {
+        throw std::runtime_error("allPairsGeodesics: la matriz ocupa " + std::to_string(bytes >> 20) +
+                                 " MiB y no cabe en memoria; indique un archivo (spillFile)");
+    } else {
+        matrix = DistanceMatrix(n);
+    }
+
+    const unsigned threads = std::max(1u, options.threads);
+    std::vector<std::unique_ptr<ShortestPaths>> searches(threads);
+    std::vector<std::vector<float>> rows(threads);
+    std::vector<uint64_t> unreachable(threads, 0);
+    uint64_t steals = parallelForStealing(stripes, threads, [&](size_t stripe, unsigned worker) {
+        if (!searches[worker]) {
+            searches[worker] = std::make_unique<ShortestPaths>(graph, options.directionOptimizing);
+            rows[worker].resize(n);
+        }
+        float* row = rows[worker].data();
+        const size_t end = std::min(n, (stripe + 1) * DistanceMatrix::kBlock);
+        for (size_t i = stripe * DistanceMatrix::kBlock; i < end; ++i) {
+            searches[worker]->run(static_cast<uint32_t>(i), row);
+            unreachable[worker] += std::count(row, row + n, kInf);
+            matrix.storeRow(i, row);
+        }
+        matrix.releaseStripe(stripe);
+    });
+
+    if (stats) {
+        *stats = GeodesicStats{};
+        for (unsigned t = 0; t < threads; ++t) {
+            if (searches[t]) stats->edgesExamined += searches[t]->edgesExamined();
+            stats->unreachablePairs += unreachable[t];
+        }
+        stats->steals = steals;
+        stats->fileBacked = matrix.fileBacked();
+        stats->seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    }
+    return matrix;
+}
@@ -0,0 +1,125 @@
+// Geodesics.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+#include "NeighborGraph.h"
+#include "Parallel.h"
+
+// Vista CSR no dirigida sobre la que trabaja el motor: la de un CsrGraph de ISOMAP (ponderado)
+// o la de una lista de aristas del grafo de colaboraciones de TMDBAPIapp (sin pesos)
+struct GraphView {
+    std::span<const uint64_t> offsets;
+    std::span<const uint32_t> targets;
+    std::span<const float> weights;     // Vacío: todas las aristas pesan 1 (BFS)
+
+    size_t numNodes() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+    bool weighted() const { return !weights.empty(); }
+};
+
+inline GraphView viewOf(const CsrGraph& graph) {
+    return {graph.offsets, graph.targets, graph.weights};
+}
+
+// Caminos mínimos desde un origen con espacio de trabajo reutilizable (un objeto por hilo).
+// Con pesos, Dijkstra con montículo binario y borrado perezoso (acumulando en double); sin
+// pesos, BFS de dirección óptima (Beamer): de arriba abajo mientras la frontera es pequeña y
+// de abajo arriba (cada nodo sin visitar busca un padre en la frontera) cuando la frontera
+// toca más aristas que las que quedan por explorar / alpha.
+class ShortestPaths {
+public:
+    explicit ShortestPaths(const GraphView& graph, bool directionOptimizing = true);
+
+    // out[v] = distancia de source a v (+inf si no se alcanza); out tiene numNodes() floats
+    void run(uint32_t source, float* out);
+
+    // Aristas examinadas desde la construcción (para medir TEPS)
+    uint64_t edgesExamined() const { return examined; }
+
+private:
+    GraphView g;
+    bool bottomUp;
+    uint64_t examined = 0;
+    std::vector<double> dist;
+    std::vector<uint64_t> heap;
+    std::vector<uint32_t> frontier, next;
+    std::vector<uint64_t> inFrontier, inNext;
+
+    void dijkstra(uint32_t source, float* out);
+    void bfs(uint32_t source, float* out);
+};
+
+// Matriz n x n de distancias en float32 por bloques de 64 x 64: las 64 filas de una franja
+// (un bloque de orígenes) ocupan una zona contigua, con cada bloque de 64 columnas seguido.
+// Vive en memoria o en un archivo mapeado ("ISOMPGEO", versión, bloque, n; datos desde el
+// byte 4096) cuando no cabe en RAM; las franjas terminadas se devuelven al núcleo para que el
+// proceso no retenga el archivo entero.
+class DistanceMatrix {
+public:
+    static constexpr size_t kBlock = 64;
+
+    DistanceMatrix() = default;
+    DistanceMatrix(DistanceMatrix&&) noexcept = default;
+    DistanceMatrix& operator=(DistanceMatrix&&) noexcept = default;
+    DistanceMatrix(const DistanceMatrix&) = delete;
+    DistanceMatrix& operator=(const DistanceMatrix&) = delete;
+    // Matriz en memoria
+    explicit DistanceMatrix(size_t n);
+    // Matriz respaldada por un archivo nuevo (lo crea o trunca); lanza std::runtime_error
+    static DistanceMatrix createFile(size_t n, const std::string& filename);
+    // Abre en solo lectura una matriz guardada; lanza std::runtime_error si no es válida
+    static DistanceMatrix openFile(const std::string& filename);
+
+    size_t size() const { return n; }
+    bool fileBacked() const { return mapped; }
+    // Bytes de los datos (con el relleno de los bloques del borde)
+    size_t bytes() const { return stripes * stripeFloats() * sizeof(float); }
+
+    float at(size_t i, size_t j) const { return base[offsetOf(i, j)]; }
+    // Copia la fila i (n floats) a out
+    void copyRow(size_t i, float* out) const;
+    // Escribe la fila i desde row (n floats)
+    void storeRow(size_t i, const float* row);
+    // Franja ya escrita: en archivo, se programa su escritura y se sueltan sus páginas
+    void releaseStripe(size_t stripe);
+    size_t numStripes() const { return stripes; }
+
+private:
+    size_t n = 0;
+    size_t stripes = 0;
+    float* base = nullptr;
+    bool mapped = false;
+    std::shared_ptr<void> storage;
+
+    size_t stripeFloats() const { return kBlock * stripes * kBlock; }
+    size_t offsetOf(size_t i, size_t j) const {
+        return (i / kBlock) * stripeFloats() + (j / kBlock) * kBlock * kBlock + (i % kBlock) * kBlock + j % kBlock;
+    }
+};
+
+// Opciones del cálculo de todos los pares
+struct GeodesicOptions {
+    unsigned threads = defaultThreadCount();
+    bool directionOptimizing = true;     // Solo sin pesos; false = BFS de arriba abajo
+    size_t memoryBudget = 0;             // 0: la mitad de la RAM física
+    std::string spillFile;               // Si no cabe en memoryBudget (o siempre, si se indica)
+};
+
+// Resumen del cálculo
+struct GeodesicStats {
+    double seconds = 0;
+    uint64_t edgesExamined = 0;
+    uint64_t unreachablePairs = 0;       // Pares (i, j), i != j, sin camino
+    uint64_t steals = 0;
+    bool fileBacked = false;
+};
+
+// Distancias geodésicas entre todos los pares: una tarea por franja de 64 orígenes, repartidas
+// con robo de trabajo (el coste de cada origen depende de su componente y su vecindario).
+// Si la matriz supera memoryBudget y no hay spillFile, lanza std::runtime_error.
+DistanceMatrix allPairsGeodesics(const GraphView& graph, const GeodesicOptions& options = {},
+                                 GeodesicStats* stats = nullptr);
@@ -0,0 +1,222 @@
+#include "Isomap.h"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include "SymmetricEigen.h"
+
+namespace {
+
+// Puntos por tarea de la triangulación
+constexpr size_t kTriangulationBlock = 256;
+
+double secondsSince(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+// m índices distintos al azar (Fisher-Yates parcial), ordenados para recorrer las filas en orden
+std::vector<uint32_t> randomLandmarks(size_t n, size_t m, unsigned seed) {
+    std::vector<uint32_t> all(n);
+    std::iota(all.begin(), all.end(), 0u);
+    std::mt19937_64 rng(seed);
+    for (size_t i = 0; i < m; ++i) {
+        std::uniform_int_distribution<size_t> pick(i, n - 1);
+        std::swap(all[i], all[pick(rng)]);
+    }
+    all.resize(m);
+    std::sort(all.begin(), all.end());
+    return all;
+}
+
+} // namespace
+
+// Triangulación de un punto
+void triangulate(std::span<const double> projection, std::span<const double> meanSquared,
+                 const float* landmarkDistances, double* out) {
+    const size_t m = meanSquared.size(), components = m ? projection.size() / m : 0;
+    for (size_t c = 0; c < components; ++c) {
+        const double* p = projection.data() + c * m;
+        double sum = 0;
+        for (size_t l = 0; l < m; ++l) {
+            const double d = landmarkDistances[l];
+            sum += p[l] * (d * d - meanSquared[l]);
+        }
+        out[c] = -0.5 * sum;
+    }
+}
+
+// ISOMAP con landmarks
+IsomapEmbedding isomap(const GraphView& graph, const IsomapOptions& options) {
+    const size_t n = graph.numNodes();
+    const size_t m = options.landmarks == 0 ? n : std::min(options.landmarks, n);
+    const size_t k = options.components;
+    if (k == 0 || k >= m) {
+        throw std::invalid_argument("isomap: hacen falta más landmarks (" + std::to_string(m) + ") que componentes (" +
+                                    std::to_string(k) + ")");
+    }
+    const unsigned threads = std::max(1u, options.threads);
+    IsomapEmbedding result;
+    result.components = k;
+
+    // 1. Geodésicas desde los landmarks
+    auto t0 = std::chrono::steady_clock::now();
+    std::vector<float>& geo = result.landmarkGeodesics;
+    geo.resize(m * n);
+    if (m == n) {
+        result.landmarks.resize(n);
+        std::iota(result.landmarks.begin(), result.landmarks.end(), 0u);
+    } else if (options.selection == LandmarkSelection::Random) {
+        result.landmarks = randomLandmarks(n, m, options.seed);
+    }
+    if (m == n || options.selection == LandmarkSelection::Random) {
+        std::vector<std::unique_ptr<ShortestPaths>> searches(threads);
+        parallelForStealing(m, threads, [&](size_t l, unsigned worker) {
+            if (!searches[worker]) searches[worker] = std::make_unique<ShortestPaths>(graph);
+            searches[worker]->run(result.landmarks[l], geo.data() + l * n);
+        });
+    } else {
+        // MaxMin: secuencial, cada elección depende de las búsquedas anteriores. El primero es
+        // al azar; los nodos de otra componente (+inf) se eligen antes que ninguno.
+        ShortestPaths search(graph);
+        std::vector<float> nearest(n, std::numeric_limits<float>::infinity());
+        uint32_t next = static_cast<uint32_t>(std::mt19937_64(options.seed)() % n);
+        for (size_t l = 0; l < m; ++l) {
+            result.landmarks.push_back(next);
+            float* row = geo.data() + l * n;
+            search.run(next, row);
+            for (size_t i = 0; i < n; ++i) nearest[i] = std::min(nearest[i], row[i]);
+            next = static_cast<uint32_t>(std::max_element(nearest.begin(), nearest.end()) - nearest.begin());
+        }
+    }
+    for (size_t l = 0; l < m; ++l) {
+        const float* row = geo.data() + l * n;
+        size_t unreachable = std::count(row, row + n, std::numeric_limits<float>::infinity());
+        if (unreachable) {
+            throw std::runtime_error("isomap: el grafo no es conexo (" + std::to_string(unreachable) +
+                                     " puntos sin camino desde el landmark " + std::to_string(result.landmarks[l]) +
+                                     "); aumente k o ε");
+        }
+    }
+    result.geodesicSeconds = secondsSince(t0);
+
+    // 2. MDS de los landmarks. D (m x m) es la submatriz de columnas de landmarks, simetrizada
+    // (Dijkstra acumula en otro orden en cada sentido). Con m = n se simetriza geo en su sitio.
+    t0 = std::chrono::steady_clock::now();
+    std::vector<float> compact;
+    if (m == n) {
+        for (size_t a = 0; a < n; ++a)
+            for (size_t b = a + 1; b < n; ++b) geo[a * n + b] = geo[b * n + a] = 0.5f * (geo[a * n + b] + geo[b * n + a]);
+    } else {
+        compact.resize(m * m);
+        for (size_t a = 0; a < m; ++a)
+            for (size_t b = 0; b < m; ++b)
+                compact[a * m + b] = 0.5f * (geo[a * n + result.landmarks[b]] + geo[b * n + result.landmarks[a]]);
+    }
+    const float* D = m == n ? geo.data() : compact.data();
+    const size_t ld = m == n ? n : m;
+
+    std::vector<double>& mean = result.meanSquared;
+    mean.assign(m, 0.0);
+    parallelFor(m, threads, [&](size_t a) {
+        double s = 0;
+        for (size_t b = 0; b < m; ++b) s += static_cast<double>(D[a * ld + b]) * D[a * ld + b];
+        mean[a] = s / static_cast<double>(m);
+    }, 16);
+
+    // B x = -1/2 J D² J x: se centra x, se multiplica por D² (al cuadrado sobre la marcha) y se
+    // centra el resultado
+    std::vector<double> centered(m);
+    auto multiply = [&](const double* x, double* y) {
+        const double xMean = std::accumulate(x, x + m, 0.0) / static_cast<double>(m);
+        for (size_t b = 0; b < m; ++b) centered[b] = x[b] - xMean;
+        parallelFor(m, threads, [&](size_t a) {
+            const float* row = D + a * ld;
+            double s = 0;
+            for (size_t b = 0; b < m; ++b) s += static_cast<double>(row[b]) * row[b] * centered[b];
+            y[a] = s;
+        }, 16);
+        const double yMean = std::accumulate(y, y + m, 0.0) / static_cast<double>(m);
+        for (size_t a = 0; a < m; ++a) y[a] = -0.5 * (y[a] - yMean);
+    };
+    EigenResult eigen = lanczosTopEigen(m, k, multiply, options.seed);
+    result.lanczosIterations = eigen.iterations;
+    result.eigenvalues = eigen.values;
+    result.projection.assign(k * m, 0.0);
+    for (size_t c = 0; c < k; ++c) {
+        if (eigen.values[c] <= 0) continue;
+        const double scale = 1.0 / std::sqrt(eigen.values[c]);
+        for (size_t l = 0; l < m; ++l) result.projection[c * m + l] = eigen.vectors[c * m + l] * scale;
+    }
+    result.eigenSeconds = secondsSince(t0);
+
+    // 3. Triangulación por bloques de puntos: se recorre cada fila de geodésicas de forma
+    // contigua y se acumula en las coordenadas del bloque
+    t0 = std::chrono::steady_clock::now();
+    result.coordinates.assign(n * k, 0.0);
+    const size_t blocks = (n + kTriangulationBlock - 1) / kTriangulationBlock;
+    parallelFor(blocks, threads, [&](size_t block) {
+        const size_t i0 = block * kTriangulationBlock, i1 = std::min(n, i0 + kTriangulationBlock);
+        double acc[8][kTriangulationBlock];
+        for (size_t c0 = 0; c0 < k; c0 += 8) {
+            const size_t cs = std::min<size_t>(8, k - c0);
+            for (size_t c = 0; c < cs; ++c) std::fill(acc[c], acc[c] + (i1 - i0), 0.0);
+            for (size_t l = 0; l < m; ++l) {
+                const float* row = geo.data() + l * n;
+                for (size_t c = 0; c < cs; ++c) {
+                    const double p = result.projection[(c0 + c) * m + l];
+                    if (p == 0) continue;
+                    for (size_t i = i0; i < i1; ++i) {
+                        const double d = row[i];
+                        acc[c][i - i0] += p * (d * d - mean[l]);
+                    }
+                }
+            }
+            for (size_t c = 0; c < cs; ++c)
+                for (size_t i = i0; i < i1; ++i) result.coordinates[i * k + c0 + c] = -0.5 * acc[c][i - i0];
+        }
+    });
+    result.triangulationSeconds = secondsSince(t0);
+
+    result.workingBytes = geo.size() * sizeof(float) + compact.size() * sizeof(float) +
+                          eigen.iterations * m * sizeof(double) + result.coordinates.size() * sizeof(double);
+    return result;
+}
+
+// Escribe la proyección en CSV
+bool writeEmbeddingCsv(const IsomapEmbedding& embedding, const std::vector<std::string>& labels,
+                       const std::string& filename) {
+    return writeEmbeddingCsv(embedding.coordinates, embedding.components, labels, filename);
+}
+
+// Escribe coordenadas en CSV
+bool writeEmbeddingCsv(std::span<const double> coordinates, size_t components, const std::vector<std::string>& labels,
+                       const std::string& filename) {
+    if (components == 0) return false;
+    std::FILE* file = std::fopen(filename.c_str(), "w");
+    if (!file) return false;
+    std::string line;
+    for (size_t c = 0; c < components; ++c) line += "dim" + std::to_string(c + 1) + ",";
+    line += "label\n";
+    bool ok = std::fputs(line.c_str(), file) >= 0;
+    char number[32];
+    for (size_t i = 0; i < coordinates.size() / components && ok; ++i) {
+        line.clear();
+        for (size_t c = 0; c < components; ++c) {
+            // Representación más corta que se relee igual, como repr() en Python
+            auto [end, ec] = std::to_chars(number, number + sizeof(number), coordinates[i * components + c]);
+            line.append(number, end);
+            line += ',';
+        }
+        if (i < labels.size()) line += labels[i];
+        line += '\n';
+        ok = std::fputs(line.c_str(), file) >= 0;
+    }
+    return std::fclose(file) == 0 && ok;
+}
@@ -0,0 +1,74 @@
+// Isomap.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+#include "Geodesics.h"
+#include "Parallel.h"
+
+// Cómo se eligen los landmarks
+enum class LandmarkSelection {
+    Random,     // m puntos al azar; sus búsquedas se reparten entre hilos
+    MaxMin      // Cada landmark es el punto más lejano (en geodésica) de los ya elegidos
+};
+
+// Opciones de isomap()
+struct IsomapOptions {
+    size_t landmarks = 0;               // 0 (o >= n): todos los puntos, ISOMAP clásico
+    LandmarkSelection selection = LandmarkSelection::MaxMin;
+    size_t components = 2;
+    unsigned seed = 42;
+    unsigned threads = defaultThreadCount();
+};
+
+// Coordenadas (components doubles) de un punto a partir de sus geodésicas a los m landmarks:
+// y = -1/2 L# (δ - μ), con projection = L# (components x m) y meanSquared = μ (m)
+void triangulate(std::span<const double> projection, std::span<const double> meanSquared,
+                 const float* landmarkDistances, double* out);
+
+// Proyección de ISOMAP y lo necesario para triangular puntos nuevos
+struct IsomapEmbedding {
+    size_t components = 0;
+    std::vector<double> coordinates;        // n x components por filas
+    std::vector<uint32_t> landmarks;        // m índices de punto
+    std::vector<float> landmarkGeodesics;   // m x n por filas: geodésica del landmark a cada punto
+    std::vector<double> eigenvalues;        // components, de mayor a menor
+    std::vector<double> projection;         // components x m: v_c / sqrt(lambda_c) (0 si lambda_c <= 0)
+    std::vector<double> meanSquared;        // m: media de las geodésicas al cuadrado entre landmarks
+
+    // Medidas del cálculo
+    size_t lanczosIterations = 0;
+    double geodesicSeconds = 0, eigenSeconds = 0, triangulationSeconds = 0;
+    size_t workingBytes = 0;                // Geodésicas + matriz de landmarks + base de Lanczos
+
+    size_t numPoints() const { return components ? coordinates.size() / components : 0; }
+    size_t numLandmarks() const { return landmarks.size(); }
+    const double* point(size_t i) const { return coordinates.data() + i * components; }
+
+    // Coordenadas de un punto a partir de sus geodésicas a los m landmarks
+    void triangulate(const float* landmarkDistances, double* out) const {
+        ::triangulate(projection, meanSquared, landmarkDistances, out);
+    }
+};
+
+// ISOMAP con landmarks (de Silva y Tenenbaum, 2003) sobre un grafo de vecindad:
+//  1. geodésicas solo desde m landmarks (matriz m x n en lugar de n x n);
+//  2. MDS clásico de los landmarks: los `components` mayores valores propios de
+//     B = -1/2 J D² J (m x m) con Lanczos, sin formar B (se aplica D² y el centrado);
+//  3. triangulación de todos los puntos en paralelo: y = -1/2 L# (δ - μ), con δ las geodésicas
+//     al cuadrado del punto a los landmarks y μ la media por landmark.
+// Con m = n es el ISOMAP clásico y los puntos quedan en sqrt(lambda) v, como en el script de
+// Python. Lanza std::runtime_error si algún punto no es alcanzable desde los landmarks (grafo
+// no conexo) y std::invalid_argument si components >= m.
+IsomapEmbedding isomap(const GraphView& graph, const IsomapOptions& options = {});
+
+// Escribe la proyección como output/isomap_knn.csv: cabecera dim1,dim2,...,label y una fila
+// por punto (labels[i] o vacío)
+bool writeEmbeddingCsv(const IsomapEmbedding& embedding, const std::vector<std::string>& labels,
+                       const std::string& filename);
+// Igual, para coordenadas sueltas (n x components por filas)
+bool writeEmbeddingCsv(std::span<const double> coordinates, size_t components, const std::vector<std::string>& labels,
+                       const std::string& filename);
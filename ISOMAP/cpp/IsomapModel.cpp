@@ -0,0 +1,255 @@
+#include "IsomapModel.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <initializer_list>
+#include <limits>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr char kModelMagic[8] = {'I', 'S', 'O', 'M', 'P', 'M', 'D', 'L'};
+constexpr uint32_t kModelVersion = 1;
+constexpr size_t kSectionAlignment = Matrix::kAlignment;
+
+// Muestras por tarea al estimar geodésicas y triangular
+constexpr size_t kProjectGrain = 16;
+
+struct ModelHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t neighbors;
+    uint64_t n, dims, landmarks, components, nnz, genesBytes;
+};
+static_assert(sizeof(ModelHeader) == kSectionAlignment, "la cabecera ocupa la primera sección");
+
+// Posición de cada sección en el archivo (la de points es la primera tras la cabecera)
+struct ModelLayout {
+    size_t points, offsets, targets, weights, landmarks, geodesics, eigenvalues, projection, meanSquared,
+        coordinates, genes, end;
+};
+
+// Calcula la disposición; devuelve false si algún tamaño desborda size_t (cabecera dañada)
+bool layoutOf(const ModelHeader& h, ModelLayout& l) {
+    constexpr size_t kMax = std::numeric_limits<size_t>::max();
+    bool ok = h.n < kMax && h.dims <= kMax - Matrix::kLaneFloats;
+    // Producto de los factores, o 0 (y ok = false) si no cabe
+    auto bytes = [&](std::initializer_list<uint64_t> factors) -> size_t {
+        size_t r = 1;
+        for (uint64_t f : factors) {
+            if (f != 0 && r > kMax / f) {
+                ok = false;
+                return 0;
+            }
+            r *= f;
+        }
+        return r;
+    };
+    size_t pos = sizeof(ModelHeader);
+    auto place = [&](size_t size) {
+        size_t start = pos;
+        if (pos > kMax - kSectionAlignment || size > kMax - kSectionAlignment - pos) ok = false;
+        else pos = (pos + size + kSectionAlignment - 1) / kSectionAlignment * kSectionAlignment;
+        return start;
+    };
+    if (!ok) return false;
+    const size_t stride = (h.dims + Matrix::kLaneFloats - 1) / Matrix::kLaneFloats * Matrix::kLaneFloats;
+    l.points = place(bytes({h.n, stride, sizeof(float)}));
+    l.offsets = place(bytes({h.n + 1, sizeof(uint64_t)}));
+    l.targets = place(bytes({h.nnz, sizeof(uint32_t)}));
+    l.weights = place(bytes({h.nnz, sizeof(float)}));
+    l.landmarks = place(bytes({h.landmarks, sizeof(uint32_t)}));
+    l.geodesics = place(bytes({h.landmarks, h.n, sizeof(float)}));
+    l.eigenvalues = place(bytes({h.components, sizeof(double)}));
+    l.projection = place(bytes({h.components, h.landmarks, sizeof(double)}));
+    l.meanSquared = place(bytes({h.landmarks, sizeof(double)}));
+    l.coordinates = place(bytes({h.n, h.components, sizeof(double)}));
+    l.genes = pos;
+    if (h.genesBytes > kMax - pos) return false;
+    l.end = pos + h.genesBytes;
+    return ok;
+}
+
+// Sección de count elementos de T en la posición offset del archivo mapeado
+template <class T>
+std::span<const T> section(const char* base, size_t offset, size_t count) {
+    return {reinterpret_cast<const T*>(base + offset), count};
+}
+
+double secondsSince(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+} // namespace
+
+// Escribe el modelo
+bool saveIsomapModel(const std::string& filename, const Matrix& points, const std::vector<std::string>& genes,
+                     const CsrGraph& graph, unsigned neighbors, const IsomapEmbedding& embedding) {
+    const size_t n = points.rows(), m = embedding.numLandmarks(), c = embedding.components;
+    if (graph.numNodes() != n || embedding.numPoints() != n || graph.weights.size() != graph.targets.size() ||
+        genes.size() != points.cols() || embedding.landmarkGeodesics.size() != m * n) {
+        return false;
+    }
+    std::string names;
+    for (const std::string& g : genes) names += g + '\n';
+
+    ModelHeader header{};
+    std::memcpy(header.magic, kModelMagic, sizeof(kModelMagic));
+    header.version = kModelVersion;
+    header.neighbors = neighbors;
+    header.n = n;
+    header.dims = points.cols();
+    header.landmarks = m;
+    header.components = c;
+    header.nnz = graph.targets.size();
+    header.genesBytes = names.size();
+    ModelLayout layout;
+    if (!layoutOf(header, layout)) return false;
+
+    std::FILE* file = std::fopen(filename.c_str(), "wb");
+    if (!file) return false;
+    size_t written = 0;
+    // Cada sección empieza en su posición: se rellena con ceros hasta ella
+    auto put = [&](size_t at, const void* data, size_t bytes) {
+        static const char zeros[kSectionAlignment] = {};
+        while (written < at) {
+            size_t pad = std::min(at - written, sizeof(zeros));
+            if (std::fwrite(zeros, 1, pad, file) != pad) return false;
+            written += pad;
+        }
+        if (bytes && std::fwrite(data, 1, bytes, file) != bytes) return false;
+        written += bytes;
+        return true;
+    };
+    bool ok = put(0, &header, sizeof(header)) &&
+              put(layout.points, points.data(), n * points.stride() * sizeof(float)) &&
+              put(layout.offsets, graph.offsets.data(), (n + 1) * sizeof(uint64_t)) &&
+              put(layout.targets, graph.targets.data(), graph.targets.size() * sizeof(uint32_t)) &&
+              put(layout.weights, graph.weights.data(), graph.weights.size() * sizeof(float)) &&
+              put(layout.landmarks, embedding.landmarks.data(), m * sizeof(uint32_t)) &&
+              put(layout.geodesics, embedding.landmarkGeodesics.data(), m * n * sizeof(float)) &&
+              put(layout.eigenvalues, embedding.eigenvalues.data(), c * sizeof(double)) &&
+              put(layout.projection, embedding.projection.data(), c * m * sizeof(double)) &&
+              put(layout.meanSquared, embedding.meanSquared.data(), m * sizeof(double)) &&
+              put(layout.coordinates, embedding.coordinates.data(), n * c * sizeof(double)) &&
+              put(layout.genes, names.data(), names.size());
+    return std::fclose(file) == 0 && ok;
+}
+
+// Mapea el modelo y apunta cada sección
+IsomapModel IsomapModel::open(const std::string& filename) {
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("IsomapModel: no se pudo abrir " + filename);
+    struct stat st {};
+    size_t total = 0;
+    void* addr = MAP_FAILED;
+    if (::fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) >= sizeof(ModelHeader)) {
+        total = static_cast<size_t>(st.st_size);
+        addr = ::mmap(nullptr, total, PROT_READ, MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+    if (addr == MAP_FAILED) throw std::runtime_error("IsomapModel: " + filename + " no es un modelo");
+    std::shared_ptr<const void> guard(addr, [total](const void* p) { ::munmap(const_cast<void*>(p), total); });
+
+    // Los tamaños de la cabecera deben cuadrar exactamente con el archivo
+    ModelHeader h;
+    ModelLayout l;
+    std::memcpy(&h, addr, sizeof(h));
+    if (std::memcmp(h.magic, kModelMagic, sizeof(kModelMagic)) != 0 || h.version != kModelVersion ||
+        h.n > UINT32_MAX || h.components == 0 || h.landmarks <= h.components || h.landmarks > h.n ||
+        h.neighbors == 0 || !layoutOf(h, l) || l.end != total) {
+        throw std::runtime_error("IsomapModel: " + filename + " no es un modelo válido");
+    }
+    const char* base = static_cast<const char*>(addr);
+    IsomapModel model;
+    model.bytes_ = total;
+    model.neighbors_ = h.neighbors;
+    model.points_ = Matrix::borrow(section<float>(base, l.points, 0).data(), h.n, h.dims, guard);
+    model.graph_ = {section<uint64_t>(base, l.offsets, h.n + 1), section<uint32_t>(base, l.targets, h.nnz),
+                    section<float>(base, l.weights, h.nnz)};
+    model.landmarks_ = section<uint32_t>(base, l.landmarks, h.landmarks);
+    model.landmarkGeodesics_ = section<float>(base, l.geodesics, h.landmarks * h.n);
+    model.eigenvalues_ = section<double>(base, l.eigenvalues, h.components);
+    model.projection_ = section<double>(base, l.projection, h.components * h.landmarks);
+    model.meanSquared_ = section<double>(base, l.meanSquared, h.landmarks);
+    model.coordinates_ = section<double>(base, l.coordinates, h.n * h.components);
+    const char* names = base + l.genes;
+    for (size_t i = 0, start = 0; i < h.genesBytes; ++i) {
+        if (names[i] == '\n') {
+            model.genes_.emplace_back(names + start, i - start);
+            start = i + 1;
+        }
+    }
+    // Índices que se usan sin comprobar al proyectar: offsets crecientes de 0 a nnz, y vecinos
+    // y landmarks dentro de [0, n)
+    std::span<const uint64_t> offsets = model.graph_.offsets;
+    bool valid = model.genes_.size() == h.dims && offsets.front() == 0 && offsets.back() == h.nnz &&
+                 std::is_sorted(offsets.begin(), offsets.end());
+    valid = valid && std::all_of(model.graph_.targets.begin(), model.graph_.targets.end(), [&](uint32_t t) { return t < h.n; });
+    valid = valid && std::all_of(model.landmarks_.begin(), model.landmarks_.end(), [&](uint32_t j) { return j < h.n; });
+    if (!valid) throw std::runtime_error("IsomapModel: " + filename + " no es un modelo válido");
+    model.mapping_ = std::move(guard);
+    return model;
+}
+
+// Proyección por lotes
+std::vector<double> projectSamples(const IsomapModel& model, const Matrix& queries, const ProjectorOptions& options,
+                                   ProjectionStats* stats) {
+    if (queries.cols() != model.dims()) {
+        throw std::invalid_argument("projectSamples: las muestras tienen " + std::to_string(queries.cols()) +
+                                    " genes y el modelo " + std::to_string(model.dims()));
+    }
+    auto t0 = std::chrono::steady_clock::now();
+    const size_t q = queries.rows(), m = model.numLandmarks(), c = model.components();
+    const unsigned k = static_cast<unsigned>(std::min<size_t>(model.neighbors(), model.numPoints()));
+    const size_t batch = std::max<size_t>(1, options.batch);
+    NeighborOptions neighbors;
+    neighbors.threads = options.threads;
+    neighbors.simd = options.simd;
+    std::vector<double> out(q * c);
+    ProjectionStats local;
+
+    for (size_t b0 = 0; b0 < q; b0 += batch) {
+        auto tb = std::chrono::steady_clock::now();
+        const size_t b1 = std::min(q, b0 + batch);
+        KnnTable table = nearestNeighbors(Matrix::borrow(queries.row(b0), b1 - b0, queries.cols()), model.points(), k,
+                                          neighbors);
+        local.knnSeconds += secondsSince(tb);
+
+        const size_t tasks = (b1 - b0 + kProjectGrain - 1) / kProjectGrain;
+        parallelFor(tasks, options.threads, [&](size_t task) {
+            std::vector<float> geodesic(m);
+            const size_t i0 = b0 + task * kProjectGrain, i1 = std::min(b1, i0 + kProjectGrain);
+            for (size_t i = i0; i < i1; ++i) {
+                double* y = out.data() + i * c;
+                const float* row = queries.row(i);
+                if (std::any_of(row, row + queries.cols(), [](float v) { return std::isnan(v); })) {
+                    std::fill(y, y + c, std::numeric_limits<double>::quiet_NaN());
+                    continue;
+                }
+                // Geodésica a cada landmark pasando por el mejor vecino
+                const uint32_t* nbr = table.neighbors(i - b0);
+                const float* dist = table.neighborDistances(i - b0);
+                for (size_t l = 0; l < m; ++l) {
+                    float best = std::numeric_limits<float>::infinity();
+                    for (unsigned r = 0; r < k; ++r) best = std::min(best, dist[r] + model.landmarkGeodesic(l, nbr[r]));
+                    geodesic[l] = best;
+                }
+                triangulate(model.projection(), model.meanSquared(), geodesic.data(), y);
+            }
+        });
+        local.maxBatchSeconds = std::max(local.maxBatchSeconds, secondsSince(tb));
+        ++local.batches;
+    }
+    local.samples = q;
+    local.seconds = secondsSince(t0);
+    if (stats) *stats = local;
+    return out;
+}
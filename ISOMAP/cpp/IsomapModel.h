@@ -0,0 +1,86 @@
+// IsomapModel.h
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+#include "Distances.h"
+#include "Geodesics.h"
+#include "Isomap.h"
+#include "Matrix.h"
+#include "NeighborGraph.h"
+#include "Parallel.h"
+
+// Guarda el modelo de una proyección para proyectar muestras nuevas sin recalcularla:
+// "ISOMPMDL", versión, y cada sección alineada a 64 bytes: puntos de entrenamiento (con el
+// formato de Matrix, para usarlos mapeados sin copiarlos), grafo de vecindad (CSR con pesos),
+// landmarks, geodésicas de los landmarks (m x n), valores propios, L#, μ, coordenadas de
+// entrenamiento y nombres de gen. neighbors es el k con que se proyectarán las muestras.
+bool saveIsomapModel(const std::string& filename, const Matrix& points, const std::vector<std::string>& genes,
+                     const CsrGraph& graph, unsigned neighbors, const IsomapEmbedding& embedding);
+
+// Modelo guardado por saveIsomapModel, mapeado en solo lectura: las secciones se usan en su
+// sitio y el sistema carga las páginas a medida que se tocan
+class IsomapModel {
+public:
+    // Lanza std::runtime_error si el archivo no existe o no es un modelo válido
+    static IsomapModel open(const std::string& filename);
+
+    size_t numPoints() const { return points_.rows(); }
+    size_t dims() const { return points_.cols(); }
+    unsigned neighbors() const { return neighbors_; }
+    size_t numLandmarks() const { return landmarks_.size(); }
+    size_t components() const { return eigenvalues_.size(); }
+
+    const Matrix& points() const { return points_; }
+    GraphView graph() const { return graph_; }
+    const std::vector<std::string>& genes() const { return genes_; }
+    std::span<const uint32_t> landmarks() const { return landmarks_; }
+    // Geodésica del landmark l al punto j
+    float landmarkGeodesic(size_t l, size_t j) const { return landmarkGeodesics_[l * numPoints() + j]; }
+    std::span<const double> eigenvalues() const { return eigenvalues_; }
+    std::span<const double> projection() const { return projection_; }
+    std::span<const double> meanSquared() const { return meanSquared_; }
+    std::span<const double> coordinates() const { return coordinates_; }
+    size_t fileBytes() const { return bytes_; }
+
+private:
+    std::shared_ptr<const void> mapping_;
+    size_t bytes_ = 0;
+    unsigned neighbors_ = 0;
+    Matrix points_;
+    GraphView graph_;
+    std::span<const uint32_t> landmarks_;
+    std::span<const float> landmarkGeodesics_;
+    std::span<const double> eigenvalues_, projection_, meanSquared_, coordinates_;
+    std::vector<std::string> genes_;
+};
+
+// Opciones de projectSamples
+struct ProjectorOptions {
+    unsigned threads = defaultThreadCount();
+    SimdLevel simd = detectSimdLevel();
+    size_t batch = 256;                 // Muestras por lote
+};
+
+// Medidas de projectSamples
+struct ProjectionStats {
+    size_t samples = 0;
+    size_t batches = 0;
+    double seconds = 0;
+    double knnSeconds = 0;              // Búsqueda de vecinos (el resto: geodésicas y proyección)
+    double maxBatchSeconds = 0;         // Latencia del lote más lento
+};
+
+// Proyecta las filas de queries (columnas en el orden de model.genes()) por lotes:
+//  1. sus k vecinos entre los puntos de entrenamiento (el núcleo SIMD de NeighborGraph);
+//  2. geodésica estimada a cada landmark a través de ellos: min_j d(x, j) + g(l, j);
+//  3. triangulación con L# y μ del modelo.
+// Los pasos 2 y 3 se reparten entre hilos por muestra. Devuelve queries.rows() x components
+// coordenadas; las muestras con algún NaN quedan a NaN. Un punto de entrenamiento se proyecta
+// exactamente en sus coordenadas (su vecino más cercano es él mismo, a distancia 0).
+std::vector<double> projectSamples(const IsomapModel& model, const Matrix& queries,
+                                   const ProjectorOptions& options = {}, ProjectionStats* stats = nullptr);
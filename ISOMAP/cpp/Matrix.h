@@ -0,0 +1,71 @@
+// Matrix.h
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+
+// Matriz densa de float por filas (una muestra por fila). Cada fila empieza alineada a 64
+// bytes (una línea de caché) y se rellena con ceros hasta un múltiplo de 16 floats, de modo que
+// los núcleos SIMD recorren filas completas sin tratar restos y sin cargas desalineadas.
+class Matrix {
+public:
+    static constexpr size_t kAlignment = 64;
+    static constexpr size_t kLaneFloats = kAlignment / sizeof(float);
+
+    Matrix() = default;
+    // Matriz de rows x cols inicializada a cero
+    Matrix(size_t rows, size_t cols)
+        : nRows(rows), nCols(cols), ld((cols + kLaneFloats - 1) / kLaneFloats * kLaneFloats) {
+        size_t bytes = nRows * ld * sizeof(float);
+        if (bytes == 0) return;
+        void* p = std::aligned_alloc(kAlignment, bytes);
+        if (!p) throw std::bad_alloc();
+        std::memset(p, 0, bytes);
+        buffer.reset(static_cast<float*>(p), std::free);
+    }
+
+    // Matriz sobre memoria ajena con el mismo formato (filas alineadas a 64 bytes y stride
+    // múltiplo de 16), p. ej. un modelo mapeado o un tramo de filas de otra matriz; owner la
+    // mantiene viva (vacío: la vida de data la garantiza quien llama). Es de solo lectura.
+    static Matrix borrow(const float* data, size_t rows, size_t cols, std::shared_ptr<const void> owner = nullptr) {
+        Matrix m;
+        m.nRows = rows;
+        m.nCols = cols;
+        m.ld = (cols + kLaneFloats - 1) / kLaneFloats * kLaneFloats;
+        m.buffer = std::shared_ptr<float>(std::const_pointer_cast<void>(owner), const_cast<float*>(data));
+        return m;
+    }
+
+    Matrix(Matrix&&) noexcept = default;
+    Matrix& operator=(Matrix&&) noexcept = default;
+    Matrix(const Matrix&) = delete;
+    Matrix& operator=(const Matrix&) = delete;
+
+    // Copia explícita (las matrices de expresión pueden ocupar cientos de MiB)
+    Matrix clone() const {
+        Matrix copy(nRows, nCols);
+        if (buffer) std::memcpy(copy.buffer.get(), buffer.get(), nRows * ld * sizeof(float));
+        return copy;
+    }
+
+    size_t rows() const { return nRows; }
+    size_t cols() const { return nCols; }
+    // Floats entre el inicio de dos filas consecutivas (múltiplo de 16)
+    size_t stride() const { return ld; }
+
+    float* row(size_t i) { return buffer.get() + i * ld; }
+    const float* row(size_t i) const { return buffer.get() + i * ld; }
+    float& operator()(size_t i, size_t j) { return buffer.get()[i * ld + j]; }
+    float operator()(size_t i, size_t j) const { return buffer.get()[i * ld + j]; }
+    float* data() { return buffer.get(); }
+    const float* data() const { return buffer.get(); }
+
+private:
+    size_t nRows = 0;
+    size_t nCols = 0;
+    size_t ld = 0;
+    std::shared_ptr<float> buffer;
+};
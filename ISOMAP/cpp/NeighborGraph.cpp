@@ -0,0 +1,270 @@
+#include "NeighborGraph.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+constexpr char kCsrMagic[8] = {'I', 'S', 'O', 'M', 'P', 'C', 'S', 'R'};
+constexpr uint32_t kCsrVersion = 1;
+constexpr uint32_t kCsrWeighted = 1;
+constexpr char kEdgeListMagic[8] = {'T', 'M', 'D', 'B', 'E', 'D', 'G', 'E'};
+constexpr uint32_t kEdgeListVersion = 1;
+
+// Bloques de la búsqueda: 32 consultas (cabe su tramo de dimensiones en L2) contra 256 puntos
+constexpr size_t kRowBlock = 32;
+constexpr size_t kColBlock = 256;
+
+// Recorre todas las distancias al cuadrado consulta-punto por bloques y en paralelo:
+// visit(i, j, d2) para cada par, con todas las j de una misma i visitadas por un solo hilo y
+// en orden creciente
+template <class Visit>
+void sweep(const Matrix& queries, const Matrix& points, const NeighborOptions& options, Visit&& visit) {
+    const size_t q = queries.rows(), n = points.rows();
+    const size_t blocks = (q + kRowBlock - 1) / kRowBlock;
+    parallelFor(blocks, options.threads, [&](size_t block) {
+        std::vector<float> tile(kRowBlock * kColBlock);
+        const size_t i0 = block * kRowBlock, i1 = std::min(q, i0 + kRowBlock);
+        for (size_t j0 = 0; j0 < n; j0 += kColBlock) {
+            const size_t j1 = std::min(n, j0 + kColBlock);
+            squaredDistances(queries, i0, i1, points, j0, j1, tile.data(), kColBlock, options.simd);
+            for (size_t i = i0; i < i1; ++i) {
+                const float* row = tile.data() + (i - i0) * kColBlock;
+                for (size_t j = j0; j < j1; ++j) visit(i, j, row[j - j0]);
+            }
+        }
+    });
+}
+
+KnnTable searchKnn(const Matrix& queries, const Matrix& points, unsigned k, bool excludeSelf,
+                   const NeighborOptions& options) {
+    const size_t available = points.rows() - (excludeSelf ? 1 : 0);
+    if (k == 0 || points.rows() == 0 || k > available) {
+        throw std::invalid_argument("nearestNeighbors: k=" + std::to_string(k) + " con " +
+                                    std::to_string(points.rows()) + " puntos");
+    }
+    using Candidate = std::pair<float, uint32_t>;   // (distancia², índice): orden con desempate
+    const size_t q = queries.rows();
+    std::vector<Candidate> heaps(q * k);
+    std::vector<unsigned> sizes(q, 0);
+    sweep(queries, points, options, [&](size_t i, size_t j, float d2) {
+        if (excludeSelf && i == j) return;
+        Candidate* heap = heaps.data() + i * k;
+        unsigned& size = sizes[i];
+        Candidate cand{d2, static_cast<uint32_t>(j)};
+        if (size < k) {
+            heap[size++] = cand;
+            std::push_heap(heap, heap + size);
+        } else if (cand < heap[0]) {
+            std::pop_heap(heap, heap + k);
+            heap[k - 1] = cand;
+            std::push_heap(heap, heap + k);
+        }
+    });
+
+    KnnTable table;
+    table.queries = q;
+    table.k = k;
+    table.indices.resize(q * k);
+    table.distances.resize(q * k);
+    for (size_t i = 0; i < q; ++i) {
+        Candidate* heap = heaps.data() + i * k;
+        std::sort_heap(heap, heap + k);
+        for (unsigned r = 0; r < k; ++r) {
+            table.indices[i * k + r] = heap[r].second;
+            table.distances[i * k + r] = std::sqrt(heap[r].first);
+        }
+    }
+    return table;
+}
+
+} // namespace
+
+// kNN dentro del propio conjunto
+KnnTable nearestNeighbors(const Matrix& points, unsigned k, const NeighborOptions& options) {
+    return searchKnn(points, points, k, true, options);
+}
+
+// kNN de consultas externas
+KnnTable nearestNeighbors(const Matrix& queries, const Matrix& points, unsigned k, const NeighborOptions& options) {
+    return searchKnn(queries, points, k, false, options);
+}
+
+// Grafo kNN simetrizado
+CsrGraph knnGraph(const KnnTable& table, unsigned threads) {
+    const size_t n = table.queries;
+    std::vector<uint64_t> start(n + 1, 0);
+    for (size_t u = 0; u < n; ++u) {
+        for (unsigned r = 0; r < table.k; ++r) {
+            uint32_t v = table.neighbors(u)[r];
+            if (v >= n) throw std::invalid_argument("knnGraph: la tabla no es de un conjunto consigo mismo");
+            ++start[u + 1];
+            ++start[v + 1];
+        }
+    }
+    for (size_t u = 0; u < n; ++u) start[u + 1] += start[u];
+
+    // Cada relación en ambos sentidos; después se ordena cada fila y se quitan repetidos
+    std::vector<std::pair<uint32_t, float>> slots(start[n]);
+    std::vector<uint64_t> fill(start.begin(), start.end() - 1);
+    for (size_t u = 0; u < n; ++u) {
+        for (unsigned r = 0; r < table.k; ++r) {
+            uint32_t v = table.neighbors(u)[r];
+            float w = table.neighborDistances(u)[r];
+            slots[fill[u]++] = {v, w};
+            slots[fill[v]++] = {static_cast<uint32_t>(u), w};
+        }
+    }
+    std::vector<uint64_t> kept(n);
+    parallelFor(n, threads, [&](size_t u) {
+        auto first = slots.begin() + start[u], last = slots.begin() + start[u + 1];
+        std::sort(first, last);
+        kept[u] = std::unique(first, last, [](const auto& a, const auto& b) { return a.first == b.first; }) - first;
+    }, 256);
+
+    CsrGraph graph;
+    graph.offsets.assign(n + 1, 0);
+    for (size_t u = 0; u < n; ++u) graph.offsets[u + 1] = graph.offsets[u] + kept[u];
+    graph.targets.resize(graph.offsets[n]);
+    graph.weights.resize(graph.offsets[n]);
+    for (size_t u = 0; u < n; ++u) {
+        for (uint64_t e = 0; e < kept[u]; ++e) {
+            graph.targets[graph.offsets[u] + e] = slots[start[u] + e].first;
+            graph.weights[graph.offsets[u] + e] = slots[start[u] + e].second;
+        }
+    }
+    return graph;
+}
+
+// Grafo de ε-vecindad; ya sale simétrico porque el núcleo calcula d(u, v) == d(v, u) exactas
+CsrGraph epsilonGraph(const Matrix& points, float epsilon, const NeighborOptions& options) {
+    const size_t n = points.rows();
+    std::vector<std::vector<std::pair<uint32_t, float>>> rows(n);
+    sweep(points, points, options, [&](size_t i, size_t j, float d2) {
+        if (i == j) return;
+        float d = std::sqrt(d2);
+        if (d <= epsilon) rows[i].emplace_back(static_cast<uint32_t>(j), d);
+    });
+
+    CsrGraph graph;
+    graph.offsets.assign(n + 1, 0);
+    for (size_t u = 0; u < n; ++u) graph.offsets[u + 1] = graph.offsets[u] + rows[u].size();
+    graph.targets.resize(graph.offsets[n]);
+    graph.weights.resize(graph.offsets[n]);
+    for (size_t u = 0; u < n; ++u) {
+        uint64_t e = graph.offsets[u];
+        for (const auto& [v, d] : rows[u]) {
+            graph.targets[e] = v;
+            graph.weights[e++] = d;
+        }
+        std::vector<std::pair<uint32_t, float>>().swap(rows[u]);
+    }
+    return graph;
+}
+
+// Radio del k-ésimo vecino
+float kthNeighborRadius(const KnnTable& table) {
+    float radius = 0.0f;
+    for (size_t q = 0; q < table.queries; ++q) radius = std::max(radius, table.neighborDistances(q)[table.k - 1]);
+    return radius;
+}
+
+// Escribe el CSR binario
+bool writeCsr(const CsrGraph& graph, const std::string& filename) {
+    std::FILE* file = std::fopen(filename.c_str(), "wb");
+    if (!file) return false;
+    const uint64_t n = graph.numNodes(), nnz = graph.targets.size();
+    const uint32_t version = kCsrVersion, flags = graph.weights.empty() ? 0 : kCsrWeighted;
+    if (flags && graph.weights.size() != nnz) {
+        std::fclose(file);
+        return false;
+    }
+    auto put = [&](const void* data, size_t size, size_t count) {
+        return count == 0 || std::fwrite(data, size, count, file) == count;
+    };
+    bool ok = put(kCsrMagic, 1, sizeof(kCsrMagic)) && put(&version, sizeof(version), 1) &&
+              put(&flags, sizeof(flags), 1) && put(&n, sizeof(n), 1) && put(&nnz, sizeof(nnz), 1) &&
+              put(graph.offsets.data(), sizeof(uint64_t), n + 1) && put(graph.targets.data(), sizeof(uint32_t), nnz) &&
+              put(graph.weights.data(), sizeof(float), flags ? nnz : 0);
+    return std::fclose(file) == 0 && ok;
+}
+
+// Lee el CSR binario
+bool readCsr(const std::string& filename, CsrGraph& out) {
+    std::FILE* file = std::fopen(filename.c_str(), "rb");
+    if (!file) return false;
+    char magic[8];
+    uint32_t version = 0, flags = 0;
+    uint64_t n = 0, nnz = 0;
+    bool ok = std::fread(magic, 1, sizeof(magic), file) == sizeof(magic) &&
+              std::memcmp(magic, kCsrMagic, sizeof(magic)) == 0 &&
+              std::fread(&version, sizeof(version), 1, file) == 1 && version == kCsrVersion &&
+              std::fread(&flags, sizeof(flags), 1, file) == 1 &&
+              std::fread(&n, sizeof(n), 1, file) == 1 && std::fread(&nnz, sizeof(nnz), 1, file) == 1 &&
+              n < UINT32_MAX;
+    auto readArray = [&](auto& vec, uint64_t count) {
+        vec.resize(count);
+        ok = ok && (count == 0 || std::fread(vec.data(), sizeof(vec[0]), count, file) == count);
+    };
+    if (ok) {
+        readArray(out.offsets, n + 1);
+        readArray(out.targets, nnz);
+        readArray(out.weights, flags & kCsrWeighted ? nnz : 0);
+    }
+    std::fclose(file);
+    if (ok) ok = out.offsets[0] == 0 && out.offsets[n] == nnz;
+    for (uint64_t u = 0; u < n && ok; ++u) ok = out.offsets[u] <= out.offsets[u + 1];
+    for (uint64_t e = 0; e < nnz && ok; ++e) ok = out.targets[e] < n;
+    return ok;
+}
+
+// Lee la lista de aristas de TMDBAPIapp (ids, origen, destino, peso, año) sin pesos
+bool readCollaborationEdges(const std::string& filename, CsrGraph& out) {
+    std::FILE* file = std::fopen(filename.c_str(), "rb");
+    if (!file) return false;
+    char magic[8];
+    uint32_t version = 0, reserved = 0;
+    uint64_t n = 0, m = 0;
+    bool ok = std::fread(magic, 1, sizeof(magic), file) == sizeof(magic) &&
+              std::memcmp(magic, kEdgeListMagic, sizeof(magic)) == 0 &&
+              std::fread(&version, sizeof(version), 1, file) == 1 && version == kEdgeListVersion &&
+              std::fread(&reserved, sizeof(reserved), 1, file) == 1 &&
+              std::fread(&n, sizeof(n), 1, file) == 1 && std::fread(&m, sizeof(m), 1, file) == 1 &&
+              n < UINT32_MAX && m <= UINT32_MAX;
+    std::vector<uint32_t> source, target;
+    auto readArray = [&](std::vector<uint32_t>& vec, uint64_t count) {
+        vec.resize(count);
+        ok = ok && (count == 0 || std::fread(vec.data(), sizeof(uint32_t), count, file) == count);
+    };
+    // Los ids de TMDB no hacen falta: los nodos son los índices densos de la lista
+    ok = ok && std::fseek(file, static_cast<long>(n * sizeof(int32_t)), SEEK_CUR) == 0;
+    if (ok) {
+        readArray(source, m);
+        readArray(target, m);
+    }
+    std::fclose(file);
+    for (uint64_t e = 0; e < m && ok; ++e) ok = source[e] < n && target[e] < n;
+    if (!ok) return false;
+
+    out.offsets.assign(n + 1, 0);
+    for (uint64_t e = 0; e < m; ++e) {
+        ++out.offsets[source[e] + 1];
+        ++out.offsets[target[e] + 1];
+    }
+    for (uint64_t u = 0; u < n; ++u) out.offsets[u + 1] += out.offsets[u];
+    out.targets.resize(out.offsets[n]);
+    out.weights.clear();
+    std::vector<uint64_t> fill(out.offsets.begin(), out.offsets.end() - 1);
+    for (uint64_t e = 0; e < m; ++e) {
+        out.targets[fill[source[e]]++] = target[e];
+        out.targets[fill[target[e]]++] = source[e];
+    }
+    for (uint64_t u = 0; u < n; ++u) {
+        std::sort(out.targets.begin() + out.offsets[u], out.targets.begin() + out.offsets[u + 1]);
+    }
+    return true;
+}
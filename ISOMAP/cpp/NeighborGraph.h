@@ -0,0 +1,64 @@
+// NeighborGraph.h
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Distances.h"
+#include "Matrix.h"
+#include "Parallel.h"
+
+// Opciones comunes de las búsquedas de vecinos
+struct NeighborOptions {
+    unsigned threads = defaultThreadCount();
+    SimdLevel simd = detectSimdLevel();
+};
+
+// k vecinos exactos de cada consulta, ordenados por distancia (empates por índice)
+struct KnnTable {
+    size_t queries = 0;
+    unsigned k = 0;
+    std::vector<uint32_t> indices;      // queries x k
+    std::vector<float> distances;       // queries x k (euclídeas, no al cuadrado)
+
+    const uint32_t* neighbors(size_t q) const { return indices.data() + q * k; }
+    const float* neighborDistances(size_t q) const { return distances.data() + q * k; }
+};
+
+// Grafo no dirigido en formato CSR: los vecinos de u son targets[offsets[u] .. offsets[u + 1]),
+// ordenados por índice, con cada arista en ambos sentidos
+struct CsrGraph {
+    std::vector<uint64_t> offsets{0};
+    std::vector<uint32_t> targets;
+    std::vector<float> weights;         // Vacío en grafos sin pesos
+
+    size_t numNodes() const { return offsets.size() - 1; }
+    // Aristas no dirigidas (cada una aparece dos veces en targets)
+    size_t numEdges() const { return targets.size() / 2; }
+};
+
+// k vecinos más cercanos de cada fila de points entre las demás filas (sin contarse a sí misma).
+// Las filas se reparten por bloques entre hilos; cada bloque recorre points por bloques de
+// distancias y mantiene un montículo de tamaño k por fila. Lanza std::invalid_argument si
+// k es 0 o no hay k filas más.
+KnnTable nearestNeighbors(const Matrix& points, unsigned k, const NeighborOptions& options = {});
+// k vecinos más cercanos de cada fila de queries entre las filas de points
+KnnTable nearestNeighbors(const Matrix& queries, const Matrix& points, unsigned k,
+                          const NeighborOptions& options = {});
+
+// Grafo kNN simétrico: u-v si v está entre los k vecinos de u o u entre los de v, con peso la
+// distancia euclídea (una sola vez aunque la relación sea mutua)
+CsrGraph knnGraph(const KnnTable& table, unsigned threads = defaultThreadCount());
+// Grafo de ε-vecindad: u-v si ||u - v|| <= epsilon (u != v)
+CsrGraph epsilonGraph(const Matrix& points, float epsilon, const NeighborOptions& options = {});
+// Mayor distancia al k-ésimo vecino: el ε más pequeño con el que toda fila tiene k vecinos
+float kthNeighborRadius(const KnnTable& table);
+
+// Guarda / lee el grafo en binario: "ISOMPCSR", versión (u32), flags (u32, 1 = con pesos),
+// nodos (u64), entradas (u64), offsets (u64[nodos + 1]), targets (u32[entradas]) y, si tiene
+// pesos, weights (f32[entradas])
+bool writeCsr(const CsrGraph& graph, const std::string& filename);
+bool readCsr(const std::string& filename, CsrGraph& out);
+// Lee la lista de aristas binaria de TMDBAPIapp ("TMDBEDGE", el colaboraciones.edges de grafo-cpp) como
+// grafo sin pesos: los grados de separación entre actores son geodésicas con peso 1
+bool readCollaborationEdges(const std::string& filename, CsrGraph& out);
@@ -0,0 +1,152 @@
+// Parallel.h
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Número de hilos por defecto (al menos 1)
+inline unsigned defaultThreadCount() {
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// Primera excepción lanzada en los hilos de trabajo; se relanza tras el join (una excepción
+// que sale de un std::thread llamaría a std::terminate)
+class WorkerError {
+public:
+    void capture() {
+        std::lock_guard<std::mutex> guard(lock_);
+        if (!error_) error_ = std::current_exception();
+        failed_ = true;
+    }
+    bool failed() const { return failed_.load(std::memory_order_relaxed); }
+    void rethrow() const {
+        if (error_) std::rethrow_exception(error_);
+    }
+
+private:
+    std::mutex lock_;
+    std::exception_ptr error_;
+    std::atomic<bool> failed_{false};
+};
+
+// Ejecuta fn(i) para cada i en [0, n) repartiendo bloques de `grain` índices
+// dinámicamente entre `threads` hilos (el hilo llamador también trabaja). Si fn lanza, los
+// demás hilos dejan de tomar bloques y la primera excepción se relanza aquí.
+template <class F>
+void parallelFor(size_t n, unsigned threads, F&& fn, size_t grain = 1) {
+    if (n == 0) return;
+    grain = std::max<size_t>(1, grain);
+    threads = std::max(1u, std::min<unsigned>(threads, static_cast<unsigned>((n + grain - 1) / grain)));
+    if (threads == 1) {
+        for (size_t i = 0; i < n; ++i) fn(i);
+        return;
+    }
+    std::atomic<size_t> next{0};
+    WorkerError error;
+    auto worker = [&]() {
+        try {
+            for (size_t begin; (begin = next.fetch_add(grain)) < n;) {
+                size_t end = std::min(n, begin + grain);
+                for (size_t i = begin; i < end; ++i) fn(i);
+            }
+        } catch (...) {
+            error.capture();
+            next = n;   // Los demás hilos terminan su bloque y salen
+        }
+    };
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker);
+    worker();
+    for (std::thread& t : pool) t.join();
+    error.rethrow();
+}
+
+// Como parallelFor, pero con robo de trabajo para tareas de coste muy desigual: cada hilo
+// empieza con un tramo contiguo de [0, n), consume bloques de `grain` desde su inicio y, al
+// agotarlo, roba la mitad final del tramo más largo que quede a otro hilo. fn(i, worker)
+// recibe el número de hilo (0..threads-1) para usar espacios de trabajo propios.
+// Devuelve el número de robos; las excepciones de fn se tratan como en parallelFor.
+template <class F>
+uint64_t parallelForStealing(size_t n, unsigned threads, F&& fn, size_t grain = 1) {
+    if (n == 0) return 0;
+    grain = std::max<size_t>(1, grain);
+    threads = std::max(1u, std::min<unsigned>(threads, static_cast<unsigned>((n + grain - 1) / grain)));
+    if (threads == 1) {
+        for (size_t i = 0; i < n; ++i) fn(i, 0u);
+        return 0;
+    }
+    struct alignas(64) Range {
+        std::mutex lock;
+        size_t begin = 0, end = 0;
+    };
+    std::unique_ptr<Range[]> ranges(new Range[threads]);
+    for (unsigned t = 0; t < threads; ++t) {
+        ranges[t].begin = n * t / threads;
+        ranges[t].end = n * (t + 1) / threads;
+    }
+    std::atomic<uint64_t> steals{0};
+    WorkerError error;
+    auto work = [&](unsigned self) {
+        Range& own = ranges[self];
+        while (!error.failed()) {
+            size_t begin = 0, end = 0;
+            {
+                std::lock_guard<std::mutex> guard(own.lock);
+                if (own.begin < own.end) {
+                    begin = own.begin;
+                    end = own.begin = std::min(own.end, own.begin + grain);
+                }
+            }
+            if (begin < end) {
+                for (size_t i = begin; i < end; ++i) fn(i, self);
+                continue;
+            }
+            // Víctima: el tramo restante más largo (nunca se sostienen dos cerrojos a la vez)
+            unsigned victim = self;
+            size_t longest = 0;
+            for (unsigned t = 0; t < threads; ++t) {
+                if (t == self) continue;
+                std::lock_guard<std::mutex> guard(ranges[t].lock);
+                if (ranges[t].end - ranges[t].begin > longest) {
+                    longest = ranges[t].end - ranges[t].begin;
+                    victim = t;
+                }
+            }
+            if (longest == 0) return;   // Lo que queda ya tiene dueño
+            {
+                std::lock_guard<std::mutex> guard(ranges[victim].lock);
+                size_t left = ranges[victim].end - ranges[victim].begin;
+                if (left == 0) continue;
+                begin = left == 1 ? ranges[victim].begin : ranges[victim].end - left / 2;
+                end = ranges[victim].end;
+                ranges[victim].end = begin;
+            }
+            std::lock_guard<std::mutex> guard(own.lock);
+            own.begin = begin;
+            own.end = end;
+            ++steals;
+        }
+    };
+    auto worker = [&](unsigned self) {
+        try {
+            work(self);
+        } catch (...) {
+            error.capture();
+        }
+    };
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker, t);
+    worker(0);
+    for (std::thread& t : pool) t.join();
+    error.rethrow();
+    return steals.load();
+}
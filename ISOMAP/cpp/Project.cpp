@@ -0,0 +1,84 @@
+// isomap-project: proyecta las muestras de un GCT nuevo con un modelo guardado por isomap-cpp
+// (--knn-model / --eps-model) sin recalcular la proyección
+// Uso: isomap-project --model RUTA --input GCT [--output CSV] [--batch N] [--threads N]
+//                     [--simd escalar|avx2|avx512]
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "GctLoader.h"
+#include "IsomapModel.h"
+
+static double seconds(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+int main(int argc, char* argv[]) {
+    std::string modelPath, inputPath, outputPath;
+    ProjectorOptions options;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i], val = argv[i + 1];
+        try {
+            if (arg == "--model") modelPath = val;
+            else if (arg == "--input") inputPath = val;
+            else if (arg == "--output") outputPath = val;
+            else if (arg == "--batch") options.batch = std::max(1ul, std::stoul(val));
+            else if (arg == "--threads") options.threads = std::max(1, std::stoi(val));
+            else if (arg == "--simd") options.simd = parseSimdLevel(val);
+            else {
+                std::cerr << "Opción desconocida: " << arg << "\n";
+                return 2;
+            }
+        } catch (const std::logic_error&) {   // stoul/stoi/stof/parseSimdLevel: invalid_argument u out_of_range
+            std::cerr << "Valor no válido para " << arg << ": " << val << "\n";
+            return 2;
+        }
+    }
+    if (modelPath.empty() || inputPath.empty()) {
+        std::cerr << "Uso: isomap-project --model RUTA --input GCT [--output CSV] [--batch N] [--threads N]\n";
+        return 2;
+    }
+    options.simd = std::min(options.simd, detectSimdLevel());
+
+    try {
+        auto t0 = std::chrono::steady_clock::now();
+        IsomapModel model = IsomapModel::open(modelPath);
+        std::cout << "Modelo: " << model.numPoints() << " muestras x " << model.dims() << " genes, "
+                  << model.numLandmarks() << " landmarks, k=" << model.neighbors() << " (" << std::fixed
+                  << std::setprecision(2) << model.fileBytes() / 1048576.0 << " MiB, abierto en "
+                  << std::setprecision(1) << seconds(t0) * 1000 << " ms)\n";
+
+        t0 = std::chrono::steady_clock::now();
+        GctData data = loadGct(inputPath);
+        Matrix queries = selectGenes(data, model.genes());
+        std::cout << "Muestras nuevas: " << data.samples.size() << " (" << seconds(t0) * 1000 << " ms)\n";
+
+        ProjectionStats stats;
+        std::vector<double> coordinates = projectSamples(model, queries, options, &stats);
+        std::cout << "Proyección: " << stats.batches << " lotes en " << stats.seconds * 1000 << " ms (vecinos "
+                  << stats.knnSeconds * 1000 << " ms), " << std::setprecision(0) << stats.samples / stats.seconds
+                  << " muestras/s\n";
+        size_t missing = 0;
+        for (size_t i = 0; i < data.samples.size(); ++i) missing += std::isnan(coordinates[i * model.components()]);
+        if (missing) std::cout << "Aviso: " << missing << " muestras con valores no numéricos quedan sin proyectar\n";
+
+        if (!outputPath.empty()) {
+            std::vector<std::string> labels;
+            for (const std::string& s : data.samples) labels.push_back(sampleLabel(s));
+            if (!writeEmbeddingCsv(coordinates, model.components(), labels, outputPath)) {
+                std::cerr << "No se pudo escribir " << outputPath << "\n";
+                return 1;
+            }
+            std::cout << "  -> " << outputPath << "\n";
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
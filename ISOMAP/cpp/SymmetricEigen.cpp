@@ -0,0 +1,197 @@
+#include "SymmetricEigen.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+double dot(const double* a, const double* b, size_t n) {
+    double s = 0;
+    for (size_t i = 0; i < n; ++i) s += a[i] * b[i];
+    return s;
+}
+
+// w -= (w . v) v para cada vector de la base (dos pasadas: Gram-Schmidt clásico reiterado)
+void orthogonalize(std::vector<double>& w, const std::vector<std::vector<double>>& basis) {
+    for (int pass = 0; pass < 2; ++pass) {
+        for (const std::vector<double>& v : basis) {
+            double c = dot(w.data(), v.data(), w.size());
+            for (size_t i = 0; i < w.size(); ++i) w[i] -= c * v[i];
+        }
+    }
+}
+
+} // namespace
+
+// QL implícito sobre la tridiagonal
+void tridiagonalEigen(std::vector<double> d, const std::vector<double>& off, std::vector<double>& values,
+                      std::vector<double>& vectors) {
+    const size_t n = d.size();
+    if (off.size() + 1 != n && n > 0) throw std::invalid_argument("tridiagonalEigen: tamaños incompatibles");
+    std::vector<double> e(n, 0.0);
+    std::copy(off.begin(), off.end(), e.begin());
+    vectors.assign(n * n, 0.0);
+    for (size_t i = 0; i < n; ++i) vectors[i * n + i] = 1.0;
+    auto V = [&](size_t r, size_t c) -> double& { return vectors[r * n + c]; };
+
+    const double eps = std::numeric_limits<double>::epsilon();
+    double f = 0.0, tst1 = 0.0;
+    for (size_t l = 0; l < n; ++l) {
+        tst1 = std::max(tst1, std::abs(d[l]) + std::abs(e[l]));
+        size_t m = l;
+        while (m < n && std::abs(e[m]) > eps * tst1) ++m;
+        if (m == n) m = n - 1;
+        if (m > l) {
+            do {
+                // Desplazamiento de Wilkinson a partir del bloque 2 x 2 superior
+                double g = d[l];
+                double p = (d[l + 1] - g) / (2.0 * e[l]);
+                double r = std::hypot(p, 1.0);
+                if (p < 0) r = -r;
+                d[l] = e[l] / (p + r);
+                d[l + 1] = e[l] * (p + r);
+                const double dl1 = d[l + 1];
+                double h = g - d[l];
+                for (size_t i = l + 2; i < n; ++i) d[i] -= h;
+                f += h;
+
+                // Barrido de rotaciones de m hacia l
+                p = d[m];
+                double c = 1.0, c2 = 1.0, c3 = 1.0, s = 0.0, s2 = 0.0;
+                const double el1 = e[l + 1];
+                for (size_t i = m; i-- > l;) {
+                    c3 = c2;
+                    c2 = c;
+                    s2 = s;
+                    g = c * e[i];
+                    h = c * p;
+                    r = std::hypot(p, e[i]);
+                    e[i + 1] = s * r;
+                    s = e[i] / r;
+                    c = p / r;
+                    p = c * d[i] - s * g;
+                    d[i + 1] = h + s * (c * g + s * d[i]);
+                    for (size_t row = 0; row < n; ++row) {
+                        h = V(row, i + 1);
+                        V(row, i + 1) = s * V(row, i) + c * h;
+                        V(row, i) = c * V(row, i) - s * h;
+                    }
+                }
+                p = -s * s2 * c3 * el1 * e[l] / dl1;
+                e[l] = s * p;
+                d[l] = c * p;
+            } while (std::abs(e[l]) > eps * tst1);
+        }
+        d[l] += f;
+        e[l] = 0.0;
+    }
+
+    // Orden creciente (columnas de vectors permutadas a la par)
+    std::vector<size_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return d[a] < d[b]; });
+    values.resize(n);
+    std::vector<double> sorted(n * n);
+    for (size_t c = 0; c < n; ++c) {
+        values[c] = d[order[c]];
+        for (size_t r = 0; r < n; ++r) sorted[r * n + c] = vectors[r * n + order[c]];
+    }
+    vectors.swap(sorted);
+}
+
+// Lanczos con reortogonalización completa
+EigenResult lanczosTopEigen(size_t n, size_t k, const std::function<void(const double*, double*)>& multiply,
+                            unsigned seed, double tolerance) {
+    if (k == 0 || k > n) throw std::invalid_argument("lanczosTopEigen: se piden " + std::to_string(k) +
+                                                     " valores de una matriz de " + std::to_string(n));
+    std::mt19937_64 rng(seed);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    auto randomUnit = [&](const std::vector<std::vector<double>>& basis, std::vector<double>& q) {
+        for (int attempt = 0; attempt < 4; ++attempt) {
+            for (double& x : q) x = normal(rng);
+            orthogonalize(q, basis);
+            double norm = std::sqrt(dot(q.data(), q.data(), n));
+            if (norm > 1e-8) {
+                for (double& x : q) x /= norm;
+                return true;
+            }
+        }
+        return false;
+    };
+
+    std::vector<std::vector<double>> basis;
+    std::vector<double> alpha, beta;
+    std::vector<double> q(n), w(n);
+    randomUnit(basis, q);
+
+    EigenResult result;
+    std::vector<double> ritz, z;
+    size_t steps = 0;
+    for (;;) {
+        basis.push_back(q);
+        multiply(q.data(), w.data());
+        ++steps;
+        const std::vector<double>& current = basis.back();
+        double a = dot(w.data(), current.data(), n);
+        alpha.push_back(a);
+        for (size_t i = 0; i < n; ++i) {
+            w[i] -= a * current[i];
+            if (basis.size() > 1) w[i] -= beta.back() * basis[basis.size() - 2][i];
+        }
+        orthogonalize(w, basis);
+        double b = std::sqrt(dot(w.data(), w.data(), n));
+        const bool exhausted = steps == n || b <= 1e-12 * std::max(1.0, std::abs(a));
+
+        // Convergencia de los k vectores de Ritz mayores (cada 8 pasos, o al agotar el espacio)
+        if (steps >= k && (exhausted || steps % 8 == 0)) {
+            tridiagonalEigen(alpha, beta, ritz, z);
+            const double scale = std::max({1e-300, std::abs(ritz.front()), std::abs(ritz.back())});
+            bool converged = true;
+            for (size_t c = steps - k; c < steps && converged; ++c) {
+                converged = std::abs(b * z[(steps - 1) * steps + c]) <= tolerance * scale;
+            }
+            if (converged || exhausted) {
+                result.converged = true;
+                break;
+            }
+        }
+        if (exhausted) {
+            // Espacio agotado antes de k pasos: se continúa con un vector nuevo ortogonal
+            if (!randomUnit(basis, q)) break;
+            beta.push_back(0.0);
+            continue;
+        }
+        beta.push_back(b);
+        for (size_t i = 0; i < n; ++i) q[i] = w[i] / b;
+    }
+    if (ritz.size() != steps) {
+        beta.resize(steps - 1);
+        tridiagonalEigen(alpha, beta, ritz, z);
+    }
+
+    // Vectores de Ritz de los k mayores: u = V z
+    const size_t found = std::min(k, steps);
+    result.iterations = steps;
+    result.values.assign(k, 0.0);
+    result.vectors.assign(k * n, 0.0);
+    for (size_t c = 0; c < found; ++c) {
+        const size_t col = steps - 1 - c;
+        result.values[c] = ritz[col];
+        double* u = result.vectors.data() + c * n;
+        for (size_t j = 0; j < steps; ++j) {
+            const double coef = z[j * steps + col];
+            for (size_t i = 0; i < n; ++i) u[i] += coef * basis[j][i];
+        }
+        double norm = std::sqrt(dot(u, u, n));
+        size_t big = 0;
+        for (size_t i = 1; i < n; ++i) big = std::abs(u[i]) > std::abs(u[big]) ? i : big;
+        const double sign = u[big] < 0 ? -1.0 : 1.0;
+        for (size_t i = 0; i < n; ++i) u[i] *= sign / norm;
+    }
+    return result;
+}
@@ -0,0 +1,31 @@
+// SymmetricEigen.h
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+// Valores y vectores propios de una matriz tridiagonal simétrica (QL implícito con
+// desplazamientos, tql2 de EISPACK). diag tiene n elementos y off los n - 1 de la
+// subdiagonal; devuelve los valores en orden creciente y, en vectors (n x n, por filas), el
+// vector propio de values[c] en la columna c.
+void tridiagonalEigen(std::vector<double> diag, const std::vector<double>& off, std::vector<double>& values,
+                      std::vector<double>& vectors);
+
+// Resultado de lanczosTopEigen
+struct EigenResult {
+    std::vector<double> values;         // Los k mayores (algebraicos), de mayor a menor
+    std::vector<double> vectors;        // k x n por filas: vectors[c * n + i]
+    size_t iterations = 0;              // Pasos de Lanczos (multiplicaciones)
+    bool converged = false;
+};
+
+// Los k mayores valores propios (algebraicos, no en módulo: B de MDS puede tener valores
+// negativos grandes) de una matriz simétrica n x n que solo se conoce por su producto
+// multiply(x, y): y = A x. Lanczos con reortogonalización completa (la base se guarda entera:
+// O(n * pasos) de memoria), comprobando cada pocos pasos el residuo |beta_j * z_j| de los k
+// vectores de Ritz con tridiagonalEigen. Si el subespacio de Krylov se agota (beta = 0), los
+// valores de Ritz ya son exactos. Los vectores se normalizan y orientan con su mayor
+// componente en módulo positiva, para que el resultado no dependa del vector inicial.
+EigenResult lanczosTopEigen(size_t n, size_t k, const std::function<void(const double*, double*)>& multiply,
+                            unsigned seed = 42, double tolerance = 1e-10);
@@ -0,0 +1,52 @@
+"""Compara el motor de geodésicas de C++ con scipy.sparse.csgraph.shortest_path.
+
+Uso: python cpp/compare_scipy.py GRAFO.csr MATRIZ.geo [GRAFO.csr MATRIZ.geo ...]
+
+GRAFO.csr es un grafo guardado por isomap-cpp / bench-geodesics (writeCsr) y MATRIZ.geo la
+matriz de distancias por bloques que escribió el motor para ese grafo (DistanceMatrix).
+"""
+import sys
+import time
+
+import numpy as np
+from scipy.sparse import csr_matrix
+from scipy.sparse.csgraph import shortest_path
+
+
+def load_csr(path):
+    raw = open(path, "rb").read()
+    assert raw[:8] == b"ISOMPCSR", f"{path} no es un CSR de isomap-cpp"
+    version, flags = np.frombuffer(raw, np.uint32, 2, 8)
+    n, nnz = (int(x) for x in np.frombuffer(raw, np.uint64, 2, 16))
+    pos = 32
+    offsets = np.frombuffer(raw, np.uint64, n + 1, pos).astype(np.int64)
+    pos += 8 * (n + 1)
+    targets = np.frombuffer(raw, np.uint32, nnz, pos).astype(np.int32)
+    pos += 4 * nnz
+    weighted = bool(flags & 1)
+    weights = np.frombuffer(raw, np.float32, nnz, pos).astype(np.float64) if weighted else np.ones(nnz)
+    return csr_matrix((weights, targets, offsets), shape=(n, n)), weighted
+
+
+def load_geo(path):
+    raw = np.memmap(path, np.uint8, "r")
+    assert bytes(raw[:8]) == b"ISOMPGEO", f"{path} no es una matriz de geodésicas"
+    block = int(np.frombuffer(raw[12:16], np.uint32)[0])
+    n = int(np.frombuffer(raw[16:24], np.uint64)[0])
+    stripes = (n + block - 1) // block
+    tiles = np.frombuffer(raw[4096:], np.float32).reshape(stripes, stripes, block, block)
+    return tiles.transpose(0, 2, 1, 3).reshape(stripes * block, stripes * block)[:n, :n]
+
+
+for graph_path, geo_path in zip(sys.argv[1::2], sys.argv[2::2]):
+    W, weighted = load_csr(graph_path)
+    start = time.perf_counter()
+    D = shortest_path(csgraph=W, directed=False, unweighted=not weighted)
+    elapsed = time.perf_counter() - start
+    G = load_geo(geo_path).astype(np.float64)
+    finite = np.isfinite(D)
+    same_inf = np.array_equal(finite, np.isfinite(G))
+    rel = np.abs(G[finite] - D[finite]) / np.maximum(D[finite], 1e-12)
+    print(f"{graph_path}: {W.shape[0]} nodos, scipy {elapsed:.2f} s "
+          f"({W.shape[0] ** 2 / elapsed / 1e6:.2f} M pares/s); "
+          f"infinitos {'iguales' if same_inf else 'DISTINTOS'}, error relativo máx. {rel.max():.2e}")
@@ -0,0 +1,145 @@
+// isomap-cpp: carga los GCT de leucemia, construye los grafos de vecindad de ISOMAP y, si se
+// piden, sus proyecciones (ISOMAP clásico o con landmarks) en C++
+// Uso: isomap-cpp [--train RUTA] [--test RUTA] [--k N] [--eps X] [--knn-csr RUTA] [--eps-csr RUTA]
+//                 [--knn-geo RUTA] [--eps-geo RUTA] [--knn-embedding RUTA] [--eps-embedding RUTA]
+//                 [--knn-model RUTA] [--eps-model RUTA] [--landmarks M]
+//                 [--landmark-mode maxmin|aleatorio] [--components N] [--threads N] [--simd escalar|avx2|avx512]
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "GctLoader.h"
+#include "Geodesics.h"
+#include "Isomap.h"
+#include "IsomapModel.h"
+#include "NeighborGraph.h"
+
+static double seconds(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+int main(int argc, char* argv[]) {
+    std::string trainPath = "data/all_aml_train.gct", testPath = "data/all_aml_test.gct";
+    std::string knnCsr, epsCsr, knnGeo, epsGeo, knnEmbedding, epsEmbedding, knnModel, epsModel;
+    unsigned k = 6;
+    float epsilon = 0.0f;   // 0: el radio del k-ésimo vecino, como el script de Python
+    NeighborOptions options;
+    IsomapOptions isomapOptions;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i], val = argv[i + 1];
+        try {
+            if (arg == "--train") trainPath = val;
+            else if (arg == "--test") testPath = val;
+            else if (arg == "--k") k = static_cast<unsigned>(std::stoul(val));
+            else if (arg == "--eps") epsilon = std::stof(val);
+            else if (arg == "--knn-csr") knnCsr = val;
+            else if (arg == "--eps-csr") epsCsr = val;
+            else if (arg == "--knn-geo") knnGeo = val;
+            else if (arg == "--eps-geo") epsGeo = val;
+            else if (arg == "--knn-embedding") knnEmbedding = val;
+            else if (arg == "--eps-embedding") epsEmbedding = val;
+            else if (arg == "--knn-model") knnModel = val;
+            else if (arg == "--eps-model") epsModel = val;
+            else if (arg == "--landmarks") isomapOptions.landmarks = std::stoul(val);
+            else if (arg == "--landmark-mode") {
+                isomapOptions.selection = val == "aleatorio" ? LandmarkSelection::Random : LandmarkSelection::MaxMin;
+            } else if (arg == "--components") isomapOptions.components = std::max(1ul, std::stoul(val));
+            else if (arg == "--threads") options.threads = std::max(1, std::stoi(val));
+            else if (arg == "--simd") options.simd = parseSimdLevel(val);
+            else {
+                std::cerr << "Opción desconocida: " << arg << "\n";
+                return 2;
+            }
+        } catch (const std::logic_error&) {   // stoul/stoi/stof/parseSimdLevel: invalid_argument u out_of_range
+            std::cerr << "Valor no válido para " << arg << ": " << val << "\n";
+            return 2;
+        }
+    }
+    options.simd = std::min(options.simd, detectSimdLevel());
+    isomapOptions.threads = options.threads;
+
+    // Geodésicas de un grafo guardadas en un archivo (matriz por bloques de Geodesics.h)
+    auto geodesics = [&](const char* name, const CsrGraph& graph, const std::string& filename) {
+        GeodesicOptions geo;
+        geo.threads = options.threads;
+        geo.spillFile = filename;
+        GeodesicStats stats;
+        allPairsGeodesics(viewOf(graph), geo, &stats);
+        std::cout << "  Geodésicas " << name << " -> " << filename << " (" << std::setprecision(1)
+                  << stats.seconds * 1000 << " ms)\n";
+        if (stats.unreachablePairs) {
+            std::cout << "  Aviso: el grafo no es conexo (" << stats.unreachablePairs << " pares sin camino)\n";
+        }
+    };
+
+    // Proyección de un grafo en un CSV con el formato de output/isomap_knn.csv y/o su modelo
+    // para proyectar muestras nuevas con isomap-project
+    std::vector<std::string> labels;
+    auto embed = [&](const char* name, const GctData& data, const CsrGraph& graph, const std::string& csv,
+                     const std::string& model) {
+        if (csv.empty() && model.empty()) return;
+        IsomapEmbedding embedding = isomap(viewOf(graph), isomapOptions);
+        std::cout << "  ISOMAP " << name << " (" << embedding.numLandmarks() << " landmarks)" << std::setprecision(1)
+                  << ": geodésicas " << embedding.geodesicSeconds * 1000 << " ms, Lanczos "
+                  << embedding.eigenSeconds * 1000 << " ms en " << embedding.lanczosIterations
+                  << " pasos, triangulación " << embedding.triangulationSeconds * 1000 << " ms\n";
+        if (!csv.empty()) {
+            if (!writeEmbeddingCsv(embedding, labels, csv)) throw std::runtime_error("No se pudo escribir " + csv);
+            std::cout << "    -> " << csv << "\n";
+        }
+        if (!model.empty()) {
+            if (!saveIsomapModel(model, data.values, data.genes, graph, k, embedding)) {
+                throw std::runtime_error("No se pudo escribir " + model);
+            }
+            std::cout << "    modelo -> " << model << "\n";
+        }
+    };
+
+    try {
+        auto t0 = std::chrono::steady_clock::now();
+        // Sin --test (ruta vacía) solo se usa el conjunto de entrenamiento
+        GctData data = concatSamples(loadGct(trainPath), testPath.empty() ? GctData{} : loadGct(testPath));
+        std::cout << "Datos: " << data.samples.size() << " muestras x " << data.genes.size() << " genes sin NaN ("
+                  << std::fixed << std::setprecision(1) << seconds(t0) * 1000 << " ms)\n";
+        size_t all = 0, aml = 0;
+        for (const std::string& s : data.samples) {
+            std::string label = sampleLabel(s);
+            labels.push_back(label);
+            all += label == "ALL";
+            aml += label == "AML";
+        }
+        std::cout << "Etiquetas: " << all << " ALL, " << aml << " AML\n";
+        std::cout << "Núcleo de distancias: " << simdLevelName(options.simd) << ", " << options.threads << " hilos\n";
+
+        t0 = std::chrono::steady_clock::now();
+        KnnTable table = nearestNeighbors(data.values, k, options);
+        CsrGraph knn = knnGraph(table, options.threads);
+        std::cout << "Grafo kNN (k=" << k << "): " << knn.numEdges() << " aristas (" << seconds(t0) * 1000 << " ms)\n";
+        if (!knnCsr.empty() && !writeCsr(knn, knnCsr)) {
+            std::cerr << "No se pudo escribir " << knnCsr << "\n";
+            return 1;
+        }
+        if (!knnGeo.empty()) geodesics("kNN", knn, knnGeo);
+        embed("kNN", data, knn, knnEmbedding, knnModel);
+
+        if (epsilon <= 0.0f) epsilon = kthNeighborRadius(table);
+        t0 = std::chrono::steady_clock::now();
+        CsrGraph eps = epsilonGraph(data.values, epsilon, options);
+        std::cout << std::setprecision(3) << "Grafo ε (ε=" << epsilon << "): " << eps.numEdges() << " aristas ("
+                  << std::setprecision(1) << seconds(t0) * 1000 << " ms)\n";
+        if (!epsCsr.empty() && !writeCsr(eps, epsCsr)) {
+            std::cerr << "No se pudo escribir " << epsCsr << "\n";
+            return 1;
+        }
+        if (!epsGeo.empty()) geodesics("ε", eps, epsGeo);
+        embed("ε", data, eps, epsEmbedding, epsModel);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,193 @@
+// Benchmark de la asignación del grafo mutable: heap global (una asignación por nombre, nodo
+// de mapa/conjunto y título copiado) frente a GraphArena (bloques grandes, liberación en bloque).
+// Mide asignaciones al heap, bytes, tiempo de construcción y de destrucción, y comprueba que
+// ambos grafos son iguales.
+// Las dos variantes se alternan durante varias rondas y se informa el mejor tiempo de cada una
+// (la primera construcción de un proceso paga fallos de página que las siguientes no).
+// Uso: bench-arena [--movies N] [--cast N] [--actors N] [--seed N] [--rounds N]
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <malloc.h>
+#include <algorithm>
+#include <memory>
+#include "Graph.h"
+#include "GraphArena.h"
+
+// Contabilidad del heap (glibc): número de asignaciones y bytes vivos (malloc_usable_size)
+static std::atomic<size_t> g_allocs{0};
+static std::atomic<size_t> g_current{0};
+
+void* operator new(std::size_t size) {
+    void* p = std::malloc(size);
+    if (!p) throw std::bad_alloc();
+    ++g_allocs;
+    g_current += malloc_usable_size(p);
+    return p;
+}
+
+// Fuera de línea: si GCC la inserta donde ve el operator new, avisa de un free "desparejado"
+// (-Wmismatched-new-delete) sin saber que ambos están reemplazados sobre malloc
+__attribute__((noinline)) void operator delete(void* p) noexcept {
+    if (!p) return;
+    g_current -= malloc_usable_size(p);
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept { operator delete(p); }
+
+// std::pmr::new_delete_resource asigna con la versión alineada
+void* operator new(std::size_t size, std::align_val_t align) {
+    size_t a = static_cast<size_t>(align);
+    void* p = std::aligned_alloc(a, (size + a - 1) / a * a);
+    if (!p) throw std::bad_alloc();
+    ++g_allocs;
+    g_current += malloc_usable_size(p);
+    return p;
+}
+
+void operator delete(void* p, std::align_val_t) noexcept { operator delete(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { operator delete(p); }
+
+static double seconds(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+struct Movie {
+    int id;
+    std::string title;
+    int year;
+    std::vector<int> cast;
+};
+
+// Carga la carga de trabajo en el grafo con la API mutable
+static void build(Graph& graph, const std::vector<Movie>& movies, const std::vector<std::string>& names, int firstId) {
+    for (const Movie& movie : movies) {
+        for (int id : movie.cast) graph.addActor(id, names[id - firstId]);
+        for (size_t i = 0; i < movie.cast.size(); ++i)
+            for (size_t j = i + 1; j < movie.cast.size(); ++j)
+                graph.addCollaboration(movie.cast[i], movie.cast[j], movie.id, movie.title, movie.year);
+    }
+}
+
+// Huella de la adyacencia (independiente del orden de iteración)
+static uint64_t fingerprint(const Graph& graph, int firstId, int actors) {
+    uint64_t h = 0;
+    for (int id = firstId; id < firstId + actors; ++id) {
+        graph.forEachNeighbor(id, [&](int v) { h += (static_cast<uint64_t>(id) * 0x9E3779B97F4A7C15ULL) ^ v; });
+    }
+    return h;
+}
+
+int main(int argc, char* argv[]) {
+    int movieCount = 25000, castSize = 10, actorsPool = 200000;
+    unsigned seed = 42;
+    int rounds = 3;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        int val = std::stoi(argv[i + 1]);
+        if (arg == "--movies") movieCount = val;
+        else if (arg == "--cast") castSize = val;
+        else if (arg == "--actors") actorsPool = val;
+        else if (arg == "--seed") seed = static_cast<unsigned>(val);
+        else if (arg == "--rounds") rounds = std::max(1, val);
+    }
+
+    // Carga de trabajo preparada de antemano (fuera de las mediciones); nombres y títulos
+    // largos para que no quepan en la optimización de cadenas cortas
+    const int firstId = 1000000;
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::uniform_int_distribution<int> yearDist(1960, 2023);
+    std::vector<std::string> names(actorsPool);
+    for (int a = 0; a < actorsPool; ++a) names[a] = "Synthetic Actor Name " + std::to_string(firstId + a);
+    std::vector<Movie> movies(movieCount);
+    for (int m = 0; m < movieCount; ++m) {
+        movies[m].id = m;
+        movies[m].title = "Synthetic Movie Title Number " + std::to_string(m);
+        movies[m].year = yearDist(rng);
+        std::vector<int>& cast = movies[m].cast;
+        while (static_cast<int>(cast.size()) < castSize) {
+            double u = unit(rng);
+            int id = firstId + static_cast<int>(u * u * actorsPool);
+            bool dup = false;
+            for (int c : cast) dup = dup || c == id;
+            if (!dup) cast.push_back(id);
+        }
+    }
+
+    struct Result {
+        const char* name = nullptr;
+        size_t allocs = 0, bytes = 0, nodes = 0, edges = 0;
+        double buildSecs = 0, teardownSecs = 0;
+        uint64_t print = 0;
+    };
+    auto measure = [&](const char* name, auto&& makeGraph, auto&& teardown) {
+        Result r;
+        r.name = name;
+        size_t allocs0 = g_allocs.load(), bytes0 = g_current.load();
+        auto t0 = std::chrono::steady_clock::now();
+        auto graph = makeGraph();
+        build(*graph, movies, names, firstId);
+        r.buildSecs = seconds(t0);
+        r.allocs = g_allocs.load() - allocs0;
+        r.bytes = g_current.load() - bytes0;
+        r.nodes = graph->numActors();
+        r.edges = graph->numCollaborations();
+        r.print = fingerprint(*graph, firstId, actorsPool);
+        t0 = std::chrono::steady_clock::now();
+        teardown(graph);
+        r.teardownSecs = seconds(t0);
+        return r;
+    };
+
+    GraphArena arena(size_t(16) << 20);
+    size_t arenaCalls = 0, arenaBytes = 0;
+    Result heap{}, pooled{};
+    auto keepBest = [](Result& best, const Result& r) {
+        if (!best.name) {
+            best = r;
+            return;
+        }
+        best.buildSecs = std::min(best.buildSecs, r.buildSecs);
+        best.teardownSecs = std::min(best.teardownSecs, r.teardownSecs);
+    };
+    for (int round = 0; round < rounds; ++round) {
+        keepBest(heap, measure(
+            "heap global",
+            [] { return std::make_unique<Graph>(); },
+            [](std::unique_ptr<Graph>& g) { g.reset(); }));
+        keepBest(pooled, measure(
+            "GraphArena",
+            [&] { return std::make_unique<Graph>(&arena); },
+            [&](std::unique_ptr<Graph>& g) {
+                arenaCalls = arena.allocations();
+                arenaBytes = arena.bytesAllocated();
+                g->clear();
+                g.reset();
+                arena.release();
+            }));
+    }
+
+    std::cout << "Carga sintética: " << movieCount << " películas x " << castSize << " actores -> "
+              << heap.nodes << " actores, " << heap.edges << " aristas\n";
+    std::cout << std::fixed << std::setprecision(1);
+    for (const Result& r : {heap, pooled}) {
+        std::cout << std::left << std::setw(12) << r.name << std::right
+                  << "  asignaciones al heap: " << std::setw(9) << r.allocs
+                  << "  memoria: " << std::setw(7) << r.bytes / 1048576.0 << " MiB"
+                  << "  construcción: " << std::setw(7) << r.buildSecs * 1000 << " ms"
+                  << "  destrucción: " << std::setw(6) << r.teardownSecs * 1000 << " ms\n";
+    }
+    std::cout << "GraphArena atendió " << arenaCalls << " asignaciones (" << arenaBytes / 1048576.0 << " MiB pedidos) con "
+              << pooled.allocs << " bloques del heap\n";
+    bool same = heap.nodes == pooled.nodes && heap.edges == pooled.edges && heap.print == pooled.print;
+    std::cout << "Grafos " << (same ? "idénticos" : "DIFERENTES") << "\n";
+    return same ? 0 : 1;
+}
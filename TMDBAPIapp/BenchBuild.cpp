@@ -0,0 +1,136 @@
+// Benchmark de construcción concurrente del grafo con repartos sintéticos grandes:
+// mutex global + addCollaboration (esquema anterior del crawler) frente a GraphBuilder
+// (búferes por hilo + fusión paralela). Verifica que ambos producen el mismo grafo.
+// Uso: bench-build [--movies N] [--cast N] [--actors N] [--threads 1,2,4,8]
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include "Graph.h"
+#include "GraphBuilder.h"
+
+struct SyntheticMovie {
+    int id;
+    std::string title;
+    int year;
+    std::vector<int> cast;
+};
+
+static double seconds(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+// Ejecuta work(t) en `threads` hilos
+template <class F>
+static void runThreads(unsigned threads, F&& work) {
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < threads; ++t) pool.emplace_back(work, t);
+    for (auto& th : pool) th.join();
+}
+
+// Compara dos grafos congelados arista por arista
+static bool sameGraph(const Graph& x, const Graph& y) {
+    if (x.numActors() != y.numActors() || x.numCollaborations() != y.numCollaborations()) return false;
+    for (uint32_t e = 0; e < x.numCollaborations(); ++e) {
+        if (x.actorId(x.edgeSource(e)) != y.actorId(y.edgeSource(e)) ||
+            x.actorId(x.edgeTarget(e)) != y.actorId(y.edgeTarget(e)) ||
+            x.edgeYear(e) != y.edgeYear(e) || x.edgeTitle(e) != y.edgeTitle(e) ||
+            x.edgeWeight(e) != y.edgeWeight(e)) return false;
+        std::span<const uint32_t> hx = x.edgeMovies(e), hy = y.edgeMovies(e);
+        if (hx.size() != hy.size()) return false;
+        for (size_t i = 0; i < hx.size(); ++i) {
+            if (x.movieId(hx[i]) != y.movieId(hy[i]) || x.movieTitle(hx[i]) != y.movieTitle(hy[i]) ||
+                x.movieYear(hx[i]) != y.movieYear(hy[i])) return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    int movies = 3000, castSize = 60, actorsPool = 100000;
+    std::vector<unsigned> threadCounts = {1, 2, 4, 8};
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        std::string val = argv[i + 1];
+        if (arg == "--movies") movies = std::stoi(val);
+        else if (arg == "--cast") castSize = std::stoi(val);
+        else if (arg == "--actors") actorsPool = std::stoi(val);
+        else if (arg == "--threads") {
+            threadCounts.clear();
+            std::stringstream ss(val);
+            for (std::string tok; std::getline(ss, tok, ',');) threadCounts.push_back(std::max(1, std::stoi(tok)));
+        }
+    }
+
+    // Repartos sintéticos con actores frecuentes (distribución sesgada) y años repetidos
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::uniform_int_distribution<int> yearDist(1980, 2023);
+    std::vector<SyntheticMovie> data(movies);
+    size_t pairs = 0;
+    for (int m = 0; m < movies; ++m) {
+        data[m].id = m;
+        data[m].title = "Movie " + std::to_string(m);
+        data[m].year = yearDist(rng);
+        while (static_cast<int>(data[m].cast.size()) < castSize) {
+            double u = unit(rng);
+            int id = 1000000 + static_cast<int>(u * u * u * actorsPool);
+            bool dup = false;
+            for (int c : data[m].cast) dup = dup || c == id;
+            if (!dup) data[m].cast.push_back(id);
+        }
+        pairs += data[m].cast.size() * (data[m].cast.size() - 1) / 2;
+    }
+    std::cout << movies << " películas x " << castSize << " actores = " << pairs << " pares (hw threads: "
+              << std::thread::hardware_concurrency() << ")\n";
+    std::cout << std::fixed << std::setprecision(1);
+
+    for (unsigned T : threadCounts) {
+        // (a) Mutex global (esquema anterior)
+        Graph locked;
+        std::mutex graphMutex;
+        auto t0 = std::chrono::steady_clock::now();
+        runThreads(T, [&](unsigned t) {
+            for (size_t m = t; m < data.size(); m += T) {
+                std::lock_guard<std::mutex> lock(graphMutex);
+                const auto& mv = data[m];
+                for (int id : mv.cast) locked.addActor(id, "Actor " + std::to_string(id));
+                for (size_t i = 0; i < mv.cast.size(); ++i)
+                    for (size_t j = i + 1; j < mv.cast.size(); ++j)
+                        locked.addCollaboration(mv.cast[i], mv.cast[j], mv.id, mv.title, mv.year);
+            }
+        });
+        double lockedBuild = seconds(t0);
+        locked.freeze();
+        double lockedTotal = seconds(t0);
+
+        // (b) Búferes por hilo + fusión paralela
+        Graph built;
+        GraphBuilder builder(T);
+        t0 = std::chrono::steady_clock::now();
+        std::vector<GraphBuilder::Buffer*> bufs;
+        for (unsigned t = 0; t < T; ++t) bufs.push_back(&builder.createBuffer());
+        runThreads(T, [&](unsigned t) {
+            for (size_t m = t; m < data.size(); m += T) {
+                const auto& mv = data[m];
+                for (int id : mv.cast) bufs[t]->addActor(id, "Actor " + std::to_string(id));
+                bufs[t]->addCast(mv.cast, mv.id, mv.title, mv.year);
+            }
+        });
+        double buffered = seconds(t0);
+        builder.buildInto(built);
+        double builderTotal = seconds(t0);
+
+        std::cout << "hilos=" << T << "  mutex: " << lockedBuild * 1000 << " ms (+freeze " << (lockedTotal - lockedBuild) * 1000
+                  << " ms = " << lockedTotal * 1000 << " ms, " << pairs / lockedBuild / 1e6 << " M pares/s)"
+                  << "  |  búferes: " << buffered * 1000 << " ms + fusión " << (builderTotal - buffered) * 1000
+                  << " ms = " << builderTotal * 1000 << " ms (" << pairs / builderTotal / 1e6 << " M pares/s)"
+                  << "  |  aristas " << built.numCollaborations() << (sameGraph(locked, built) ? ", idéntico" : ", DIFERENTE") << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,127 @@
+// Benchmark de detección de comunidades (Louvain paralelo) sobre grafos sintéticos con grados
+// y tamaños de comunidad en ley de potencia (partición plantada con mezcla mu). Reporta tiempo
+// por número de hilos, modularidad, número de comunidades y NMI frente a la partición plantada.
+// Uso: bench-communities [--nodes N] [--edges M] [--mu X] [--seed N] [--threads 1,2,4,8]
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <unordered_map>
+#include "Graph.h"
+#include "GraphBuilder.h"
+#include "Communities.h"
+
+static double seconds(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+// Muestra de una ley de potencia discreta en [lo, hi] con exponente gamma
+static int powerLaw(std::mt19937_64& rng, double gamma, int lo, int hi) {
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    double a = std::pow(lo, 1.0 - gamma), b = std::pow(hi + 1.0, 1.0 - gamma);
+    return std::min(hi, static_cast<int>(std::pow(a + (b - a) * unit(rng), 1.0 / (1.0 - gamma))));
+}
+
+// Información mutua normalizada entre dos particiones
+static double nmi(const std::vector<uint32_t>& x, const std::vector<uint32_t>& y) {
+    const double n = static_cast<double>(x.size());
+    std::unordered_map<uint32_t, double> cx, cy;
+    std::unordered_map<uint64_t, double> joint;
+    for (size_t i = 0; i < x.size(); ++i) {
+        cx[x[i]] += 1;
+        cy[y[i]] += 1;
+        joint[(static_cast<uint64_t>(x[i]) << 32) | y[i]] += 1;
+    }
+    auto entropy = [&](const std::unordered_map<uint32_t, double>& c) {
+        double h = 0;
+        for (const auto& [_, k] : c) h -= k / n * std::log(k / n);
+        return h;
+    };
+    double mi = 0;
+    for (const auto& [key, k] : joint) {
+        double px = cx[static_cast<uint32_t>(key >> 32)] / n, py = cy[static_cast<uint32_t>(key)] / n;
+        mi += k / n * std::log(k / n / (px * py));
+    }
+    double hx = entropy(cx), hy = entropy(cy);
+    return hx + hy > 0 ? 2 * mi / (hx + hy) : 1.0;
+}
+
+int main(int argc, char* argv[]) {
+    int nodes = 200000;
+    size_t targetEdges = 1000000;
+    double mu = 0.3;
+    unsigned seed = 11;
+    std::vector<unsigned> threadCounts = {1, 2, 4, 8};
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        std::string val = argv[i + 1];
+        if (arg == "--nodes") nodes = std::stoi(val);
+        else if (arg == "--edges") targetEdges = std::stoull(val);
+        else if (arg == "--mu") mu = std::stod(val);
+        else if (arg == "--seed") seed = static_cast<unsigned>(std::stoul(val));
+        else if (arg == "--threads") {
+            threadCounts.clear();
+            std::stringstream ss(val);
+            for (std::string tok; std::getline(ss, tok, ',');) threadCounts.push_back(std::max(1, std::stoi(tok)));
+        }
+    }
+
+    // Partición plantada: tamaños de comunidad en ley de potencia (exponente 2, entre 20 y 2000)
+    std::mt19937_64 rng(seed);
+    std::vector<uint32_t> planted(nodes);
+    std::vector<std::vector<int>> groups;
+    for (int u = 0; u < nodes;) {
+        int size = std::min(nodes - u, powerLaw(rng, 2.0, 20, 2000));
+        groups.emplace_back();
+        for (int k = 0; k < size; ++k, ++u) {
+            planted[u] = static_cast<uint32_t>(groups.size() - 1);
+            groups.back().push_back(u);
+        }
+    }
+
+    // Grados en ley de potencia (exponente 2.5), escalados para acercarse a targetEdges.
+    // Cada extremo elige pareja en su comunidad con probabilidad 1 - mu y en todo el grafo con mu.
+    std::vector<int> degree(nodes);
+    double sum = 0;
+    for (int u = 0; u < nodes; ++u) sum += degree[u] = powerLaw(rng, 2.5, 3, 1000);
+    double scale = 2.0 * targetEdges / sum;
+    Graph graph;
+    GraphBuilder builder;
+    GraphBuilder::Buffer& buffer = builder.createBuffer();
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::uniform_int_distribution<int> anyNode(0, nodes - 1);
+    auto t0 = std::chrono::steady_clock::now();
+    for (int u = 0; u < nodes; ++u) {
+        buffer.addActor(1000000 + u, "Actor " + std::to_string(u));
+        int stubs = std::max(1, static_cast<int>(std::lround(degree[u] * scale / 2)));
+        const auto& group = groups[planted[u]];
+        for (int s = 0; s < stubs; ++s) {
+            int v = unit(rng) < mu ? anyNode(rng) : group[static_cast<size_t>(unit(rng) * group.size())];
+            buffer.addCollaboration(1000000 + u, 1000000 + v, 1, "Película sintética", 2000);
+        }
+    }
+    builder.buildInto(graph);
+    std::cout << graph.numActors() << " actores, " << graph.numCollaborations() << " colaboraciones, "
+              << groups.size() << " comunidades plantadas, mu=" << mu << " (construcción " << std::fixed
+              << std::setprecision(2) << seconds(t0) << " s)\n";
+
+    for (unsigned T : threadCounts) {
+        LouvainOptions opts;
+        opts.threads = T;
+        t0 = std::chrono::steady_clock::now();
+        Communities found = detectCommunities(graph, opts);
+        double detect = seconds(t0);
+        t0 = std::chrono::steady_clock::now();
+        CommunitySummary summary = summarizeCommunities(graph, found, T);
+        double summarize = seconds(t0);
+        std::cout << "hilos=" << T << "  louvain: " << std::setprecision(3) << detect << " s (" << found.levels
+                  << " niveles)  comunidades: " << found.sizes.size() << "  modularidad: " << std::setprecision(4)
+                  << found.modularity << "  NMI: " << nmi(planted, found.communityOf) << "  resumen: "
+                  << std::setprecision(3) << summarize << " s (" << summary.edges.size() << " aristas)\n";
+    }
+    return 0;
+}
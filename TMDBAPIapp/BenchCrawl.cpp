@@ -0,0 +1,69 @@
+// Benchmark de extremo a extremo: recorrido + construcción del grafo contra el servidor mock.
+// Uso: bench-crawl [--base-url URL] [--actor ID] [--start Y] [--end Y] [--concurrency N] [--repeat N]
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <stdexcept>
+#include "TMDBAPIUtils.h"
+#include "Graph.h"
+#include "Crawler.h"
+
+int main(int argc, char* argv[]) {
+    CrawlConfig cfg;
+    std::string baseUrl = "http://127.0.0.1:8080/3";
+    int repeat = 3;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        std::string val = argv[i + 1];
+        try {
+            if (arg == "--base-url") baseUrl = val;
+            else if (arg == "--actor") cfg.mainActorId = std::stoi(val);
+            else if (arg == "--start") cfg.startYear = std::stoi(val);
+            else if (arg == "--end") cfg.endYear = std::stoi(val);
+            else if (arg == "--concurrency") cfg.maxConcurrentCalls = std::max(1, std::stoi(val));
+            else if (arg == "--cast-limit") cfg.castLimit = std::stoi(val);
+            else if (arg == "--repeat") repeat = std::stoi(val);
+            else {
+                std::cerr << "Argumento desconocido: " << arg << "\n";
+                return 1;
+            }
+        } catch (const std::logic_error&) {   // stoi: invalid_argument u out_of_range
+            std::cerr << "Valor no válido para " << arg << ": " << val << "\n";
+            return 1;
+        }
+    }
+
+    repeat = std::max(repeat, 1);
+    TMDBAPIUtils::setBaseURL(baseUrl);
+    TMDBAPIUtils::setAPIKey("mock");
+
+    std::cout << "Benchmark de recorrido contra " << baseUrl << " (concurrencia "
+              << cfg.maxConcurrentCalls << ", " << repeat << " repeticiones)\n";
+    std::cout << std::fixed << std::setprecision(3);
+
+    std::vector<double> totals;
+    for (int r = 0; r < repeat; ++r) {
+        Graph graph;
+        CrawlStats stats = crawlCollaborations(cfg, graph);
+
+        auto t0 = std::chrono::steady_clock::now();
+        bool exported = graph.exportToDot("/dev/null");
+        double exportSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+        totals.push_back(stats.fetchSeconds);
+        std::cout << "  #" << r + 1 << ": " << stats.moviesProcessed << " películas, "
+                  << stats.requests << " solicitudes en " << stats.fetchSeconds << " s ("
+                  << stats.requests / std::max(stats.fetchSeconds, 1e-9) << " req/s, "
+                  << stats.moviesProcessed / std::max(stats.fetchSeconds, 1e-9) << " películas/s); "
+                  << "construcción del grafo " << stats.buildSeconds * 1000 << " ms; "
+                  << graph.numActors() << " actores, " << graph.numCollaborations() << " aristas; "
+                  << "exportación DOT " << exportSeconds * 1000 << " ms" << (exported ? "" : " (falló)") << "\n";
+    }
+
+    std::sort(totals.begin(), totals.end());
+    std::cout << "Mediana del recorrido: " << totals[totals.size() / 2] << " s\n";
+    return 0;
+}
@@ -0,0 +1,149 @@
+// Benchmark de exportación del grafo: exportador DOT anterior (std::ofstream con << por token y
+// find/replace por título) frente a OutputBuffer en DOT, GraphML y lista binaria. Como
+// referencia de E/S mide un fwrite del mismo número de bytes. Verifica además que dos
+// exportaciones DOT son idénticas y que la lista binaria se vuelve a leer igual.
+// Uso: bench-export [--movies N] [--cast N] [--actors N] [--out DIR] [--keep]
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cstdio>
+#include "Graph.h"
+#include "GraphBuilder.h"
+#include "GraphExport.h"
+
+static double seconds(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+static size_t fileSize(const std::string& path) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    return in ? static_cast<size_t>(in.tellg()) : 0;
+}
+
+static std::string readFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+// Exportador DOT anterior (congelado), tal como estaba en Graph::writeDot
+static bool legacyExportDot(const Graph& g, const std::string& filename) {
+    std::ofstream out(filename);
+    if (!out.is_open()) return false;
+    auto escape = [](std::string_view title) {
+        std::string safeTitle(title);
+        size_t pos = 0;
+        while ((pos = safeTitle.find("\"", pos)) != std::string::npos) {
+            safeTitle.replace(pos, 1, "\\\"");
+            pos += 2;
+        }
+        return safeTitle;
+    };
+    out << "graph Collaborations {\n";
+    out << "  node [shape=ellipse, style=filled, color=lightblue];\n";
+    for (uint32_t u = 0; u < g.numActors(); ++u) {
+        out << "  \"" << g.actorId(u) << "\" [label=\"" << g.actorName(u) << "\"]" << ";\n";
+    }
+    for (uint32_t e = 0; e < g.numCollaborations(); ++e) {
+        out << "  \"" << g.actorId(g.edgeSource(e)) << "\" -- \"" << g.actorId(g.edgeTarget(e))
+            << "\" [label=\"" << escape(g.edgeTitle(e)) << "\"];\n";
+    }
+    out << "}\n";
+    return true;
+}
+
+// Límite de E/S: escribir `bytes` desde memoria con fwrite en bloques de 4 MiB
+static bool rawWrite(const std::string& filename, size_t bytes) {
+    std::FILE* f = std::fopen(filename.c_str(), "wb");
+    if (!f) return false;
+    std::vector<char> block(size_t(4) << 20, 'x');
+    for (size_t done = 0; done < bytes; done += block.size()) {
+        std::fwrite(block.data(), 1, std::min(block.size(), bytes - done), f);
+    }
+    return std::fclose(f) == 0;
+}
+
+int main(int argc, char* argv[]) {
+    int movies = 6000, castSize = 40, actorsPool = 200000;
+    std::string dir = ".";
+    bool keep = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--keep") { keep = true; continue; }
+        if (i + 1 >= argc) break;
+        std::string val = argv[++i];
+        if (arg == "--movies") movies = std::stoi(val);
+        else if (arg == "--cast") castSize = std::stoi(val);
+        else if (arg == "--actors") actorsPool = std::stoi(val);
+        else if (arg == "--out") dir = val;
+    }
+
+    // Grafo sintético; uno de cada diez títulos lleva comillas y barras para ejercitar el escape
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int> actorDist(0, actorsPool - 1), yearDist(1980, 2023);
+    Graph graph;
+    GraphBuilder builder;
+    GraphBuilder::Buffer& buffer = builder.createBuffer();
+    for (int m = 0; m < movies; ++m) {
+        std::string title = m % 10 == 0 ? "Movie \"" + std::to_string(m) + "\" \\ Part II" : "Movie " + std::to_string(m);
+        std::vector<int> cast;
+        for (int c = 0; c < castSize; ++c) {
+            int id = 1000000 + actorDist(rng);
+            buffer.addActor(id, "Actor " + std::to_string(id));
+            cast.push_back(id);
+        }
+        buffer.addCast(cast, m, title, yearDist(rng));
+    }
+    builder.buildInto(graph);
+    std::cout << graph.numActors() << " actores, " << graph.numCollaborations() << " colaboraciones\n";
+    std::cout << std::fixed << std::setprecision(2);
+
+    struct Result {
+        std::string name, path;
+        double secs;
+    };
+    std::vector<Result> results;
+    auto run = [&](const std::string& name, const std::string& file, auto&& fn) {
+        std::string path = dir + "/" + file;
+        auto t0 = std::chrono::steady_clock::now();
+        bool ok = fn(path);
+        results.push_back({name, path, seconds(t0)});
+        if (!ok) std::cerr << "Error escribiendo " << path << "\n";
+    };
+
+    run("DOT anterior (ofstream)", "bench_legacy.dot", [&](const std::string& p) { return legacyExportDot(graph, p); });
+    run("DOT (OutputBuffer)", "bench.dot", [&](const std::string& p) { return graph.exportToDot(p); });
+    run("GraphML", "bench.graphml", [&](const std::string& p) { return exportGraphML(graph, p); });
+    run("Lista binaria", "bench.edges", [&](const std::string& p) { return exportEdgeList(graph, p); });
+    size_t dotBytes = fileSize(dir + "/bench.dot");
+    run("fwrite de referencia", "bench_raw.bin", [&](const std::string& p) { return rawWrite(p, dotBytes); });
+
+    for (const Result& r : results) {
+        double mb = fileSize(r.path) / 1048576.0;
+        std::cout << std::left << std::setw(26) << r.name << std::right << std::setw(9) << mb << " MiB  "
+                  << std::setw(7) << r.secs * 1000 << " ms  " << std::setw(8) << mb / r.secs << " MiB/s\n";
+    }
+
+    // Determinismo y lectura de la lista binaria
+    std::string again = dir + "/bench_again.dot";
+    graph.exportToDot(again);
+    bool identical = readFile(again) == readFile(dir + "/bench.dot");
+    EdgeList list;
+    bool roundTrip = readEdgeList(dir + "/bench.edges", list) && list.ids.size() == graph.numActors() &&
+                     list.source.size() == graph.numCollaborations();
+    for (uint32_t e = 0; roundTrip && e < graph.numCollaborations(); ++e) {
+        roundTrip = list.source[e] == graph.edgeSource(e) && list.target[e] == graph.edgeTarget(e) &&
+                    list.weight[e] == graph.edgeWeight(e) && list.year[e] == graph.edgeYear(e);
+    }
+    std::cout << "DOT repetido " << (identical ? "idéntico" : "DIFERENTE") << ", lista binaria "
+              << (roundTrip ? "leída sin diferencias" : "CON DIFERENCIAS") << "\n";
+
+    if (!keep) {
+        for (const Result& r : results) std::remove(r.path.c_str());
+        std::remove(again.c_str());
+    }
+    return identical && roundTrip ? 0 : 1;
+}
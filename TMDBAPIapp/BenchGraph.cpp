@@ -0,0 +1,175 @@
+// Benchmark de la representación del grafo: memoria por arista y velocidad de recorrido (BFS)
+// del grafo mutable (mapas hash + std::map) frente al grafo congelado (CSR con títulos internados).
+// Uso: bench-graph [--movies N] [--cast N] [--actors N] [--seed N]
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <malloc.h>
+#include "Graph.h"
+
+// Contabilidad del heap (glibc): tamaño real de cada bloque vía malloc_usable_size
+static std::atomic<size_t> g_current{0};
+
+void* operator new(std::size_t size) {
+    void* p = std::malloc(size);
+    if (!p) throw std::bad_alloc();
+    g_current += malloc_usable_size(p);
+    return p;
+}
+
+// Fuera de línea: si GCC la inserta donde ve el operator new, avisa de un free "desparejado"
+// (-Wmismatched-new-delete) sin saber que ambos están reemplazados sobre malloc
+__attribute__((noinline)) void operator delete(void* p) noexcept {
+    if (!p) return;
+    g_current -= malloc_usable_size(p);
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept { operator delete(p); }
+
+// Los contenedores std::pmr del grafo mutable asignan con la versión alineada
+void* operator new(std::size_t size, std::align_val_t align) {
+    size_t a = static_cast<size_t>(align);
+    void* p = std::aligned_alloc(a, (size + a - 1) / a * a);
+    if (!p) throw std::bad_alloc();
+    g_current += malloc_usable_size(p);
+    return p;
+}
+
+void operator delete(void* p, std::align_val_t) noexcept { operator delete(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { operator delete(p); }
+
+static double seconds(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+// BFS completo desde varios orígenes usando la API común (ids TMDB)
+static size_t bfsById(const Graph& g, const std::vector<int>& sources) {
+    size_t visitedTotal = 0;
+    for (int s : sources) {
+        std::unordered_set<int> seen{s};
+        std::vector<int> frontier{s}, next;
+        while (!frontier.empty()) {
+            next.clear();
+            for (int u : frontier) {
+                g.forEachNeighbor(u, [&](int v) {
+                    if (seen.insert(v).second) next.push_back(v);
+                });
+            }
+            frontier.swap(next);
+        }
+        visitedTotal += seen.size();
+    }
+    return visitedTotal;
+}
+
+// BFS sobre los índices densos del CSR
+static size_t bfsCsr(const Graph& g, const std::vector<int>& sources) {
+    size_t visitedTotal = 0;
+    std::vector<uint32_t> mark(g.numActors(), UINT32_MAX);
+    uint32_t round = 0;
+    for (int id : sources) {
+        uint32_t s = g.indexOf(id);
+        std::vector<uint32_t> frontier{s}, next;
+        mark[s] = round;
+        size_t seen = 1;
+        while (!frontier.empty()) {
+            next.clear();
+            for (uint32_t u : frontier) {
+                for (uint32_t v : g.neighbors(u)) {
+                    if (mark[v] != round) { mark[v] = round; next.push_back(v); ++seen; }
+                }
+            }
+            frontier.swap(next);
+        }
+        visitedTotal += seen;
+        ++round;
+    }
+    return visitedTotal;
+}
+
+int main(int argc, char* argv[]) {
+    int movies = 20000, castSize = 15, actorsPool = 50000;
+    unsigned seed = 42;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        int val = std::stoi(argv[i + 1]);
+        if (arg == "--movies") movies = val;
+        else if (arg == "--cast") castSize = val;
+        else if (arg == "--actors") actorsPool = val;
+        else if (arg == "--seed") seed = static_cast<unsigned>(val);
+    }
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::uniform_int_distribution<int> yearDist(1960, 2023);
+
+    size_t base = g_current.load();
+    Graph graph;
+    auto t0 = std::chrono::steady_clock::now();
+    std::vector<int> cast;
+    for (int m = 0; m < movies; ++m) {
+        std::string title = "Synthetic Movie Title Number " + std::to_string(m);
+        int year = yearDist(rng);
+        cast.clear();
+        while (static_cast<int>(cast.size()) < castSize) {
+            double u = unit(rng);
+            int id = 1000000 + static_cast<int>(u * u * actorsPool);
+            bool dup = false;
+            for (int c : cast) dup = dup || c == id;
+            if (dup) continue;
+            cast.push_back(id);
+            graph.addActor(id, "Actor " + std::to_string(id));
+        }
+        for (size_t i = 0; i < cast.size(); ++i)
+            for (size_t j = i + 1; j < cast.size(); ++j)
+                graph.addCollaboration(cast[i], cast[j], m, title, year);
+    }
+    double buildSecs = seconds(t0);
+    size_t mutableBytes = g_current.load() - base;
+    size_t n = graph.numActors(), m = graph.numCollaborations();
+
+    std::vector<int> sources;
+    for (int k = 0; k < 5; ++k) sources.push_back(1000000 + static_cast<int>(unit(rng) * unit(rng) * actorsPool));
+    // Asegurar que los orígenes existen
+    for (int& s : sources) {
+        bool exists = false;
+        graph.forEachNeighbor(s, [&](int) { exists = true; });
+        if (!exists) s = cast.front();
+    }
+
+    t0 = std::chrono::steady_clock::now();
+    size_t visitedMutable = bfsById(graph, sources);
+    double bfsMutable = seconds(t0);
+
+    t0 = std::chrono::steady_clock::now();
+    graph.freeze();
+    double freezeSecs = seconds(t0);
+    size_t frozenBytes = g_current.load() - base;
+
+    t0 = std::chrono::steady_clock::now();
+    size_t visitedFrozenApi = bfsById(graph, sources);
+    double bfsFrozenApi = seconds(t0);
+
+    t0 = std::chrono::steady_clock::now();
+    size_t visitedCsr = bfsCsr(graph, sources);
+    double bfsFrozenCsr = seconds(t0);
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Grafo sintético: " << n << " actores, " << m << " aristas, " << graph.numTitles() << " títulos\n";
+    std::cout << "Construcción: " << buildSecs * 1000 << " ms, freeze(): " << freezeSecs * 1000 << " ms\n";
+    std::cout << "Memoria mutable:   " << mutableBytes / 1048576.0 << " MiB ("
+              << static_cast<double>(mutableBytes) / m << " B/arista)\n";
+    std::cout << "Memoria congelada: " << frozenBytes / 1048576.0 << " MiB ("
+              << static_cast<double>(frozenBytes) / m << " B/arista)\n";
+    std::cout << "BFS x" << sources.size() << " mutable:            " << bfsMutable * 1000 << " ms (" << visitedMutable << " visitas)\n";
+    std::cout << "BFS x" << sources.size() << " congelado (ids):    " << bfsFrozenApi * 1000 << " ms (" << visitedFrozenApi << " visitas)\n";
+    std::cout << "BFS x" << sources.size() << " congelado (CSR):    " << bfsFrozenCsr * 1000 << " ms (" << visitedCsr << " visitas)\n";
+    return 0;
+}
@@ -0,0 +1,154 @@
+// Benchmark de parseo de créditos: DOM de nlohmann (implementación anterior) vs. extracción SAX.
+// Mide throughput (MB/s) y memoria pico del heap durante el parseo para elencos grandes.
+// Uso: bench-parse [--cast N] [--crew N] [--repeat N]
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <sstream>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <malloc.h>
+#include <nlohmann/json.hpp>
+#include "CreditsParser.h"
+
+using json = nlohmann::json;
+
+// Contabilidad del heap (glibc): tamaño real de cada bloque vía malloc_usable_size
+static std::atomic<size_t> g_current{0};
+static std::atomic<size_t> g_peak{0};
+
+void* operator new(std::size_t size) {
+    void* p = std::malloc(size);
+    if (!p) throw std::bad_alloc();
+    size_t cur = g_current += malloc_usable_size(p);
+    size_t peak = g_peak.load();
+    while (cur > peak && !g_peak.compare_exchange_weak(peak, cur)) {}
+    return p;
+}
+
+void operator delete(void* p) noexcept {
+    if (!p) return;
+    g_current -= malloc_usable_size(p);
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept { operator delete(p); }
+
+// Implementación DOM original (referencia)
+static std::vector<ActorData> domMovieCast(const std::string& body, int limit, const std::vector<int>& excludeIds) {
+    std::vector<ActorData> cast;
+    json j = json::parse(body);
+    for (const auto& member : j["cast"]) {
+        if (member["order"] >= limit) continue;
+        int id = member["id"];
+        if (std::find(excludeIds.begin(), excludeIds.end(), id) != excludeIds.end()) continue;
+        cast.push_back(ActorData{id, member["name"]});
+    }
+    return cast;
+}
+
+static std::vector<MovieData> domMovieCredits(const std::string& body, int startYear, int endYear) {
+    std::vector<MovieData> movies;
+    json j = json::parse(body);
+    for (const auto& item : j["cast"]) {
+        if (!item.contains("release_date") || !item["release_date"].is_string()) continue;
+        std::string release_date = item["release_date"];
+        if (release_date.length() < 4) continue;
+        int year = std::stoi(release_date.substr(0, 4));
+        if (year >= startYear && year <= endYear) {
+            movies.push_back(MovieData{item["id"].get<int>(), year, item["title"].get<std::string>(), release_date});
+        }
+    }
+    return movies;
+}
+
+// Payload sintético con la forma de /movie/{id}/credits
+static std::string makeCastPayload(int castSize, int crewSize) {
+    std::ostringstream oss;
+    oss << "{\"id\":603,\"cast\":[";
+    for (int k = 0; k < castSize; ++k) {
+        if (k) oss << ',';
+        oss << "{\"adult\":false,\"gender\":2,\"id\":" << 1000000 + k << ",\"known_for_department\":\"Acting\","
+            << "\"name\":\"Actor Number " << k << "\",\"original_name\":\"Actor Number " << k << "\",\"popularity\":3.25,"
+            << "\"profile_path\":\"/abcdefghijklmnop" << k << ".jpg\",\"cast_id\":" << k << ","
+            << "\"character\":\"A rather long character description " << k << "\","
+            << "\"credit_id\":\"52fe425bc3a36847f80181" << k << "\",\"order\":" << k << "}";
+    }
+    oss << "],\"crew\":[";
+    for (int k = 0; k < crewSize; ++k) {
+        if (k) oss << ',';
+        oss << "{\"adult\":false,\"gender\":1,\"id\":" << 2000000 + k << ",\"known_for_department\":\"Crew\","
+            << "\"name\":\"Crew Member " << k << "\",\"original_name\":\"Crew Member " << k << "\",\"popularity\":0.6,"
+            << "\"profile_path\":null,\"credit_id\":\"52fe425bc3a36847f80199" << k << "\","
+            << "\"department\":\"Production\",\"job\":\"Producer\"}";
+    }
+    oss << "]}";
+    return oss.str();
+}
+
+// Payload sintético con la forma de /person/{id}/movie_credits
+static std::string makeCreditsPayload(int movies) {
+    std::ostringstream oss;
+    oss << "{\"cast\":[";
+    for (int k = 0; k < movies; ++k) {
+        if (k) oss << ',';
+        oss << "{\"adult\":false,\"backdrop_path\":\"/b" << k << ".jpg\",\"genre_ids\":[18,28,53],\"id\":" << 100000 + k
+            << ",\"original_language\":\"en\",\"original_title\":\"Movie " << k << "\","
+            << "\"overview\":\"A long synthetic overview used to mimic the real payload size for movie " << k << ".\","
+            << "\"popularity\":12.5,\"poster_path\":\"/p" << k << ".jpg\",\"release_date\":\""
+            << 1960 + k % 64 << "-05-17\",\"title\":\"Movie " << k << "\",\"video\":false,\"vote_average\":6.8,"
+            << "\"vote_count\":1200,\"character\":\"Lead\",\"credit_id\":\"c" << k << "\",\"order\":0}";
+    }
+    oss << "],\"crew\":[],\"id\":6384}";
+    return oss.str();
+}
+
+// Ejecuta fn `repeat` veces y reporta MB/s y memoria pico adicional
+template <class F>
+static void measure(const char* label, const std::string& body, int repeat, F&& fn) {
+    size_t results = 0;
+    size_t base = g_current.load();
+    g_peak = base;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeat; ++r) results = fn();
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    double mb = body.size() * static_cast<double>(repeat) / (1024.0 * 1024.0);
+    std::cout << "  " << std::left << std::setw(6) << label << std::right
+              << std::setw(10) << mb / secs << " MB/s"
+              << std::setw(12) << (g_peak.load() - base) / 1024.0 << " KiB pico"
+              << std::setw(10) << results << " resultados\n";
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<int> castSizes = {100, 10000, 200000};
+    int crew = -1;
+    int repeat = 5;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        if (arg == "--cast") castSizes = {std::stoi(argv[i + 1])};
+        else if (arg == "--crew") crew = std::stoi(argv[i + 1]);
+        else if (arg == "--repeat") repeat = std::max(1, std::stoi(argv[i + 1]));
+    }
+
+    std::cout << std::fixed << std::setprecision(1);
+    for (int castSize : castSizes) {
+        std::string body = makeCastPayload(castSize, crew < 0 ? castSize / 2 : crew);
+        std::cout << "/movie/{id}/credits: " << castSize << " actores, " << body.size() / 1024.0 << " KiB\n";
+        // Excluye 64 ids para reflejar el costo del filtro lineal frente al hash
+        std::vector<int> excludeVec;
+        for (int k = 0; k < 64; ++k) excludeVec.push_back(1000000 + k * 7);
+        std::unordered_set<int> excludeSet(excludeVec.begin(), excludeVec.end());
+        measure("DOM", body, repeat, [&] { return domMovieCast(body, castSize, excludeVec).size(); });
+        measure("SAX", body, repeat, [&] { return parseMovieCast(body, castSize, excludeSet).size(); });
+    }
+
+    std::string credits = makeCreditsPayload(castSizes.back() / 10 + 1);
+    std::cout << "/person/{id}/movie_credits: " << credits.size() / 1024.0 << " KiB\n";
+    measure("DOM", credits, repeat, [&] { return domMovieCredits(credits, 1985, 2023).size(); });
+    measure("SAX", credits, repeat, [&] { return parseMovieCredits(credits, 1985, 2023).size(); });
+    return 0;
+}
@@ -0,0 +1,342 @@
+#include "Communities.h"
+#include "OutputBuffer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+namespace {
+
+// Grafo ponderado de un nivel de Louvain. Cada fila incluye la entrada (c, c) con el peso
+// interno del nodo agregado, de modo que la suma de la fila es su grado ponderado.
+struct LevelGraph {
+    std::vector<uint64_t> offsets;
+    std::vector<uint32_t> targets;
+    std::vector<double> weights;
+
+    size_t size() const { return offsets.size() - 1; }
+};
+
+// Sub-rondas por pasada: los vecinos que se mueven a la vez son menos y se evitan oscilaciones
+constexpr uint32_t kSubRounds = 4;
+
+uint32_t subRoundOf(uint32_t u) {
+    uint32_t h = u * 2654435761u;
+    return (h >> 16) % kSubRounds;
+}
+
+// Suma en paralelo fn(i) para i en [0, n)
+template <class F>
+double parallelSum(size_t n, unsigned threads, F&& fn) {
+    const size_t chunks = std::max<size_t>(1, std::min<size_t>(n, static_cast<size_t>(threads) * 4));
+    std::vector<double> partial(chunks, 0.0);
+    parallelFor(chunks, threads, [&](size_t c) {
+        double sum = 0;
+        for (size_t i = c * n / chunks; i < (c + 1) * n / chunks; ++i) sum += fn(i);
+        partial[c] = sum;
+    });
+    return std::accumulate(partial.begin(), partial.end(), 0.0);
+}
+
+// Agrupa pares (comunidad, peso) por comunidad sumando los pesos (scratch queda ordenado)
+void accumulateByCommunity(std::vector<std::pair<uint32_t, double>>& scratch) {
+    std::sort(scratch.begin(), scratch.end(), [](const auto& x, const auto& y) { return x.first < y.first; });
+    size_t out = 0;
+    for (size_t i = 0; i < scratch.size(); ++i) {
+        if (out > 0 && scratch[out - 1].first == scratch[i].first) scratch[out - 1].second += scratch[i].second;
+        else scratch[out++] = scratch[i];
+    }
+    scratch.resize(out);
+}
+
+double modularity(const LevelGraph& g, const std::vector<uint32_t>& comm, const std::vector<double>& tot,
+                  double m2, double resolution, unsigned threads) {
+    double internal = parallelSum(g.size(), threads, [&](size_t u) {
+        double in = 0;
+        for (uint64_t i = g.offsets[u]; i < g.offsets[u + 1]; ++i) {
+            if (comm[g.targets[i]] == comm[u]) in += g.weights[i];
+        }
+        return in;
+    });
+    double expected = 0;
+    for (double t : tot) expected += t * t;
+    return internal / m2 - resolution * expected / (m2 * m2);
+}
+
+// Movimiento local de un nivel; devuelve true si algún nodo cambió de comunidad
+bool moveNodes(const LevelGraph& g, std::vector<uint32_t>& comm, const LouvainOptions& opts) {
+    const size_t n = g.size();
+    std::vector<double> k(n);
+    parallelFor(n, opts.threads, [&](size_t u) {
+        double sum = 0;
+        for (uint64_t i = g.offsets[u]; i < g.offsets[u + 1]; ++i) sum += g.weights[i];
+        k[u] = sum;
+    }, 1024);
+    const double m2 = std::accumulate(k.begin(), k.end(), 0.0);
+    if (m2 <= 0) return false;
+
+    std::vector<double> tot(k);
+    std::vector<uint32_t> members(n, 1);
+    std::iota(comm.begin(), comm.end(), 0u);
+    std::vector<uint32_t> target(n);
+    double q = modularity(g, comm, tot, m2, opts.resolution, opts.threads);
+    bool movedAny = false;
+
+    for (int it = 0; it < opts.maxIterations; ++it) {
+        std::vector<uint32_t> before(comm);
+        for (uint32_t round = 0; round < kSubRounds; ++round) {
+            // Cada nodo de la sub-ronda elige su mejor comunidad con el estado de la sub-ronda anterior
+            parallelFor(n, opts.threads, [&](size_t i) {
+                uint32_t u = static_cast<uint32_t>(i);
+                target[u] = comm[u];
+                if (subRoundOf(u) != round) return;
+                thread_local std::vector<std::pair<uint32_t, double>> scratch;
+                scratch.clear();
+                for (uint64_t e = g.offsets[u]; e < g.offsets[u + 1]; ++e) {
+                    if (g.targets[e] != u) scratch.emplace_back(comm[g.targets[e]], g.weights[e]);
+                }
+                accumulateByCommunity(scratch);
+
+                const uint32_t c0 = comm[u];
+                const double ku = k[u];
+                const double scale = opts.resolution * ku / m2;
+                double kin0 = 0;
+                for (const auto& [c, w] : scratch) if (c == c0) kin0 = w;
+                uint32_t best = c0;
+                double bestGain = kin0 - scale * (tot[c0] - ku);
+                for (const auto& [c, w] : scratch) {
+                    if (c == c0) continue;
+                    double gain = w - scale * tot[c];
+                    if (gain > bestGain) {
+                        bestGain = gain;
+                        best = c;
+                    }
+                }
+                // Dos nodos aislados no se intercambian: solo se mueve el de etiqueta mayor
+                if (best != c0 && members[c0] == 1 && members[best] == 1 && best > c0) best = c0;
+                target[u] = best;
+            }, 1024);
+            for (uint32_t u = 0; u < n; ++u) {
+                if (target[u] == comm[u]) continue;
+                tot[comm[u]] -= k[u];
+                --members[comm[u]];
+                tot[target[u]] += k[u];
+                ++members[target[u]];
+                comm[u] = target[u];
+            }
+        }
+
+        double next = modularity(g, comm, tot, m2, opts.resolution, opts.threads);
+        if (next < q) {
+            // La pasada empeoró la partición: se descarta
+            comm.swap(before);
+            break;
+        }
+        bool moved = comm != before;
+        movedAny = movedAny || moved;
+        if (!moved || next - q < opts.tolerance) break;
+        q = next;
+    }
+    return movedAny;
+}
+
+// Renumera las comunidades de comm a [0, count) y devuelve count
+uint32_t compact(std::vector<uint32_t>& comm) {
+    std::vector<uint32_t> label(comm.size(), Graph::npos);
+    uint32_t count = 0;
+    for (uint32_t& c : comm) {
+        if (label[c] == Graph::npos) label[c] = count++;
+        c = label[c];
+    }
+    return count;
+}
+
+// Grafo del siguiente nivel: un nodo por comunidad
+LevelGraph aggregate(const LevelGraph& g, const std::vector<uint32_t>& comm, uint32_t count, unsigned threads) {
+    const size_t n = g.size();
+    std::vector<uint32_t> start(count + 1, 0), order(n);
+    for (uint32_t c : comm) ++start[c + 1];
+    for (uint32_t c = 0; c < count; ++c) start[c + 1] += start[c];
+    std::vector<uint32_t> cursor(start.begin(), start.end() - 1);
+    for (uint32_t u = 0; u < n; ++u) order[cursor[comm[u]]++] = u;
+
+    std::vector<std::vector<std::pair<uint32_t, double>>> rows(count);
+    parallelFor(count, threads, [&](size_t c) {
+        auto& row = rows[c];
+        for (uint32_t i = start[c]; i < start[c + 1]; ++i) {
+            uint32_t u = order[i];
+            for (uint64_t e = g.offsets[u]; e < g.offsets[u + 1]; ++e) row.emplace_back(comm[g.targets[e]], g.weights[e]);
+        }
+        accumulateByCommunity(row);
+    }, 64);
+
+    LevelGraph next;
+    next.offsets.assign(count + 1, 0);
+    for (uint32_t c = 0; c < count; ++c) next.offsets[c + 1] = next.offsets[c] + rows[c].size();
+    next.targets.resize(next.offsets[count]);
+    next.weights.resize(next.offsets[count]);
+    parallelFor(count, threads, [&](size_t c) {
+        uint64_t pos = next.offsets[c];
+        for (const auto& [t, w] : rows[c]) {
+            next.targets[pos] = t;
+            next.weights[pos++] = w;
+        }
+        std::vector<std::pair<uint32_t, double>>().swap(rows[c]);
+    }, 64);
+    return next;
+}
+
+} // namespace
+
+// Louvain multinivel: movimiento local + agregación hasta que ningún nodo cambie de comunidad
+Communities detectCommunities(const Graph& graph, const LouvainOptions& opts) {
+    if (!graph.isFrozen()) throw std::logic_error("detectCommunities: requiere un grafo congelado (Graph::freeze)");
+    const size_t n = graph.numActors();
+    Communities result;
+    result.communityOf.resize(n);
+    std::iota(result.communityOf.begin(), result.communityOf.end(), 0u);
+
+    // Nivel 0: el CSR del grafo con el peso de cada arista
+    LevelGraph base;
+    base.offsets.resize(n + 1, 0);
+    for (uint32_t u = 0; u < n; ++u) base.offsets[u + 1] = base.offsets[u] + graph.neighbors(u).size();
+    base.targets.resize(base.offsets[n]);
+    base.weights.resize(base.offsets[n]);
+    parallelFor(n, opts.threads, [&](size_t u) {
+        auto nbrs = graph.neighbors(static_cast<uint32_t>(u));
+        auto edges = graph.incidentEdges(static_cast<uint32_t>(u));
+        uint64_t pos = base.offsets[u];
+        for (size_t i = 0; i < nbrs.size(); ++i, ++pos) {
+            base.targets[pos] = nbrs[i];
+            base.weights[pos] = opts.weighted ? graph.edgeWeight(edges[i]) : 1.0;
+        }
+    }, 1024);
+
+    LevelGraph level = base;
+    for (int l = 0; l < opts.maxLevels && level.size() > 1; ++l) {
+        std::vector<uint32_t> comm(level.size());
+        if (!moveNodes(level, comm, opts)) break;
+        uint32_t count = compact(comm);
+        ++result.levels;
+        parallelFor(n, opts.threads, [&](size_t u) { result.communityOf[u] = comm[result.communityOf[u]]; }, 4096);
+        if (count == level.size()) break;
+        level = aggregate(level, comm, count, opts.threads);
+    }
+
+    // Numerar de mayor a menor tamaño (empate: la que contiene el nodo de menor índice)
+    uint32_t count = compact(result.communityOf);
+    std::vector<size_t> sizes(count, 0);
+    for (uint32_t c : result.communityOf) ++sizes[c];
+    std::vector<uint32_t> order(count);
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t x, uint32_t y) { return sizes[x] > sizes[y]; });
+    std::vector<uint32_t> rank(count);
+    result.sizes.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        rank[order[i]] = i;
+        result.sizes[i] = sizes[order[i]];
+    }
+    for (uint32_t& c : result.communityOf) c = rank[c];
+
+    std::vector<double> tot(count, 0.0);
+    double m2 = 0;
+    for (uint32_t u = 0; u < n; ++u) {
+        double ku = 0;
+        for (uint64_t e = base.offsets[u]; e < base.offsets[u + 1]; ++e) ku += base.weights[e];
+        tot[result.communityOf[u]] += ku;
+        m2 += ku;
+    }
+    if (m2 > 0) result.modularity = modularity(base, result.communityOf, tot, m2, opts.resolution, opts.threads);
+    return result;
+}
+
+// Agrega el grafo por comunidad
+CommunitySummary summarizeCommunities(const Graph& graph, const Communities& communities, unsigned threads) {
+    if (!graph.isFrozen()) throw std::logic_error("summarizeCommunities: requiere un grafo congelado (Graph::freeze)");
+    const size_t n = graph.numActors();
+    const size_t m = graph.numCollaborations();
+    const size_t count = communities.sizes.size();
+    const auto& comm = communities.communityOf;
+
+    CommunitySummary summary;
+    summary.sizes = communities.sizes;
+    summary.internalWeight.assign(count, 0);
+    summary.representative.assign(count, Graph::npos);
+    std::vector<uint64_t> bestDegree(count, 0);
+    for (uint32_t u = 0; u < n; ++u) {
+        uint64_t degree = 0;
+        for (uint32_t e : graph.incidentEdges(u)) degree += graph.edgeWeight(e);
+        uint32_t c = comm[u];
+        if (summary.representative[c] == Graph::npos || degree > bestDegree[c]) {
+            summary.representative[c] = u;
+            bestDegree[c] = degree;
+        }
+    }
+
+    // Aristas entre comunidades: cada bloque reúne las suyas y luego se ordenan y agrupan
+    struct Link {
+        uint64_t key;   // (a << 32) | b
+        uint32_t weight;
+    };
+    const size_t chunks = std::max<size_t>(1, std::min<size_t>(m, static_cast<size_t>(threads) * 4));
+    std::vector<std::vector<Link>> partial(chunks);
+    std::vector<std::vector<uint64_t>> partialInternal(chunks, std::vector<uint64_t>());
+    parallelFor(chunks, threads, [&](size_t c) {
+        auto& internal = partialInternal[c];
+        for (size_t e = c * m / chunks; e < (c + 1) * m / chunks; ++e) {
+            uint32_t a = comm[graph.edgeSource(static_cast<uint32_t>(e))];
+            uint32_t b = comm[graph.edgeTarget(static_cast<uint32_t>(e))];
+            uint32_t w = graph.edgeWeight(static_cast<uint32_t>(e));
+            if (a == b) {
+                if (internal.empty()) internal.assign(count, 0);
+                internal[a] += w;
+                continue;
+            }
+            if (a > b) std::swap(a, b);
+            partial[c].push_back(Link{(static_cast<uint64_t>(a) << 32) | b, w});
+        }
+    });
+    std::vector<Link> links;
+    for (size_t c = 0; c < chunks; ++c) {
+        links.insert(links.end(), partial[c].begin(), partial[c].end());
+        std::vector<Link>().swap(partial[c]);
+        for (size_t i = 0; i < partialInternal[c].size(); ++i) summary.internalWeight[i] += partialInternal[c][i];
+    }
+    std::sort(links.begin(), links.end(), [](const Link& x, const Link& y) { return x.key < y.key; });
+    for (const Link& l : links) {
+        if (!summary.edges.empty()) {
+            CommunitySummary::Edge& last = summary.edges.back();
+            if (((static_cast<uint64_t>(last.a) << 32) | last.b) == l.key) {
+                last.weight += l.weight;
+                ++last.collaborations;
+                continue;
+            }
+        }
+        summary.edges.push_back({static_cast<uint32_t>(l.key >> 32), static_cast<uint32_t>(l.key), l.weight, 1});
+    }
+    return summary;
+}
+
+// Exporta el grafo resumen a DOT: un nodo por comunidad (actor representativo y tamaño)
+bool exportCommunityDot(const Graph& graph, const CommunitySummary& summary, const std::string& filename, size_t minSize) {
+    OutputBuffer out(filename);
+    if (!out.isOpen()) return false;
+
+    out << "graph Communities {\n";
+    out << "  node [shape=circle, style=filled, colorscheme=set312];\n";
+    for (uint32_t c = 0; c < summary.sizes.size(); ++c) {
+        if (summary.sizes[c] < minSize) continue;
+        double width = 0.5 + 0.15 * std::sqrt(static_cast<double>(summary.sizes[c]));
+        out << "  \"c" << c << "\" [label=\"";
+        out.writeEscaped(graph.actorName(summary.representative[c]), DotEscape{});
+        out << "\\n" << summary.sizes[c] << " actores\", width=" << width << ", fillcolor=" << (c % 12) + 1 << "];\n";
+    }
+    for (const CommunitySummary::Edge& e : summary.edges) {
+        if (summary.sizes[e.a] < minSize || summary.sizes[e.b] < minSize) continue;
+        out << "  \"c" << e.a << "\" -- \"c" << e.b << "\" [label=\"" << e.weight << "\", penwidth="
+            << 1.0 + std::log2(static_cast<double>(e.weight)) << "];\n";
+    }
+    out << "}\n";
+    return out.close();
+}
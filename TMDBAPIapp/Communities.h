@@ -0,0 +1,55 @@
+// Communities.h
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "Graph.h"
+#include "Parallel.h"
+
+// Detección de comunidades (Louvain paralelo) sobre el grafo congelado, ponderado por el
+// número de películas compartidas (Graph::edgeWeight). Lanza std::logic_error si el grafo
+// no está congelado. Los vectores por nodo se indexan con el índice denso de Graph.
+
+// Opciones de Louvain
+struct LouvainOptions {
+    unsigned threads = defaultThreadCount();
+    bool weighted = true;        // false = todas las aristas pesan 1
+    double resolution = 1.0;     // > 1 favorece comunidades más pequeñas
+    int maxLevels = 10;          // niveles de agregación
+    int maxIterations = 20;      // pasadas de movimiento local por nivel
+    double tolerance = 1e-6;     // mejora mínima de modularidad para seguir iterando
+};
+
+// Partición resultante (comunidades numeradas de mayor a menor tamaño)
+struct Communities {
+    std::vector<uint32_t> communityOf;  // índice de nodo -> comunidad
+    std::vector<size_t> sizes;          // actores por comunidad
+    double modularity = 0;
+    int levels = 0;                     // niveles de agregación realizados
+};
+
+// Grafo resumen a nivel de comunidad
+struct CommunitySummary {
+    struct Edge {
+        uint32_t a, b;               // comunidades (a < b)
+        uint64_t weight;             // películas compartidas entre ambas comunidades
+        uint32_t collaborations;     // pares de actores conectados
+    };
+    std::vector<size_t> sizes;              // actores por comunidad
+    std::vector<uint32_t> representative;   // actor de mayor grado ponderado de cada comunidad
+    std::vector<uint64_t> internalWeight;   // películas compartidas dentro de la comunidad
+    std::vector<Edge> edges;                // ordenadas por (a, b)
+};
+
+// Louvain paralelo: cada pasada de movimiento local se hace en sub-rondas síncronas, por lo
+// que el resultado no depende del número de hilos.
+Communities detectCommunities(const Graph& graph, const LouvainOptions& opts = {});
+
+// Agrega el grafo por comunidad
+CommunitySummary summarizeCommunities(const Graph& graph, const Communities& communities,
+                                      unsigned threads = defaultThreadCount());
+
+// Exporta el grafo resumen a DOT (omite comunidades con menos de minSize actores)
+bool exportCommunityDot(const Graph& graph, const CommunitySummary& summary, const std::string& filename,
+                        size_t minSize = 1);
@@ -0,0 +1,119 @@
+#include "Crawler.h"
+#include "TMDBAPIUtils.h"
+#include "GraphBuilder.h"
+
+#include <vector>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <semaphore>       // C++20: std::counting_semaphore
+#include <stdexcept>
+
+// Recorre la filmografía del actor principal y construye el grafo de colaboraciones
+CrawlStats crawlCollaborations(const CrawlConfig& cfg, Graph& graph, CrawlMetadata* meta) {
+    using clock = std::chrono::steady_clock;
+    if (cfg.maxConcurrentCalls <= 0) {
+        throw std::invalid_argument("crawlCollaborations: maxConcurrentCalls debe ser positivo");
+    }
+    CrawlStats stats;
+    auto start = clock::now();
+
+    // Cada hilo escribe en su propio búfer; el grafo se arma al final en paralelo
+    GraphBuilder builder;
+
+    // Agregar el actor principal al grafo como nodo inicial
+    builder.createBuffer().addActor(cfg.mainActorId, cfg.mainActorName);
+
+    // Obtener la lista de películas del actor principal en el rango dado
+    bool filmographyFetched = false;
+    std::vector<MovieData> filmography =
+        TMDBAPIUtils::getMoviesForActor(cfg.mainActorId, cfg.startYear, cfg.endYear, &filmographyFetched);
+    stats.moviesProcessed = filmography.size();
+
+    // Películas ya recorridas en una ejecución anterior: su elenco ya está en el grafo
+    // (volver a pedirlas contaría dos veces las películas compartidas)
+    if (meta) {
+        const std::vector<int>& done = meta->fetchedMovies;
+        std::erase_if(filmography, [&](const MovieData& movie) {
+            return std::binary_search(done.begin(), done.end(), movie.id);
+        });
+    }
+    stats.moviesSkipped = stats.moviesProcessed - filmography.size();
+    stats.requests = 1 + filmography.size();
+    std::vector<char> fetched(filmography.size(), 0); // elenco recibido, por película
+
+    // Semáforo para limitar las llamadas simultáneas a la API
+    std::counting_semaphore<> apiSemaphore(cfg.maxConcurrentCalls);
+    std::atomic<size_t> castMembers{0};
+
+    // Recorrer cada película de la filmografía y lanzar un hilo para obtener su elenco
+    std::vector<std::thread> threads;
+    threads.reserve(filmography.size());
+    for (size_t i = 0; i < filmography.size(); ++i) {
+        const MovieData& movie = filmography[i];
+        // Adquirir semáforo antes de lanzar un nuevo hilo (limita las llamadas concurrentes)
+        apiSemaphore.acquire();
+        // Copiar datos necesarios para el hilo (para evitar capturas por referencia inválidas)
+        int movieId = movie.id;
+        std::string movieTitle = movie.title;
+        int movieYear = movie.year;
+        GraphBuilder::Buffer* buffer = &builder.createBuffer();
+
+        threads.emplace_back([&, i, movieId, movieTitle, movieYear, buffer]() {
+            // Obtener el reparto de la película usando TMDBAPIUtils
+            std::vector<ActorData> cast = TMDBAPIUtils::getMovieCast(movieId, cfg.castLimit);
+            castMembers += cast.size();
+            fetched[i] = !cast.empty(); // un elenco vacío (o un error) se reintenta la próxima vez
+
+            // Registrar actores y colaboraciones en el búfer propio (sin locks)
+            std::vector<int> ids;
+            ids.reserve(cast.size());
+            for (const ActorData& actor : cast) {
+                buffer->addActor(actor.id, actor.name);
+                ids.push_back(actor.id);
+            }
+            buffer->addCast(ids, movieId, movieTitle, movieYear);
+
+            // Liberar el semáforo para permitir que otro hilo inicie su llamada a la API
+            apiSemaphore.release();
+        });
+    }
+
+    // Esperar a que todos los threads terminen (join)
+    for (std::thread& t : threads) {
+        if (t.joinable()) {
+            t.join();
+        }
+    }
+
+    // Fusionar los búferes en el grafo (queda congelado). Si no llegó nada nuevo y el grafo
+    // previo ya está congelado con el actor principal, se conserva tal cual (p. ej. mapeado).
+    auto t0 = clock::now();
+    bool anyFetched = std::find(fetched.begin(), fetched.end(), 1) != fetched.end();
+    if (anyFetched || !graph.isFrozen() || graph.indexOf(cfg.mainActorId) == Graph::npos) {
+        builder.buildInto(graph);
+    }
+    stats.buildSeconds = std::chrono::duration<double>(clock::now() - t0).count();
+
+    if (meta) {
+        for (size_t i = 0; i < filmography.size(); ++i) {
+            if (fetched[i]) meta->fetchedMovies.push_back(filmography[i].id);
+        }
+        // Solo si su filmografía llegó: si falló, la próxima ejecución debe volver a pedirla
+        if (filmographyFetched) meta->fetchedActors.push_back(cfg.mainActorId);
+        for (std::vector<int>* ids : {&meta->fetchedMovies, &meta->fetchedActors}) {
+            std::sort(ids->begin(), ids->end());
+            ids->erase(std::unique(ids->begin(), ids->end()), ids->end());
+        }
+        meta->mainActorId = cfg.mainActorId;
+        meta->startYear = cfg.startYear;
+        meta->endYear = cfg.endYear;
+        meta->savedAt = std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    stats.castMembers = castMembers.load();
+    stats.fetchSeconds = std::chrono::duration<double>(clock::now() - start).count();
+    return stats;
+}
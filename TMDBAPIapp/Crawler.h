@@ -0,0 +1,31 @@
+#pragma once
+
+#include <string>
+#include <cstddef>
+#include "Graph.h"
+
+// Parámetros del recorrido de la filmografía del actor principal
+struct CrawlConfig {
+    int mainActorId = 6384;                  // ID de Keanu Reeves en TMDB
+    std::string mainActorName = "Keanu Reeves";
+    int startYear = 1985;
+    int endYear = 2023;
+    int maxConcurrentCalls = 5;              // Llamadas simultáneas a la API
+    int castLimit = 10;                      // Actores por película (según "order")
+};
+
+// Métricas de una ejecución del recorrido
+struct CrawlStats {
+    size_t moviesProcessed = 0;  // Películas de la filmografía
+    size_t moviesSkipped = 0;    // Películas ya presentes en el snapshot (sin solicitar)
+    size_t requests = 0;         // Solicitudes HTTP realizadas
+    size_t castMembers = 0;      // Actores recibidos en total
+    double fetchSeconds = 0;     // Tiempo total de pared del recorrido
+    double buildSeconds = 0;     // Tiempo de fusión de los búferes en el grafo
+};
+
+// Recorre la filmografía del actor principal y construye el grafo de colaboraciones.
+// El contenido previo de graph se conserva; al terminar, graph queda congelado.
+// Con meta (p. ej. cargado junto a un snapshot), solo se solicita el elenco de las películas
+// que no figuran en meta->fetchedMovies, y meta se actualiza con lo recorrido.
+CrawlStats crawlCollaborations(const CrawlConfig& cfg, Graph& graph, CrawlMetadata* meta = nullptr);
@@ -0,0 +1,177 @@
+#include "CreditsParser.h"
+
+#include <nlohmann/json.hpp>
+#include <iostream>
+#include <string>
+// Para simplificar el uso de nlohmann::json
+using json = nlohmann::json;
+
+namespace {
+
+// Base SAX: sigue la profundidad y detecta los objetos del arreglo "cast" de nivel superior.
+// Las clases derivadas reciben beginItem/field*/endItem solo para los escalares directos de cada elemento.
+template <class Derived>
+class CastArraySax : public nlohmann::json_sax<json> {
+public:
+    bool null() override { return true; }
+    bool boolean(bool) override { return true; }
+    bool number_integer(number_integer_t v) override { return number(static_cast<long long>(v)); }
+    bool number_unsigned(number_unsigned_t v) override { return number(static_cast<long long>(v)); }
+    bool number_float(number_float_t v, const string_t&) override { return number(static_cast<long long>(v)); }
+    bool binary(binary_t&) override { return true; }
+
+    bool string(string_t& val) override {
+        if (inItem()) self().fieldString(field_, val);
+        return true;
+    }
+
+    bool start_object(std::size_t) override {
+        ++depth_;
+        if (inCast_ && depth_ == 3) self().beginItem();
+        return true;
+    }
+
+    bool end_object() override {
+        if (inItem()) self().endItem();
+        --depth_;
+        return true;
+    }
+
+    bool start_array(std::size_t) override {
+        ++depth_;
+        if (depth_ == 2 && topKey_ == "cast") inCast_ = true;
+        return true;
+    }
+
+    bool end_array() override {
+        if (inCast_ && depth_ == 2) inCast_ = false;
+        --depth_;
+        return true;
+    }
+
+    bool key(string_t& val) override {
+        if (depth_ == 1) topKey_ = val;
+        else if (inItem()) field_ = val;
+        return true;
+    }
+
+    bool parse_error(std::size_t position, const std::string&, const nlohmann::detail::exception& ex) override {
+        std::cerr << "Error al parsear créditos (byte " << position << "): " << ex.what() << std::endl;
+        return false;
+    }
+
+private:
+    int depth_ = 0;          // Objetos/arreglos abiertos
+    bool inCast_ = false;    // Dentro de {"cast": [...]}
+    std::string topKey_;     // Última clave de nivel superior
+    std::string field_;      // Última clave dentro del elemento actual
+
+    bool inItem() const { return inCast_ && depth_ == 3; }
+    Derived& self() { return static_cast<Derived&>(*this); }
+
+    bool number(long long v) {
+        if (inItem()) self().fieldNumber(field_, v);
+        return true;
+    }
+};
+
+// Elementos de /person/{id}/movie_credits: id, title, release_date
+class MovieCreditsSax : public CastArraySax<MovieCreditsSax> {
+public:
+    MovieCreditsSax(int startYear, int endYear, std::vector<MovieData>& out)
+        : startYear_(startYear), endYear_(endYear), out_(out) {}
+
+    void beginItem() {
+        id_ = 0;
+        hasDate_ = false;
+        title_.clear();
+        date_.clear();
+    }
+
+    void fieldNumber(const std::string& field, long long v) {
+        if (field == "id") id_ = static_cast<int>(v);
+    }
+
+    void fieldString(const std::string& field, std::string& v) {
+        if (field == "title") title_ = std::move(v);
+        else if (field == "release_date") { date_ = std::move(v); hasDate_ = true; }
+    }
+
+    void endItem() {
+        if (!hasDate_ || date_.length() < 4) return;
+        int year = 0;
+        // Extraer el año de la fecha de lanzamiento
+        try {
+            year = std::stoi(date_.substr(0, 4));
+        } catch (const std::exception& e) {
+            std::cerr << "Error parsing year from release_date: '" << date_ << "' - " << e.what() << std::endl;
+            return;
+        }
+        // Filtrar por rango de años
+        if (year >= startYear_ && year <= endYear_) {
+            out_.push_back(MovieData{id_, year, std::move(title_), std::move(date_)});
+        }
+    }
+
+private:
+    int startYear_, endYear_;
+    std::vector<MovieData>& out_;
+    int id_ = 0;
+    bool hasDate_ = false;
+    std::string title_, date_;
+};
+
+// Elementos de /movie/{id}/credits: id, name, order (sin order, el miembro se conserva)
+class MovieCastSax : public CastArraySax<MovieCastSax> {
+public:
+    MovieCastSax(int limit, const std::unordered_set<int>& excludeIds, std::vector<ActorData>& out)
+        : limit_(limit), excludeIds_(excludeIds), out_(out) {}
+
+    void beginItem() {
+        id_ = 0;
+        hasOrder_ = false;
+        name_.clear();
+    }
+
+    void fieldNumber(const std::string& field, long long v) {
+        if (field == "id") id_ = static_cast<int>(v);
+        else if (field == "order") { order_ = v; hasOrder_ = true; }
+    }
+
+    void fieldString(const std::string& field, std::string& v) {
+        if (field == "name") name_ = std::move(v);
+    }
+
+    void endItem() {
+        if (hasOrder_ && order_ >= limit_) return; // Limitar al número especificado
+        if (excludeIds_.count(id_)) return; // Excluir IDs especificados
+        out_.push_back(ActorData{id_, std::move(name_)});
+    }
+
+private:
+    int limit_;
+    const std::unordered_set<int>& excludeIds_;
+    std::vector<ActorData>& out_;
+    int id_ = 0;
+    long long order_ = 0;
+    bool hasOrder_ = false;
+    std::string name_;
+};
+
+} // namespace
+
+// Extrae las películas de /person/{id}/movie_credits cuyo año está en [startYear, endYear]
+std::vector<MovieData> parseMovieCredits(std::string_view body, int startYear, int endYear) {
+    std::vector<MovieData> movies;
+    MovieCreditsSax sax(startYear, endYear, movies);
+    if (!json::sax_parse(body.begin(), body.end(), &sax)) movies.clear();
+    return movies;
+}
+
+// Extrae el elenco de /movie/{id}/credits con order < limit, omitiendo excludeIds
+std::vector<ActorData> parseMovieCast(std::string_view body, int limit, const std::unordered_set<int>& excludeIds) {
+    std::vector<ActorData> cast;
+    MovieCastSax sax(limit, excludeIds, cast);
+    if (!json::sax_parse(body.begin(), body.end(), &sax)) cast.clear();
+    return cast;
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <string_view>
+#include <vector>
+#include <unordered_set>
+#include "TMDBAPIUtils.h"
+
+// Parsers SAX de los payloads de créditos de TMDB: recorren el JSON una sola vez
+// y copian únicamente los campos usados, sin construir el árbol (DOM) completo.
+
+// Extrae las películas de /person/{id}/movie_credits cuyo año está en [startYear, endYear]
+std::vector<MovieData> parseMovieCredits(std::string_view body, int startYear, int endYear);
+
+// Extrae el elenco de /movie/{id}/credits con order < limit (los miembros sin "order" se
+// conservan), omitiendo excludeIds
+std::vector<ActorData> parseMovieCast(std::string_view body, int limit, const std::unordered_set<int>& excludeIds);
@@ -0,0 +1,407 @@
+#include "ForceLayout.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+
+namespace {
+
+// Quadtree de Barnes-Hut guardado en un arreglo; los 4 hijos de una celda son contiguos
+class QuadTree {
+public:
+    struct Cell {
+        float x0, y0, size;        // esquina inferior izquierda y lado
+        float mx = 0, my = 0;      // suma de posiciones (centro de masa = m / mass)
+        float mass = 0;
+        int32_t child = -1;        // primer hijo, o -1 si es hoja
+        int32_t body = -1;         // nodo de la hoja (-1 vacía o con varios nodos coincidentes)
+    };
+
+    void build(const std::vector<float>& x, const std::vector<float>& y) {
+        float minX = *std::min_element(x.begin(), x.end()), maxX = *std::max_element(x.begin(), x.end());
+        float minY = *std::min_element(y.begin(), y.end()), maxY = *std::max_element(y.begin(), y.end());
+        float side = std::max(maxX - minX, maxY - minY) * 1.001f + 1e-3f;
+        cells.clear();
+        cells.reserve(2 * x.size() + 1);
+        cells.push_back(Cell{minX, minY, side});
+        for (uint32_t b = 0; b < x.size(); ++b) insert(b, x[b], y[b]);
+        for (Cell& c : cells) {
+            if (c.mass > 0) {
+                c.mx /= c.mass;
+                c.my /= c.mass;
+            }
+        }
+    }
+
+    // Fuerza de repulsión k²·masa/d sobre el nodo u en (px, py)
+    void repulsion(uint32_t u, float px, float py, float theta2, float k2, float& fx, float& fy) const {
+        int32_t stack[128];
+        int top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            const Cell& c = cells[stack[--top]];
+            if (c.mass == 0 || (c.child < 0 && c.body == static_cast<int32_t>(u))) continue;
+            float dx = px - c.mx, dy = py - c.my;
+            float d2 = dx * dx + dy * dy;
+            if (c.child < 0 || c.size * c.size < theta2 * d2) {
+                if (d2 < 1e-6f) {
+                    // Nodos coincidentes: separarlos en una dirección fija según u
+                    dx = 0.01f * static_cast<float>((u % 7) + 1);
+                    dy = 0.01f * static_cast<float>((u % 5) + 1);
+                    d2 = dx * dx + dy * dy;
+                }
+                float f = k2 * c.mass / d2;
+                fx += dx * f;
+                fy += dy * f;
+            } else {
+                for (int i = 0; i < 4; ++i) stack[top++] = c.child + i;
+            }
+        }
+    }
+
+private:
+    static constexpr int kMaxDepth = 24;
+    std::vector<Cell> cells;
+
+    int32_t quadrant(int32_t c, float x, float y) const {
+        const Cell& cell = cells[c];
+        float half = cell.size / 2;
+        return cell.child + (x >= cell.x0 + half ? 1 : 0) + (y >= cell.y0 + half ? 2 : 0);
+    }
+
+    void insert(uint32_t b, float x, float y) {
+        int32_t c = 0;
+        for (int depth = 0;; ++depth) {
+            cells[c].mass += 1;
+            cells[c].mx += x;
+            cells[c].my += y;
+            if (cells[c].child >= 0) {
+                c = quadrant(c, x, y);
+                continue;
+            }
+            if (cells[c].mass == 1) {
+                cells[c].body = static_cast<int32_t>(b);
+                return;
+            }
+            if (depth >= kMaxDepth) {
+                cells[c].body = -1; // varios nodos casi coincidentes: masa agregada
+                return;
+            }
+            // Hoja ocupada: subdividir y bajar el nodo que estaba
+            int32_t old = cells[c].body;
+            float half = cells[c].size / 2, x0 = cells[c].x0, y0 = cells[c].y0;
+            cells[c].body = -1;
+            cells[c].child = static_cast<int32_t>(cells.size());
+            cells.push_back(Cell{x0, y0, half});
+            cells.push_back(Cell{x0 + half, y0, half});
+            cells.push_back(Cell{x0, y0 + half, half});
+            cells.push_back(Cell{x0 + half, y0 + half, half});
+            float ox = cells[c].mx - x, oy = cells[c].my - y; // posición del nodo anterior
+            Cell& target = cells[quadrant(c, ox, oy)];
+            target.mass = 1;
+            target.mx = ox;
+            target.my = oy;
+            target.body = old;
+            c = quadrant(c, x, y);
+        }
+    }
+};
+
+// Transformación de coordenadas de la disposición al dibujo (lado mayor = size, eje y hacia abajo)
+struct Viewport {
+    float minX = 0, minY = 0, scale = 1, margin = 20;
+    double width = 0, height = 0;
+
+    Viewport(const Layout& layout, double size) {
+        if (layout.x.empty()) {
+            width = height = size;
+            return;
+        }
+        minX = *std::min_element(layout.x.begin(), layout.x.end());
+        minY = *std::min_element(layout.y.begin(), layout.y.end());
+        float spanX = *std::max_element(layout.x.begin(), layout.x.end()) - minX;
+        float spanY = *std::max_element(layout.y.begin(), layout.y.end()) - minY;
+        float span = std::max({spanX, spanY, 1e-3f});
+        scale = static_cast<float>(size - 2 * margin) / span;
+        width = spanX * scale + 2 * margin;
+        height = spanY * scale + 2 * margin;
+    }
+    float px(float x) const { return (x - minX) * scale + margin; }
+    float py(float y) const { return static_cast<float>(height) - ((y - minY) * scale + margin); }
+};
+
+std::string escapeXml(std::string_view text) {
+    std::string out;
+    out.reserve(text.size());
+    for (char c : text) {
+        switch (c) {
+            case '&': out += "&amp;"; break;
+            case '<': out += "&lt;"; break;
+            case '>': out += "&gt;"; break;
+            case '"': out += "&quot;"; break;
+            default: out += c;
+        }
+    }
+    return out;
+}
+
+// Grafo de un nivel de la jerarquía (adyacencia CSR sin pesos)
+struct LevelGraph {
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> targets;
+
+    size_t size() const { return offsets.size() - 1; }
+};
+
+// Agrupa cada nodo con un vecino (emparejamiento y, para los que quedan sueltos, unión al grupo
+// de un vecino, lo que colapsa también las estrellas). Devuelve el grafo grueso y fineToCoarse.
+LevelGraph coarsen(const LevelGraph& g, std::vector<uint32_t>& fineToCoarse, std::mt19937& rng) {
+    const size_t n = g.size();
+    std::vector<uint32_t> order(n);
+    std::iota(order.begin(), order.end(), 0u);
+    std::shuffle(order.begin(), order.end(), rng);
+    fineToCoarse.assign(n, Graph::npos);
+    uint32_t count = 0;
+    for (uint32_t u : order) {
+        if (fineToCoarse[u] != Graph::npos) continue;
+        // Vecino libre de menor grado
+        uint32_t best = Graph::npos;
+        for (uint32_t i = g.offsets[u]; i < g.offsets[u + 1]; ++i) {
+            uint32_t v = g.targets[i];
+            if (v == u || fineToCoarse[v] != Graph::npos) continue;
+            if (best == Graph::npos || g.offsets[v + 1] - g.offsets[v] < g.offsets[best + 1] - g.offsets[best]) best = v;
+        }
+        if (best != Graph::npos) {
+            fineToCoarse[u] = fineToCoarse[best] = count++;
+        } else if (g.offsets[u + 1] > g.offsets[u]) {
+            fineToCoarse[u] = fineToCoarse[g.targets[g.offsets[u]]];
+        } else {
+            fineToCoarse[u] = count++;
+        }
+    }
+    std::vector<std::vector<uint32_t>> rows(count);
+    for (uint32_t u = 0; u < n; ++u) {
+        for (uint32_t i = g.offsets[u]; i < g.offsets[u + 1]; ++i) {
+            uint32_t a = fineToCoarse[u], b = fineToCoarse[g.targets[i]];
+            if (a != b) rows[a].push_back(b);
+        }
+    }
+    LevelGraph coarse;
+    coarse.offsets.assign(count + 1, 0);
+    for (uint32_t c = 0; c < count; ++c) {
+        auto& row = rows[c];
+        std::sort(row.begin(), row.end());
+        row.erase(std::unique(row.begin(), row.end()), row.end());
+        coarse.offsets[c + 1] = coarse.offsets[c] + static_cast<uint32_t>(row.size());
+    }
+    coarse.targets.reserve(coarse.offsets[count]);
+    for (auto& row : rows) coarse.targets.insert(coarse.targets.end(), row.begin(), row.end());
+    return coarse;
+}
+
+// Fruchterman-Reingold sobre un nivel: repulsión k²/d (Barnes-Hut), atracción d²/k por arista,
+// gravedad lineal hacia el centro y desplazamiento limitado por una temperatura decreciente.
+void refine(const LevelGraph& g, Layout& layout, int iterations, float t0, const LayoutOptions& opts) {
+    const size_t n = g.size();
+    if (n < 2) return;
+    const float k = 1.0f, k2 = k * k;
+    const float theta2 = static_cast<float>(opts.theta * opts.theta);
+    const float gravity = static_cast<float>(opts.gravity);
+    std::vector<float> dx(n), dy(n);
+    QuadTree tree;
+
+    for (int it = 0; it < iterations; ++it) {
+        tree.build(layout.x, layout.y);
+        float cx = std::accumulate(layout.x.begin(), layout.x.end(), 0.0f) / n;
+        float cy = std::accumulate(layout.y.begin(), layout.y.end(), 0.0f) / n;
+
+        parallelFor(n, opts.threads, [&](size_t i) {
+            uint32_t u = static_cast<uint32_t>(i);
+            float px = layout.x[u], py = layout.y[u];
+            float fx = 0, fy = 0;
+            tree.repulsion(u, px, py, theta2, k2, fx, fy);
+            for (uint32_t e = g.offsets[u]; e < g.offsets[u + 1]; ++e) {
+                uint32_t v = g.targets[e];
+                float ex = layout.x[v] - px, ey = layout.y[v] - py;
+                float d = std::sqrt(ex * ex + ey * ey);
+                fx += ex * d / k;
+                fy += ey * d / k;
+            }
+            fx += gravity * (cx - px);
+            fy += gravity * (cy - py);
+            dx[u] = fx;
+            dy[u] = fy;
+        }, 256);
+
+        // Enfriamiento lineal: el desplazamiento máximo baja de t0 a casi 0
+        float t = t0 * (1.0f - static_cast<float>(it) / iterations) + 0.01f;
+        parallelFor(n, opts.threads, [&](size_t u) {
+            float len = std::sqrt(dx[u] * dx[u] + dy[u] * dy[u]);
+            if (len <= 0) return;
+            float step = std::min(len, t) / len;
+            layout.x[u] += dx[u] * step;
+            layout.y[u] += dy[u] * step;
+        }, 4096);
+    }
+}
+
+} // namespace
+
+// Disposición multinivel: se engrosa el grafo hasta unos pocos nodos, se dispone el nivel más
+// grueso desde posiciones aleatorias y cada nivel más fino parte de la posición de su grupo.
+Layout computeLayout(const Graph& graph, const LayoutOptions& opts) {
+    if (!graph.isFrozen()) throw std::logic_error("computeLayout: requiere un grafo congelado (Graph::freeze)");
+    const size_t n = graph.numActors();
+    std::mt19937 rng(opts.seed);
+
+    std::vector<LevelGraph> levels(1);
+    levels[0].offsets.resize(n + 1, 0);
+    for (uint32_t u = 0; u < n; ++u) levels[0].offsets[u + 1] = levels[0].offsets[u] + static_cast<uint32_t>(graph.neighbors(u).size());
+    levels[0].targets.reserve(levels[0].offsets[n]);
+    for (uint32_t u = 0; u < n; ++u) {
+        auto nbrs = graph.neighbors(u);
+        levels[0].targets.insert(levels[0].targets.end(), nbrs.begin(), nbrs.end());
+    }
+    std::vector<std::vector<uint32_t>> maps;
+    while (levels.back().size() > 64) {
+        std::vector<uint32_t> map;
+        LevelGraph coarse = coarsen(levels.back(), map, rng);
+        if (coarse.size() > levels.back().size() * 0.9) break; // ya casi no se reduce
+        maps.push_back(std::move(map));
+        levels.push_back(std::move(coarse));
+    }
+
+    // Nivel más grueso: posiciones aleatorias en un cuadrado de área ~n (longitud ideal k = 1)
+    const size_t top = levels.back().size();
+    Layout layout;
+    layout.x.resize(top);
+    layout.y.resize(top);
+    float side = std::sqrt(static_cast<float>(std::max<size_t>(top, 1)));
+    std::uniform_real_distribution<float> coord(0.0f, side);
+    for (size_t u = 0; u < top; ++u) {
+        layout.x[u] = coord(rng);
+        layout.y[u] = coord(rng);
+    }
+    refine(levels.back(), layout, opts.iterations, side / 10, opts);
+
+    // Niveles más finos: heredar la posición del grupo (escalada para conservar densidad) y refinar
+    std::uniform_real_distribution<float> jitter(-0.2f, 0.2f);
+    for (size_t l = maps.size(); l-- > 0;) {
+        const auto& map = maps[l];
+        float grow = std::sqrt(static_cast<float>(map.size()) / levels[l + 1].size());
+        Layout fine;
+        fine.x.resize(map.size());
+        fine.y.resize(map.size());
+        for (size_t u = 0; u < map.size(); ++u) {
+            fine.x[u] = layout.x[map[u]] * grow + jitter(rng);
+            fine.y[u] = layout.y[map[u]] * grow + jitter(rng);
+        }
+        layout = std::move(fine);
+        refine(levels[l], layout, opts.refineIterations, 2.0f, opts);
+    }
+    return layout;
+}
+
+// Escribe el grafo como SVG: aristas en un único <path>, nodos como círculos coloreados
+bool writeSVG(const Graph& graph, const Layout& layout, const std::string& filename, const SvgOptions& opts) {
+    if (!graph.isFrozen()) throw std::logic_error("writeSVG: requiere un grafo congelado (Graph::freeze)");
+    std::ofstream out(filename);
+    if (!out.is_open()) return false;
+    const size_t n = graph.numActors();
+    const size_t m = graph.numCollaborations();
+    Viewport view(layout, opts.size);
+    static const char* palette[] = {"#8dd3c7", "#fdb462", "#bebada", "#fb8072", "#80b1d3", "#b3de69",
+                                    "#fccde5", "#bc80bd", "#ccebc5", "#ffed6f", "#d9d9d9", "#ffffb3"};
+
+    std::string buf;
+    buf.reserve(1 << 20);
+    char num[96];
+    auto flush = [&] {
+        if (buf.size() >= (1 << 20) - 4096) {
+            out.write(buf.data(), static_cast<std::streamsize>(buf.size()));
+            buf.clear();
+        }
+    };
+
+    std::snprintf(num, sizeof(num), "%.0f\" height=\"%.0f\" viewBox=\"0 0 %.0f %.0f\">\n", view.width, view.height,
+                  view.width, view.height);
+    buf += "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"";
+    buf += num;
+    buf += "<rect width=\"100%\" height=\"100%\" fill=\"white\"/>\n";
+
+    // Aristas: más finas y transparentes cuanto más denso es el grafo
+    double opacity = std::clamp(20.0 / std::sqrt(static_cast<double>(std::max<size_t>(m, 1))), 0.05, 0.6);
+    std::snprintf(num, sizeof(num), "<path fill=\"none\" stroke=\"#555\" stroke-opacity=\"%.3f\" stroke-width=\"0.6\" d=\"", opacity);
+    buf += num;
+    for (uint32_t e = 0; e < m; ++e) {
+        uint32_t u = graph.edgeSource(e), v = graph.edgeTarget(e);
+        std::snprintf(num, sizeof(num), "M%.1f %.1fL%.1f %.1f", view.px(layout.x[u]), view.py(layout.y[u]),
+                      view.px(layout.x[v]), view.py(layout.y[v]));
+        buf += num;
+        flush();
+    }
+    buf += "\"/>\n";
+    if (opts.edgeLabels) {
+        buf += "<g font-family=\"sans-serif\" font-size=\"6\" fill=\"#777\" text-anchor=\"middle\">\n";
+        for (uint32_t e = 0; e < m; ++e) {
+            uint32_t u = graph.edgeSource(e), v = graph.edgeTarget(e);
+            std::snprintf(num, sizeof(num), "<text x=\"%.1f\" y=\"%.1f\">", (view.px(layout.x[u]) + view.px(layout.x[v])) / 2,
+                          (view.py(layout.y[u]) + view.py(layout.y[v])) / 2);
+            buf += num;
+            buf += escapeXml(graph.edgeTitle(e));
+            buf += "</text>\n";
+            flush();
+        }
+        buf += "</g>\n";
+    }
+
+    // Nodos: radio según el grado
+    buf += "<g stroke=\"#333\" stroke-width=\"0.3\">\n";
+    for (uint32_t u = 0; u < n; ++u) {
+        size_t group = opts.colorGroup.empty() ? 4 : opts.colorGroup[u];
+        float r = 1.5f + std::sqrt(static_cast<float>(graph.neighbors(u).size())) * 0.5f;
+        std::snprintf(num, sizeof(num), "<circle cx=\"%.1f\" cy=\"%.1f\" r=\"%.1f\" fill=\"%s\"/>\n",
+                      view.px(layout.x[u]), view.py(layout.y[u]), r, palette[group % 12]);
+        buf += num;
+        flush();
+    }
+    buf += "</g>\n";
+
+    // Nombres de los actores de mayor grado
+    std::vector<uint32_t> labeled(n);
+    std::iota(labeled.begin(), labeled.end(), 0u);
+    size_t count = std::min(opts.nodeLabels, n);
+    std::partial_sort(labeled.begin(), labeled.begin() + count, labeled.end(), [&](uint32_t a, uint32_t b) {
+        size_t da = graph.neighbors(a).size(), db = graph.neighbors(b).size();
+        return da != db ? da > db : a < b;
+    });
+    buf += "<g font-family=\"sans-serif\" font-size=\"10\" fill=\"#111\" text-anchor=\"middle\">\n";
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t u = labeled[i];
+        std::snprintf(num, sizeof(num), "<text x=\"%.1f\" y=\"%.1f\">", view.px(layout.x[u]), view.py(layout.y[u]) - 4);
+        buf += num;
+        buf += escapeXml(graph.actorName(u));
+        buf += "</text>\n";
+        flush();
+    }
+    buf += "</g>\n</svg>\n";
+    out.write(buf.data(), static_cast<std::streamsize>(buf.size()));
+    return static_cast<bool>(out);
+}
+
+// Posiciones para Graphviz (neato -n2 usa pos en puntos tal cual)
+Graph::NodeAttributes layoutToDotAttributes(const Layout& layout, double size) {
+    Viewport view(layout, size);
+    Graph::NodeAttributes attrs(layout.x.size());
+    char pos[64];
+    for (size_t u = 0; u < layout.x.size(); ++u) {
+        // En DOT el eje y crece hacia arriba
+        std::snprintf(pos, sizeof(pos), "%.1f,%.1f", view.px(layout.x[u]), view.height - view.py(layout.y[u]));
+        attrs[u].emplace_back("pos", pos);
+    }
+    return attrs;
+}
@@ -0,0 +1,44 @@
+// ForceLayout.h
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "Graph.h"
+#include "Parallel.h"
+
+// Disposición de fuerzas multinivel (Fruchterman-Reingold con repulsión Barnes-Hut) calculada
+// en paralelo sobre el grafo congelado, y exportación directa a SVG sin pasar por Graphviz.
+// Lanza std::logic_error si el grafo no está congelado.
+
+// Opciones de la disposición
+struct LayoutOptions {
+    unsigned threads = defaultThreadCount();
+    int iterations = 300;         // pasadas en el nivel más grueso
+    int refineIterations = 40;    // pasadas en cada nivel más fino
+    double theta = 1.2;       // apertura de Barnes-Hut (mayor = más rápido y menos preciso)
+    double gravity = 0.05;    // atracción hacia el centro (mantiene juntas las componentes)
+    unsigned seed = 42;
+};
+
+// Posición de cada nodo (índice denso), en unidades de la longitud ideal de arista
+struct Layout {
+    std::vector<float> x, y;
+};
+
+// Opciones del SVG
+struct SvgOptions {
+    double size = 2000;                 // lado mayor del dibujo, en px
+    bool edgeLabels = false;            // título de la película en cada arista
+    size_t nodeLabels = 200;            // nombres de los N actores de mayor grado (0 = ninguno)
+    std::vector<uint32_t> colorGroup;   // grupo de color por nodo (p. ej. comunidad); vacío = un color
+};
+
+Layout computeLayout(const Graph& graph, const LayoutOptions& opts = {});
+
+// Escribe el grafo dibujado con la disposición dada
+bool writeSVG(const Graph& graph, const Layout& layout, const std::string& filename, const SvgOptions& opts = {});
+
+// Atributo pos="x,y" (en puntos, misma escala que el SVG de lado `size`) por nodo,
+// para Graph::exportToDot y renderizar con `neato -n2`
+Graph::NodeAttributes layoutToDotAttributes(const Layout& layout, double size = 2000);
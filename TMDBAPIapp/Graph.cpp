@@ -1,65 +1,437 @@
 #include "Graph.h"
+#include "OutputBuffer.h"
+#include "GraphArena.h"
 #include <iostream>
 #include <algorithm>
-#include <fstream>
+#include <stdexcept>
+#include <new>
+#include <type_traits>
+
+// Grafo con los contenedores mutables en resource
+Graph::Graph(std::pmr::memory_resource* resource)
+    : actors(resource), adjacency(resource), edgeLabels(resource), movies(resource) {}
 
 // Agrega un actor (nodo) al grafo
 void Graph::addActor(int id, const std::string& name) {
+    if (frozen) throw std::logic_error("Graph::addActor: el grafo está congelado");
     actors.emplace(id, name);
 }
 
-// Agrega una colaboración (arista) entre dos actores con la película más reciente
-void Graph::addCollaboration(int id1, int id2, const std::string& movieTitle, int movieYear) {
+// Agrega una colaboración (arista) entre dos actores y la película al historial del par
+void Graph::addCollaboration(int id1, int id2, int movieId, const std::string& movieTitle, int movieYear) {
+    if (frozen) throw std::logic_error("Graph::addCollaboration: el grafo está congelado");
     if (id1 == id2) return; // no loops
     int a = std::min(id1, id2);
     int b = std::max(id1, id2);
 
-    // Actualizar arista solo si es nueva o si la película es más reciente
-    auto key = std::make_pair(a, b);
-    auto it = edgeLabels.find(key);
-    if (it == edgeLabels.end() || movieYear > it->second.movieYear) {
-        edgeLabels[key] = {movieTitle, movieYear};
+    // Índice de la película (por id TMDB) en la tabla compartida; título y año quedan como
+    // atributos de su primera aparición
+    auto movie = movies.find(movieId);
+    if (movie == movies.end()) {
+        movie = movies.emplace(std::piecewise_construct, std::forward_as_tuple(movieId),
+                               std::forward_as_tuple(movieId, static_cast<uint32_t>(movies.size()), movieTitle, movieYear)).first;
+    }
+    const MovieInfo& m = movie->second;
+
+    // Actualizar la etiqueta solo si la arista es nueva o si la película es más reciente
+    // (empate de año: gana el título menor, para que el resultado no dependa del orden de llegada)
+    auto [it, inserted] = edgeLabels.try_emplace(std::make_pair(a, b), m.title, m.year);
+    EdgeInfo& info = it->second;
+    if (inserted) {
         adjacency[a].insert(b);
         adjacency[b].insert(a);
+    } else {
+        if (std::find(info.movies.begin(), info.movies.end(), m.index) != info.movies.end()) return; // ya registrada
+        if (m.year > info.movieYear || (m.year == info.movieYear && m.title < info.movieTitle)) {
+            info.movieTitle = m.title;
+            info.movieYear = m.year;
+        }
     }
+    info.movies.push_back(m.index);
 }
 
 // Devuelve el número de actores (nodos) en el grafo
 size_t Graph::numActors() const {
-    return actors.size();
+    return frozen ? csr.ids.size() : actors.size();
 }
 
 // Devuelve el número de colaboraciones (aristas) en el grafo
 size_t Graph::numCollaborations() const {
-    return edgeLabels.size();
+    return frozen ? csr.edgeU.size() : edgeLabels.size();
+}
+
+// Índice denso de un id TMDB (búsqueda binaria sobre ids ordenados)
+uint32_t Graph::indexOf(int id) const {
+    auto it = std::lower_bound(csr.ids.begin(), csr.ids.end(), id);
+    if (it == csr.ids.end() || *it != id) return npos;
+    return static_cast<uint32_t>(it - csr.ids.begin());
+}
+
+// Congela el grafo en la representación CSR compacta
+void Graph::freeze() {
+    if (frozen) return;
+    FrozenData f;
+
+    // 1. Ids densos: incluye actores sin nombre que solo aparecen en aristas
+    f.ids.reserve(actors.size());
+    for (const auto& [id, name] : actors) f.ids.push_back(id);
+    for (const auto& [id, _] : adjacency) {
+        if (!actors.count(id)) f.ids.push_back(id);
+    }
+    std::sort(f.ids.begin(), f.ids.end());
+    auto indexIn = [&](int id) {
+        return static_cast<uint32_t>(std::lower_bound(f.ids.begin(), f.ids.end(), id) - f.ids.begin());
+    };
+
+    const size_t n = f.ids.size();
+    f.nameOffsets.reserve(n + 1);
+    for (int id : f.ids) {
+        f.nameOffsets.push_back(static_cast<uint32_t>(f.namePool.size()));
+        auto it = actors.find(id);
+        if (it != actors.end()) f.namePool += it->second;
+    }
+    f.nameOffsets.push_back(static_cast<uint32_t>(f.namePool.size()));
+
+    // 2. Aristas en orden (u, v) con su historial; películas y títulos se internan en orden
+    //    de primera aparición (así coincide con GraphBuilder::buildInto)
+    const size_t m = edgeLabels.size();
+    f.edgeU.reserve(m);
+    f.edgeV.reserve(m);
+    f.edgeTitle.reserve(m);
+    f.edgeYear.reserve(m);
+    f.edgeWeight.reserve(m);
+    f.historyOffsets.reserve(m + 1);
+    std::vector<const MovieInfo*> byId = moviesById();
+    std::vector<uint32_t> frozenMovie(byId.size(), npos);
+    std::unordered_map<std::string_view, uint32_t> titleIndex;
+    std::vector<uint32_t> history;
+    for (const auto& [pair, info] : edgeLabels) {
+        history.assign(info.movies.begin(), info.movies.end());
+        std::sort(history.begin(), history.end(), [&](uint32_t x, uint32_t y) {
+            if (byId[x]->year != byId[y]->year) return byId[x]->year > byId[y]->year; // más reciente primero
+            if (byId[x]->title != byId[y]->title) return byId[x]->title < byId[y]->title; // empate: título menor
+            return byId[x]->id < byId[y]->id;                                          // y luego id menor
+        });
+        f.historyOffsets.push_back(static_cast<uint32_t>(f.historyMovies.size()));
+        for (uint32_t k : history) {
+            uint32_t& fk = frozenMovie[k];
+            if (fk == npos) {
+                auto [it, inserted] = titleIndex.try_emplace(byId[k]->title, static_cast<uint32_t>(titleIndex.size()));
+                if (inserted) {
+                    f.titleOffsets.push_back(static_cast<uint32_t>(f.titlePool.size()));
+                    f.titlePool += byId[k]->title;
+                }
+                fk = static_cast<uint32_t>(f.movieTitle.size());
+                f.movieId.push_back(byId[k]->id);
+                f.movieTitle.push_back(it->second);
+                f.movieYear.push_back(byId[k]->year);
+            }
+            f.historyMovies.push_back(fk);
+        }
+        uint32_t label = f.historyMovies[f.historyOffsets.back()];
+        f.edgeU.push_back(indexIn(pair.first));
+        f.edgeV.push_back(indexIn(pair.second));
+        f.edgeTitle.push_back(f.movieTitle[label]);
+        f.edgeYear.push_back(f.movieYear[label]);
+        f.edgeWeight.push_back(static_cast<uint32_t>(history.size()));
+    }
+    f.historyOffsets.push_back(static_cast<uint32_t>(f.historyMovies.size()));
+    f.titleOffsets.push_back(static_cast<uint32_t>(f.titlePool.size()));
+
+    // 3. Adyacencia CSR
+    buildAdjacency(f);
+
+    csr.adopt(std::move(f));
+    frozen = true;
+
+    // Liberar la representación mutable
+    releaseMutable();
+}
+
+// Vacía el grafo y lo deja mutable
+void Graph::clear() {
+    releaseMutable();
+    csr = FrozenStore();
+    frozen = false;
+}
+
+// Descarta la representación mutable; los contenedores nuevos usan el mismo recurso.
+// Si ese recurso es una GraphArena, los contenedores viejos no se recorren para destruirlos:
+// sus nodos y cadenas (sin otros recursos) quedan en la arena hasta GraphArena::release().
+void Graph::releaseMutable() {
+    if (dynamic_cast<GraphArena*>(actors.get_allocator().resource())) {
+        auto abandon = [](auto& container) {
+            using Container = std::remove_reference_t<decltype(container)>;
+            auto alloc = container.get_allocator();
+            new (&container) Container(alloc);
+        };
+        abandon(actors);
+        abandon(adjacency);
+        abandon(edgeLabels);
+        abandon(movies);
+        return;
+    }
+    decltype(actors)(actors.get_allocator()).swap(actors);
+    decltype(adjacency)(adjacency.get_allocator()).swap(adjacency);
+    decltype(edgeLabels)(edgeLabels.get_allocator()).swap(edgeLabels);
+    decltype(movies)(movies.get_allocator()).swap(movies);
+}
+
+// Películas del grafo mutable por índice de llegada
+std::vector<const Graph::MovieInfo*> Graph::moviesById() const {
+    std::vector<const MovieInfo*> byId(movies.size());
+    for (const auto& [id, info] : movies) byId[info.index] = &info;
+    return byId;
+}
+
+// Arista entre los índices u y v, o npos
+uint32_t Graph::findEdge(uint32_t u, uint32_t v) const {
+    std::span<const uint32_t> adj = neighbors(u);
+    auto it = std::lower_bound(adj.begin(), adj.end(), v);
+    if (it == adj.end() || *it != v) return npos;
+    return incidentEdges(u)[it - adj.begin()];
+}
+
+// Número de películas compartidas por dos actores; funciona en ambos modos
+uint32_t Graph::collaborationCount(int id1, int id2) const {
+    if (!frozen) {
+        auto it = edgeLabels.find(std::make_pair(std::min(id1, id2), std::max(id1, id2)));
+        return it == edgeLabels.end() ? 0 : static_cast<uint32_t>(it->second.movies.size());
+    }
+    uint32_t u = indexOf(id1), v = indexOf(id2);
+    if (u == npos || v == npos) return 0;
+    uint32_t e = findEdge(u, v);
+    return e == npos ? 0 : csr.edgeWeight[e];
+}
+
+// Subgrafo con las colaboraciones en [fromYear, toYear]
+Graph Graph::yearSlice(int fromYear, int toYear) const {
+    if (!frozen) throw std::logic_error("Graph::yearSlice: requiere un grafo congelado (Graph::freeze)");
+    // Actores, títulos y tabla de películas se conservan tal cual (mismos índices)
+    FrozenData f;
+    f.ids.assign(csr.ids.begin(), csr.ids.end());
+    f.nameOffsets.assign(csr.nameOffsets.begin(), csr.nameOffsets.end());
+    f.namePool.assign(csr.namePool);
+    f.titleOffsets.assign(csr.titleOffsets.begin(), csr.titleOffsets.end());
+    f.titlePool.assign(csr.titlePool);
+    f.movieId.assign(csr.movieId.begin(), csr.movieId.end());
+    f.movieTitle.assign(csr.movieTitle.begin(), csr.movieTitle.end());
+    f.movieYear.assign(csr.movieYear.begin(), csr.movieYear.end());
+
+    // Cada historial ya está ordenado por recencia: la primera película dentro de la
+    // ventana es la nueva etiqueta
+    for (uint32_t e = 0; e < csr.edgeU.size(); ++e) {
+        size_t start = f.historyMovies.size();
+        for (uint32_t k : edgeMovies(e)) {
+            if (csr.movieYear[k] >= fromYear && csr.movieYear[k] <= toYear) f.historyMovies.push_back(k);
+        }
+        if (f.historyMovies.size() == start) continue;
+        uint32_t label = f.historyMovies[start];
+        f.historyOffsets.push_back(static_cast<uint32_t>(start));
+        f.edgeU.push_back(csr.edgeU[e]);
+        f.edgeV.push_back(csr.edgeV[e]);
+        f.edgeTitle.push_back(csr.movieTitle[label]);
+        f.edgeYear.push_back(csr.movieYear[label]);
+        f.edgeWeight.push_back(static_cast<uint32_t>(f.historyMovies.size() - start));
+    }
+    f.historyOffsets.push_back(static_cast<uint32_t>(f.historyMovies.size()));
+    buildAdjacency(f);
+
+    Graph slice;
+    slice.csr.adopt(std::move(f));
+    slice.frozen = true;
+    return slice;
+}
+
+// Copia: un snapshot mapeado se comparte, los datos propios se duplican
+Graph::FrozenStore::FrozenStore(const FrozenStore& other)
+    : FrozenView(other), owned(other.owned), mapping(other.mapping) {
+    if (!mapping) bind();
+}
+
+// Mover un std::string corto no conserva su dirección: siempre se reapunta la vista
+Graph::FrozenStore::FrozenStore(FrozenStore&& other) noexcept
+    : FrozenView(other), owned(std::move(other.owned)), mapping(std::move(other.mapping)) {
+    if (!mapping) bind();
+    static_cast<FrozenView&>(other) = FrozenView{};
+}
+
+// Asignación por copia e intercambio
+Graph::FrozenStore& Graph::FrozenStore::operator=(FrozenStore other) noexcept {
+    static_cast<FrozenView&>(*this) = other;
+    owned = std::move(other.owned);
+    mapping = std::move(other.mapping);
+    if (!mapping) bind();
+    return *this;
+}
+
+// Toma posesión de f y apunta la vista a sus arreglos
+void Graph::FrozenStore::adopt(FrozenData&& f) {
+    owned = std::move(f);
+    mapping.reset();
+    bind();
+}
+
+// Apunta la vista a un archivo mapeado y libera los datos propios
+void Graph::FrozenStore::adopt(const FrozenView& view, std::shared_ptr<const void> file) {
+    owned = FrozenData{};
+    mapping = std::move(file);
+    static_cast<FrozenView&>(*this) = view;
+}
+
+// Apunta la vista a los arreglos propios
+void Graph::FrozenStore::bind() {
+    ids = owned.ids;
+    nameOffsets = owned.nameOffsets;
+    namePool = owned.namePool;
+    offsets = owned.offsets;
+    targets = owned.targets;
+    edgeOf = owned.edgeOf;
+    edgeU = owned.edgeU;
+    edgeV = owned.edgeV;
+    edgeTitle = owned.edgeTitle;
+    edgeYear = owned.edgeYear;
+    edgeWeight = owned.edgeWeight;
+    titleOffsets = owned.titleOffsets;
+    titlePool = owned.titlePool;
+    historyOffsets = owned.historyOffsets;
+    historyMovies = owned.historyMovies;
+    movieId = owned.movieId;
+    movieTitle = owned.movieTitle;
+    movieYear = owned.movieYear;
+}
+
+// Construye offsets/targets/edgeOf a partir de edgeU/edgeV ordenadas por (u, v).
+// Con ese orden, los vecinos de cada nodo quedan ordenados ascendentemente.
+void Graph::buildAdjacency(FrozenData& f) {
+    const size_t n = f.ids.size();
+    const size_t m = f.edgeU.size();
+    f.offsets.assign(n + 1, 0);
+    for (size_t e = 0; e < m; ++e) {
+        ++f.offsets[f.edgeU[e] + 1];
+        ++f.offsets[f.edgeV[e] + 1];
+    }
+    for (size_t u = 0; u < n; ++u) f.offsets[u + 1] += f.offsets[u];
+    f.targets.resize(2 * m);
+    f.edgeOf.resize(2 * m);
+    std::vector<uint32_t> cursor(f.offsets.begin(), f.offsets.end() - 1);
+    // Primero los vecinos menores (el nodo aparece como edgeV) y luego los mayores
+    for (uint32_t e = 0; e < m; ++e) {
+        uint32_t v = f.edgeV[e];
+        f.targets[cursor[v]] = f.edgeU[e];
+        f.edgeOf[cursor[v]++] = e;
+    }
+    for (uint32_t e = 0; e < m; ++e) {
+        uint32_t u = f.edgeU[e];
+        f.targets[cursor[u]] = f.edgeV[e];
+        f.edgeOf[cursor[u]++] = e;
+    }
 }
 
 // Exporta el grafo al formato DOT para visualización con Graphviz
 bool Graph::exportToDot(const std::string& filename) const {
-    std::ofstream out(filename);
-    if (!out.is_open()) return false;
+    return writeDot(filename, nullptr, nullptr);
+}
+
+// Exporta el grafo al formato DOT con atributos adicionales por nodo
+bool Graph::exportToDot(const std::string& filename, const NodeAttributes& attrs) const {
+    if (!frozen) throw std::logic_error("Graph::exportToDot: los atributos por nodo requieren un grafo congelado");
+    return writeDot(filename, &attrs, nullptr);
+}
+
+// Exporta el grafo al formato DOT con un cluster por grupo de nodos
+bool Graph::exportClusteredDot(const std::string& filename, const std::vector<uint32_t>& clusterOf,
+                               const NodeAttributes& attrs) const {
+    if (!frozen) throw std::logic_error("Graph::exportClusteredDot: requiere un grafo congelado");
+    if (clusterOf.size() != csr.ids.size()) throw std::invalid_argument("Graph::exportClusteredDot: clusterOf no cubre todos los nodos");
+    return writeDot(filename, &attrs, &clusterOf);
+}
+
+// Escribe el DOT a través de un búfer grande, con escape en una pasada y orden determinista
+// (nodos por índice/id ascendente, aristas por (u, v))
+bool Graph::writeDot(const std::string& filename, const NodeAttributes* attrs, const std::vector<uint32_t>* clusterOf) const {
+    OutputBuffer out(filename);
+    if (!out.isOpen()) return false;
+
+    auto quoted = [&](std::string_view text) {
+        out << '"';
+        out.writeEscaped(text, DotEscape{});
+        out << '"';
+    };
 
     out << "graph Collaborations {\n";
     out << "  node [shape=ellipse, style=filled, color=lightblue];\n";
 
-    // Nodos
-    for (const auto& [id, name] : actors) {
-        out << "  \"" << id << "\" [label=\"" << name << "\"]" << ";\n";
+    if (frozen) {
+        auto writeNode = [&](uint32_t u, std::string_view indent) {
+            out << indent << '"' << csr.ids[u] << "\" [label=";
+            quoted(actorName(u));
+            if (attrs && u < attrs->size()) {
+                for (const auto& [key, value] : (*attrs)[u]) {
+                    out << ", " << key << '=';
+                    quoted(value);
+                }
+            }
+            out << "];\n";
+        };
+        if (clusterOf) {
+            // Nodos agrupados por cluster (orden de cluster y, dentro, por índice)
+            const size_t n = csr.ids.size();
+            std::vector<uint32_t> order(n);
+            for (uint32_t u = 0; u < n; ++u) order[u] = u;
+            std::stable_sort(order.begin(), order.end(), [&](uint32_t x, uint32_t y) { return (*clusterOf)[x] < (*clusterOf)[y]; });
+            for (size_t i = 0; i < n;) {
+                size_t j = i;
+                while (j < n && (*clusterOf)[order[j]] == (*clusterOf)[order[i]]) ++j;
+                uint32_t c = (*clusterOf)[order[i]];
+                if (j - i == 1) {
+                    writeNode(order[i], "  ");
+                } else {
+                    out << "  subgraph cluster_" << c << " {\n";
+                    out << "    label=\"" << c << "\";\n";
+                    out << "    node [colorscheme=set312, color=" << (c % 12) + 1 << "];\n";
+                    for (size_t k = i; k < j; ++k) writeNode(order[k], "    ");
+                    out << "  }\n";
+                }
+                i = j;
+            }
+        } else {
+            for (uint32_t u = 0; u < csr.ids.size(); ++u) writeNode(u, "  ");
+        }
+        // Aristas: los ids en texto y las etiquetas escapadas se preparan una sola vez
+        // (hay muchas menos películas y actores que aristas)
+        std::vector<std::string> idText(csr.ids.size()), labelText(numTitles());
+        for (uint32_t u = 0; u < csr.ids.size(); ++u) idText[u] = '"' + std::to_string(csr.ids[u]) + '"';
+        for (uint32_t t = 0; t < labelText.size(); ++t) {
+            labelText[t] = " [label=\"";
+            appendEscaped(labelText[t], title(t), DotEscape{});
+            labelText[t] += "\"];\n";
+        }
+        for (uint32_t e = 0; e < csr.edgeU.size(); ++e) {
+            out << "  " << idText[csr.edgeU[e]] << " -- " << idText[csr.edgeV[e]] << labelText[csr.edgeTitle[e]];
+        }
+        out << "}\n";
+        return out.close();
+    }
+
+    // Nodos (ordenados por id)
+    std::vector<std::pair<int, const std::pmr::string*>> nodes;
+    nodes.reserve(actors.size());
+    for (const auto& [id, name] : actors) nodes.emplace_back(id, &name);
+    std::sort(nodes.begin(), nodes.end());
+    for (const auto& [id, name] : nodes) {
+        out << "  \"" << id << "\" [label=";
+        quoted(*name);
+        out << "];\n";
     }
 
-    // Aristas con etiquetas
+    // Aristas con etiquetas (std::map: ya ordenadas por par)
     for (const auto& [pair, info] : edgeLabels) {
-        int a = pair.first;
-        int b = pair.second;
-        std::string safeTitle = info.movieTitle;
-        size_t pos = 0;
-        while ((pos = safeTitle.find("\"", pos)) != std::string::npos) {
-            safeTitle.replace(pos, 1, "\\\"");
-            pos += 2; // avanzar después del carácter escapado
-        }
-        out << "  \"" << a << "\" -- \"" << b << "\" [label=\"" << safeTitle << "\"];\n";
+        out << "  \"" << pair.first << "\" -- \"" << pair.second << "\" [label=";
+        quoted(info.movieTitle);
+        out << "];\n";
     }
 
     out << "}\n";
-    return true;
-}
\ No newline at end of file
+    return out.close();
+}
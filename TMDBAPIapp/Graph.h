@@ -2,18 +2,49 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 #include <map>
+#include <vector>
+#include <span>
 #include <utility>
+#include <memory>
+#include <memory_resource>
+#include <cstdint>
+
+class GraphBuilder;
+
+// Estado del recorrido guardado junto al grafo en un snapshot
+struct CrawlMetadata {
+    int64_t savedAt = 0;                 // Momento del guardado (segundos Unix)
+    int mainActorId = 0;                 // Actor principal y rango de años recorridos
+    int startYear = 0;
+    int endYear = 0;
+    std::vector<int> fetchedMovies;      // Películas cuyo elenco ya está en el grafo (ordenadas)
+    std::vector<int> fetchedActors;      // Actores cuya filmografía ya se recorrió (ordenados)
+};
 
 // Clase para representar un grafo de colaboraciones entre actores
 class Graph {
 public:
+    // Índice denso inexistente
+    static constexpr uint32_t npos = UINT32_MAX;
+    // Atributos DOT adicionales (clave, valor) por índice denso de nodo
+    using NodeAttributes = std::vector<std::vector<std::pair<std::string, std::string>>>;
+
+    Graph() = default;
+    // Grafo cuyos contenedores mutables (actores, conjuntos de vecinos, aristas y sus cadenas)
+    // se asignan en resource, p. ej. una GraphArena; resource debe sobrevivir al grafo
+    explicit Graph(std::pmr::memory_resource* resource);
+
     // Agrega un actor (nodo) al grafo
     void addActor(int id, const std::string& name);
-    // Agrega una colaboración (arista) entre dos actores con la película más reciente
-    void addCollaboration(int id1, int id2, const std::string& movieTitle, int movieYear);
+    // Agrega una colaboración (arista) entre dos actores. La arista guarda el historial de
+    // películas compartidas (cada película, identificada por su id TMDB, una sola vez; título
+    // y año son atributos) y se etiqueta con la más reciente (a igual año, el título
+    // lexicográficamente menor).
+    void addCollaboration(int id1, int id2, int movieId, const std::string& movieTitle, int movieYear);
 
     // Devuelve el número de actores (nodos) en el grafo
     size_t numActors() const;
@@ -22,15 +53,211 @@ public:
 
     // Exporta el grafo al formato DOT para visualización con Graphviz
     bool exportToDot(const std::string& filename) const;
+    // Igual, agregando atributos a cada nodo (requiere grafo congelado)
+    bool exportToDot(const std::string& filename, const NodeAttributes& attrs) const;
+    // Igual, agrupando los nodos en `subgraph cluster_<c>` según clusterOf (índice denso -> grupo);
+    // los grupos de un solo actor quedan fuera de los clusters (requiere grafo congelado)
+    bool exportClusteredDot(const std::string& filename, const std::vector<uint32_t>& clusterOf,
+                            const NodeAttributes& attrs = {}) const;
+
+    // Congela el grafo: remapea ids a índices densos (ordenados por id), interna nombres
+    // y títulos en pools compartidos y organiza la adyacencia en arreglos CSR.
+    // Después de congelar, addActor/addCollaboration lanzan std::logic_error.
+    void freeze();
+    bool isFrozen() const { return frozen; }
+    // Vacía el grafo (en ambos modos) y lo deja mutable. Con una arena monotónica los
+    // contenedores no liberan nada al vaciarse: luego basta GraphArena::release()
+    void clear();
+
+    // --- Snapshots binarios (GraphSnapshot.cpp) ---
+
+    // Guarda el grafo congelado y los metadatos del recorrido en un archivo binario versionado
+    // y con suma de verificación. Escribe en un temporal y lo renombra, así que puede
+    // sobrescribir el snapshot del que proviene un grafo mapeado.
+    bool save(const std::string& filename, const CrawlMetadata& meta = {}) const;
+    // Carga un snapshot en memoria propia (verifica la suma); reemplaza el contenido del grafo.
+    // Devuelve false si el archivo no existe, es de otra versión o está dañado.
+    bool load(const std::string& filename, CrawlMetadata* meta = nullptr);
+    // Igual, pero mapea el archivo en memoria y usa sus arreglos sin copiarlos (solo lectura).
+    // Con verify=false se omite la suma de verificación y el chequeo de índices.
+    bool map(const std::string& filename, CrawlMetadata* meta = nullptr, bool verify = true);
+
+    // Recorre los vecinos (ids TMDB) de un actor; funciona en ambos modos
+    template <class F>
+    void forEachNeighbor(int id, F&& f) const {
+        if (frozen) {
+            uint32_t u = indexOf(id);
+            if (u == npos) return;
+            for (uint32_t v : neighbors(u)) f(csr.ids[v]);
+        } else {
+            auto it = adjacency.find(id);
+            if (it == adjacency.end()) return;
+            for (int v : it->second) f(v);
+        }
+    }
+
+    // --- Acceso CSR (solo con el grafo congelado; índices en [0, numActors())) ---
+
+    // Índice denso de un id TMDB, o npos si no existe
+    uint32_t indexOf(int id) const;
+    int actorId(uint32_t u) const { return csr.ids[u]; }
+    std::string_view actorName(uint32_t u) const {
+        return std::string_view(csr.namePool).substr(csr.nameOffsets[u], csr.nameOffsets[u + 1] - csr.nameOffsets[u]);
+    }
+    // Vecinos de u y, en paralelo, el índice de arista de cada uno
+    std::span<const uint32_t> neighbors(uint32_t u) const {
+        return {csr.targets.data() + csr.offsets[u], csr.offsets[u + 1] - csr.offsets[u]};
+    }
+    std::span<const uint32_t> incidentEdges(uint32_t u) const {
+        return {csr.edgeOf.data() + csr.offsets[u], csr.offsets[u + 1] - csr.offsets[u]};
+    }
+    // Extremos (u < v), título y año de la arista e
+    uint32_t edgeSource(uint32_t e) const { return csr.edgeU[e]; }
+    uint32_t edgeTarget(uint32_t e) const { return csr.edgeV[e]; }
+    std::string_view edgeTitle(uint32_t e) const { return title(csr.edgeTitle[e]); }
+    // Índice del título internado de la arista e, y título por índice (en [0, numTitles()))
+    uint32_t edgeTitleId(uint32_t e) const { return csr.edgeTitle[e]; }
+    std::string_view title(uint32_t t) const {
+        return std::string_view(csr.titlePool).substr(csr.titleOffsets[t], csr.titleOffsets[t + 1] - csr.titleOffsets[t]);
+    }
+    int edgeYear(uint32_t e) const { return csr.edgeYear[e]; }
+    // Número de películas compartidas por el par (peso de la arista)
+    uint32_t edgeWeight(uint32_t e) const { return csr.edgeWeight[e]; }
+    size_t numTitles() const { return csr.titleOffsets.empty() ? 0 : csr.titleOffsets.size() - 1; }
+
+    // Historial: películas (índices en [0, numMovies())) compartidas por la arista e,
+    // de la más reciente a la más antigua (a igual año, por título); la primera es la etiqueta
+    std::span<const uint32_t> edgeMovies(uint32_t e) const {
+        return {csr.historyMovies.data() + csr.historyOffsets[e], csr.historyOffsets[e + 1] - csr.historyOffsets[e]};
+    }
+    // Tabla compartida de películas distintas (id TMDB, título internado y año)
+    size_t numMovies() const { return csr.movieTitle.size(); }
+    int movieId(uint32_t k) const { return csr.movieId[k]; }
+    uint32_t movieTitleId(uint32_t k) const { return csr.movieTitle[k]; }
+    std::string_view movieTitle(uint32_t k) const { return title(csr.movieTitle[k]); }
+    int movieYear(uint32_t k) const { return csr.movieYear[k]; }
+
+    // Arista entre los índices u y v (búsqueda binaria en los vecinos de u), o npos
+    uint32_t findEdge(uint32_t u, uint32_t v) const;
+    // Número de películas compartidas por dos actores (ids TMDB); 0 si no colaboraron
+    uint32_t collaborationCount(int id1, int id2) const;
+    // Subgrafo congelado con las colaboraciones en [fromYear, toYear]: conserva todos los
+    // actores (mismos índices), y cada arista con al menos una película en el rango lleva solo
+    // esas películas (peso y etiqueta recalculados dentro de la ventana)
+    Graph yearSlice(int fromYear, int toYear) const;
 
 private:
-    // Estructura para almacenar información de la arista
+    friend class GraphBuilder;
+
+    // Película del grafo mutable (la clave del mapa es su id TMDB): índice en orden de
+    // llegada, título y año. Admite asignador, como EdgeInfo.
+    struct MovieInfo {
+        using allocator_type = std::pmr::polymorphic_allocator<char>;
+        int id;
+        uint32_t index;
+        std::pmr::string title;
+        int year;
+
+        MovieInfo(int id, uint32_t index, std::string_view title, int year, const allocator_type& alloc = {})
+            : id(id), index(index), title(title, alloc), year(year) {}
+        MovieInfo(const MovieInfo& other, const allocator_type& alloc = {})
+            : id(other.id), index(other.index), title(other.title, alloc), year(other.year) {}
+        MovieInfo(MovieInfo&& other, const allocator_type& alloc)
+            : id(other.id), index(other.index), title(std::move(other.title), alloc), year(other.year) {}
+    };
+
+    // Estructura para almacenar información de la arista: etiqueta (película más reciente) e
+    // historial (índices de película en orden de llegada). Admite asignador para que título e
+    // historial se asignen en el mismo recurso que el nodo del mapa que la contiene.
     struct EdgeInfo {
-        std::string movieTitle;
+        using allocator_type = std::pmr::polymorphic_allocator<char>;
+        std::pmr::string movieTitle;
         int movieYear;
+        std::pmr::vector<uint32_t> movies;
+
+        EdgeInfo(std::string_view title, int year, const allocator_type& alloc = {})
+            : movieTitle(title, alloc), movieYear(year), movies(alloc) {}
+        EdgeInfo(const EdgeInfo& other, const allocator_type& alloc = {})
+            : movieTitle(other.movieTitle, alloc), movieYear(other.movieYear), movies(other.movies, alloc) {}
+        EdgeInfo(EdgeInfo&& other, const allocator_type& alloc)
+            : movieTitle(std::move(other.movieTitle), alloc), movieYear(other.movieYear), movies(std::move(other.movies), alloc) {}
+    };
+
+    // Representación inmutable (CSR) creada por freeze()
+    struct FrozenData {
+        std::vector<int> ids;                 // índice -> id TMDB (ascendente)
+        std::vector<uint32_t> nameOffsets;    // n + 1 desplazamientos en namePool
+        std::string namePool;
+        std::vector<uint32_t> offsets;        // n + 1: inicio de los vecinos de cada nodo
+        std::vector<uint32_t> targets;        // 2m: índices de vecinos (ordenados)
+        std::vector<uint32_t> edgeOf;         // 2m: arista correspondiente a cada vecino
+        std::vector<uint32_t> edgeU, edgeV;   // m: extremos de cada arista (u < v)
+        std::vector<uint32_t> edgeTitle;      // m: índice del título internado
+        std::vector<int> edgeYear;            // m
+        std::vector<uint32_t> edgeWeight;     // m: películas compartidas
+        std::vector<uint32_t> titleOffsets;   // títulos + 1 desplazamientos en titlePool
+        std::string titlePool;
+        std::vector<uint32_t> historyOffsets; // m + 1 desplazamientos en historyMovies
+        std::vector<uint32_t> historyMovies;  // películas de cada arista (más reciente primero)
+        std::vector<int> movieId;             // por película: id TMDB
+        std::vector<uint32_t> movieTitle;     // por película: índice del título internado
+        std::vector<int> movieYear;           // por película: año
+    };
+
+    // Vista de solo lectura de la representación CSR: apunta a un FrozenData propio
+    // o directamente a las secciones de un snapshot mapeado en memoria
+    struct FrozenView {
+        std::span<const int> ids;
+        std::span<const uint32_t> nameOffsets;
+        std::string_view namePool;
+        std::span<const uint32_t> offsets;
+        std::span<const uint32_t> targets;
+        std::span<const uint32_t> edgeOf;
+        std::span<const uint32_t> edgeU, edgeV;
+        std::span<const uint32_t> edgeTitle;
+        std::span<const int> edgeYear;
+        std::span<const uint32_t> edgeWeight;
+        std::span<const uint32_t> titleOffsets;
+        std::string_view titlePool;
+        std::span<const uint32_t> historyOffsets;
+        std::span<const uint32_t> historyMovies;
+        std::span<const int> movieId;
+        std::span<const uint32_t> movieTitle;
+        std::span<const int> movieYear;
     };
 
-    std::unordered_map<int, std::string> actors; // id -> name
-    std::unordered_map<int, std::unordered_set<int>> adjacency; // id -> set of connected actor ids
-    std::map<std::pair<int, int>, EdgeInfo> edgeLabels; // (min(id1,id2), max(id1,id2)) -> movie info
-};
\ No newline at end of file
+    // Almacén de la representación congelada; las copias y movimientos reapuntan la vista
+    struct FrozenStore : FrozenView {
+        FrozenData owned;
+        std::shared_ptr<const void> mapping; // mantiene vivo el archivo mapeado, si lo hay
+
+        FrozenStore() = default;
+        FrozenStore(const FrozenStore& other);
+        FrozenStore(FrozenStore&& other) noexcept;
+        FrozenStore& operator=(FrozenStore other) noexcept;
+
+        // Toma posesión de f y apunta la vista a sus arreglos
+        void adopt(FrozenData&& f);
+        // Apunta la vista a un archivo mapeado (view ya referencia memoria de mapping)
+        void adopt(const FrozenView& view, std::shared_ptr<const void> file);
+        void bind();
+    };
+
+    std::pmr::unordered_map<int, std::pmr::string> actors; // id -> name
+    std::pmr::unordered_map<int, std::pmr::unordered_set<int>> adjacency; // id -> set of connected actor ids
+    std::pmr::map<std::pair<int, int>, EdgeInfo> edgeLabels; // (min(id1,id2), max(id1,id2)) -> movie info
+    std::pmr::unordered_map<int, MovieInfo> movies; // id TMDB de la película -> índice, título y año
+
+    bool frozen = false;
+    FrozenStore csr;
+
+    // Construye la adyacencia CSR a partir de las aristas ordenadas de f
+    static void buildAdjacency(FrozenData& f);
+    // Descarta la representación mutable (conservando su recurso de memoria)
+    void releaseMutable();
+    // Películas del grafo mutable por índice de llegada
+    std::vector<const MovieInfo*> moviesById() const;
+    // Valida un snapshot en memoria y apunta view (y meta) a sus secciones
+    static bool parseSnapshot(const char* base, size_t size, bool verify, FrozenView& view, CrawlMetadata* meta);
+    bool writeDot(const std::string& filename, const NodeAttributes* attrs, const std::vector<uint32_t>* clusterOf) const;
+};
@@ -0,0 +1,435 @@
+#include "GraphAnalytics.h"
+
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+// Para simplificar el uso de nlohmann::json
+using json = nlohmann::json;
+
+namespace {
+
+void requireFrozen(const Graph& graph, const char* what) {
+    if (!graph.isFrozen()) throw std::logic_error(std::string(what) + ": requiere un grafo congelado (Graph::freeze)");
+}
+
+// Índices [0, n) en orden aleatorio; se usan los primeros k como muestra sin reemplazo
+std::vector<uint32_t> sampleNodes(size_t n, size_t k, unsigned seed) {
+    std::vector<uint32_t> nodes(n);
+    std::iota(nodes.begin(), nodes.end(), 0u);
+    std::mt19937 rng(seed);
+    k = std::min(k, n);
+    for (size_t i = 0; i < k; ++i) {
+        std::uniform_int_distribution<size_t> pick(i, n - 1);
+        std::swap(nodes[i], nodes[pick(rng)]);
+    }
+    nodes.resize(k);
+    return nodes;
+}
+
+// Reparte `items` elementos entre `threads` trabajadores. Cada trabajador crea su estado con
+// init(), llama a body(state, i) por cada elemento que toma y finish(state) al terminar.
+template <class Init, class Body, class Finish>
+void forEachWithState(size_t items, unsigned threads, Init&& init, Body&& body, Finish&& finish) {
+    if (items == 0) return;
+    std::atomic<size_t> next{0};
+    unsigned workers = static_cast<unsigned>(std::min<size_t>(std::max(1u, threads), items));
+    parallelFor(workers, workers, [&](size_t) {
+        auto state = init();
+        for (size_t i; (i = next.fetch_add(1)) < items;) body(state, i);
+        finish(state);
+    });
+}
+
+std::string formatNumber(double v) {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%.6g", v);
+    return buf;
+}
+
+std::string csvField(std::string_view s) {
+    if (s.find_first_of(",\"\n\r") == std::string_view::npos) return std::string(s);
+    std::string out = "\"";
+    for (char c : s) {
+        if (c == '"') out += '"';
+        out += c;
+    }
+    return out + "\"";
+}
+
+} // namespace
+
+// Distribución de grados
+DegreeStats degreeDistribution(const Graph& graph) {
+    requireFrozen(graph, "degreeDistribution");
+    DegreeStats stats;
+    const size_t n = graph.numActors();
+    if (n == 0) return stats;
+    stats.minDegree = SIZE_MAX;
+    size_t total = 0;
+    for (uint32_t u = 0; u < n; ++u) {
+        size_t d = graph.neighbors(u).size();
+        if (d >= stats.histogram.size()) stats.histogram.resize(d + 1, 0);
+        ++stats.histogram[d];
+        stats.minDegree = std::min(stats.minDegree, d);
+        stats.maxDegree = std::max(stats.maxDegree, d);
+        total += d;
+    }
+    stats.meanDegree = static_cast<double>(total) / n;
+    return stats;
+}
+
+// Componentes conexas con unión-búsqueda concurrente (enlace por índice menor + compresión por CAS)
+Components connectedComponents(const Graph& graph, unsigned threads) {
+    requireFrozen(graph, "connectedComponents");
+    const size_t n = graph.numActors();
+    const size_t m = graph.numCollaborations();
+    std::vector<std::atomic<uint32_t>> parent(n);
+    parallelFor(n, threads, [&](size_t u) { parent[u].store(static_cast<uint32_t>(u), std::memory_order_relaxed); }, 4096);
+
+    auto find = [&](uint32_t x) {
+        while (true) {
+            uint32_t p = parent[x].load(std::memory_order_relaxed);
+            if (p == x) return x;
+            uint32_t gp = parent[p].load(std::memory_order_relaxed);
+            if (p != gp) parent[x].compare_exchange_weak(p, gp, std::memory_order_relaxed);
+            x = gp;
+        }
+    };
+    parallelFor(m, threads, [&](size_t e) {
+        uint32_t a = graph.edgeSource(static_cast<uint32_t>(e));
+        uint32_t b = graph.edgeTarget(static_cast<uint32_t>(e));
+        while (true) {
+            a = find(a);
+            b = find(b);
+            if (a == b) return;
+            if (a < b) std::swap(a, b);
+            // Enlazar la raíz mayor bajo la menor; si otra hebra la cambió, reintentar
+            uint32_t expected = a;
+            if (parent[a].compare_exchange_strong(expected, b, std::memory_order_relaxed)) return;
+        }
+    }, 4096);
+
+    std::vector<uint32_t> root(n);
+    parallelFor(n, threads, [&](size_t u) { root[u] = find(static_cast<uint32_t>(u)); }, 4096);
+
+    // Numerar componentes de mayor a menor tamaño (empate: raíz menor)
+    std::vector<size_t> rootSize(n, 0);
+    for (uint32_t r : root) ++rootSize[r];
+    std::vector<uint32_t> roots;
+    for (uint32_t u = 0; u < n; ++u) if (root[u] == u) roots.push_back(u);
+    std::sort(roots.begin(), roots.end(), [&](uint32_t x, uint32_t y) {
+        return rootSize[x] != rootSize[y] ? rootSize[x] > rootSize[y] : x < y;
+    });
+    std::vector<uint32_t> label(n, 0);
+    Components comps;
+    comps.sizes.reserve(roots.size());
+    for (uint32_t i = 0; i < roots.size(); ++i) {
+        label[roots[i]] = i;
+        comps.sizes.push_back(rootSize[roots[i]]);
+    }
+    comps.componentOf.resize(n);
+    parallelFor(n, threads, [&](size_t u) { comps.componentOf[u] = label[root[u]]; }, 4096);
+    return comps;
+}
+
+// Colaboradores más frecuentes: selección parcial sobre las aristas incidentes
+std::vector<Collaborator> topCollaborators(const Graph& graph, uint32_t u, size_t k) {
+    requireFrozen(graph, "topCollaborators");
+    std::span<const uint32_t> adj = graph.neighbors(u), edges = graph.incidentEdges(u);
+    std::vector<Collaborator> all(adj.size());
+    for (size_t i = 0; i < adj.size(); ++i) all[i] = {adj[i], graph.edgeWeight(edges[i])};
+    k = std::min(k, all.size());
+    std::partial_sort(all.begin(), all.begin() + k, all.end(), [](const Collaborator& a, const Collaborator& b) {
+        return a.movies != b.movies ? a.movies > b.movies : a.node < b.node;
+    });
+    all.resize(k);
+    return all;
+}
+
+// Camino más corto con BFS bidireccional: expande siempre la frontera más pequeña
+std::vector<int> degreesOfSeparation(const Graph& graph, int fromId, int toId) {
+    requireFrozen(graph, "degreesOfSeparation");
+    uint32_t s = graph.indexOf(fromId), t = graph.indexOf(toId);
+    if (s == Graph::npos || t == Graph::npos) return {};
+    if (s == t) return {fromId};
+
+    const size_t n = graph.numActors();
+    std::vector<uint32_t> parentF(n, Graph::npos), parentB(n, Graph::npos);
+    std::vector<int> distF(n, -1), distB(n, -1);
+    parentF[s] = s; distF[s] = 0;
+    parentB[t] = t; distB[t] = 0;
+    std::vector<uint32_t> frontierF{s}, frontierB{t}, next;
+    uint32_t meet = Graph::npos;
+    int best = INT32_MAX;
+
+    while (!frontierF.empty() && !frontierB.empty() && meet == Graph::npos) {
+        bool forward = frontierF.size() <= frontierB.size();
+        auto& frontier = forward ? frontierF : frontierB;
+        auto& parent = forward ? parentF : parentB;
+        auto& dist = forward ? distF : distB;
+        const auto& otherDist = forward ? distB : distF;
+        next.clear();
+        // Se completa el nivel entero y se elige el encuentro de menor longitud total
+        for (uint32_t u : frontier) {
+            for (uint32_t v : graph.neighbors(u)) {
+                if (parent[v] != Graph::npos) continue;
+                parent[v] = u;
+                dist[v] = dist[u] + 1;
+                next.push_back(v);
+                if (otherDist[v] >= 0 && dist[v] + otherDist[v] < best) {
+                    best = dist[v] + otherDist[v];
+                    meet = v;
+                }
+            }
+        }
+        frontier.swap(next);
+    }
+    if (meet == Graph::npos) return {};
+
+    std::vector<int> path;
+    for (uint32_t v = meet; v != s; v = parentF[v]) path.push_back(graph.actorId(v));
+    path.push_back(fromId);
+    std::reverse(path.begin(), path.end());
+    for (uint32_t v = meet; v != t;) {
+        v = parentB[v];
+        path.push_back(graph.actorId(v));
+    }
+    return path;
+}
+
+// Centralidad de intermediación (Brandes), un BFS por origen repartido entre hilos
+std::vector<double> betweennessCentrality(const Graph& graph, const CentralityOptions& opts) {
+    requireFrozen(graph, "betweennessCentrality");
+    const size_t n = graph.numActors();
+    std::vector<double> bc(n, 0.0);
+    if (n < 3) return bc;
+
+    bool sampled = opts.samples > 0 && opts.samples < n;
+    std::vector<uint32_t> sources = sampled ? sampleNodes(n, opts.samples, opts.seed) : std::vector<uint32_t>();
+    size_t numSources = sampled ? sources.size() : n;
+
+    struct State {
+        std::vector<int> dist;
+        std::vector<double> sigma, delta, local;
+        std::vector<uint32_t> order;
+    };
+    std::mutex mergeMutex;
+    forEachWithState(numSources, opts.threads,
+        [&] {
+            State st;
+            st.dist.assign(n, -1);
+            st.sigma.assign(n, 0.0);
+            st.delta.assign(n, 0.0);
+            st.local.assign(n, 0.0);
+            st.order.reserve(n);
+            return st;
+        },
+        [&](State& st, size_t i) {
+            uint32_t s = sampled ? sources[i] : static_cast<uint32_t>(i);
+            st.order.clear();
+            st.order.push_back(s);
+            st.dist[s] = 0;
+            st.sigma[s] = 1.0;
+            for (size_t head = 0; head < st.order.size(); ++head) {
+                uint32_t u = st.order[head];
+                for (uint32_t v : graph.neighbors(u)) {
+                    if (st.dist[v] < 0) {
+                        st.dist[v] = st.dist[u] + 1;
+                        st.order.push_back(v);
+                    }
+                    if (st.dist[v] == st.dist[u] + 1) st.sigma[v] += st.sigma[u];
+                }
+            }
+            // Acumulación de dependencias en orden inverso de distancia
+            for (size_t k = st.order.size(); k-- > 0;) {
+                uint32_t w = st.order[k];
+                for (uint32_t v : graph.neighbors(w)) {
+                    if (st.dist[v] == st.dist[w] - 1) st.delta[v] += st.sigma[v] / st.sigma[w] * (1.0 + st.delta[w]);
+                }
+                if (w != s) st.local[w] += st.delta[w];
+            }
+            for (uint32_t w : st.order) {
+                st.dist[w] = -1;
+                st.sigma[w] = 0.0;
+                st.delta[w] = 0.0;
+            }
+        },
+        [&](State& st) {
+            // Sumar el acumulado local del trabajador al global
+            std::lock_guard<std::mutex> lock(mergeMutex);
+            for (size_t u = 0; u < n; ++u) bc[u] += st.local[u];
+        });
+
+    // Grafo no dirigido: cada par se cuenta dos veces; escalar la muestra y normalizar
+    double scale = 0.5 * (static_cast<double>(n) / numSources) * 2.0 / ((n - 1.0) * (n - 2.0));
+    for (double& v : bc) v *= scale;
+    return bc;
+}
+
+// Centralidad de cercanía (Wasserman-Faust): ((r-1)/(n-1)) * ((r-1)/suma de distancias)
+std::vector<double> closenessCentrality(const Graph& graph, const Components& components, const CentralityOptions& opts) {
+    requireFrozen(graph, "closenessCentrality");
+    const size_t n = graph.numActors();
+    std::vector<double> closeness(n, 0.0);
+    if (n < 2) return closeness;
+
+    // BFS desde s; llama visit(v, d) por cada nodo alcanzado
+    auto bfs = [&](uint32_t s, std::vector<int>& dist, std::vector<uint32_t>& order, auto&& visit) {
+        order.clear();
+        order.push_back(s);
+        dist[s] = 0;
+        for (size_t head = 0; head < order.size(); ++head) {
+            uint32_t u = order[head];
+            visit(u, dist[u]);
+            for (uint32_t v : graph.neighbors(u)) {
+                if (dist[v] < 0) {
+                    dist[v] = dist[u] + 1;
+                    order.push_back(v);
+                }
+            }
+        }
+        for (uint32_t w : order) dist[w] = -1;
+    };
+    auto finish = [&](double r, double avgDist) {
+        return avgDist > 0 ? ((r - 1.0) / (n - 1.0)) / avgDist : 0.0;
+    };
+
+    // Con muestreo, las componentes mayores que la muestra se estiman desde k pivotes cada una
+    size_t k = opts.samples;
+    std::vector<uint32_t> exactNodes, pivots;
+    std::vector<std::vector<uint32_t>> members(components.sizes.size());
+    for (uint32_t u = 0; u < n; ++u) {
+        uint32_t c = components.componentOf[u];
+        if (k > 0 && components.sizes[c] > k) members[c].push_back(u);
+        else exactNodes.push_back(u);
+    }
+    for (size_t c = 0; c < members.size(); ++c) {
+        if (members[c].empty()) continue;
+        std::mt19937 rng(opts.seed + static_cast<unsigned>(c));
+        std::shuffle(members[c].begin(), members[c].end(), rng);
+        pivots.insert(pivots.end(), members[c].begin(), members[c].begin() + k);
+    }
+
+    struct State {
+        std::vector<int> dist;
+        std::vector<uint32_t> order;
+        std::vector<double> pivotSum;
+    };
+    auto initState = [&] { return State{std::vector<int>(n, -1), {}, {}}; };
+
+    // Exacto: un BFS por nodo
+    forEachWithState(exactNodes.size(), opts.threads, initState,
+        [&](State& st, size_t i) {
+            uint32_t s = exactNodes[i];
+            double sum = 0, reached = 0;
+            bfs(s, st.dist, st.order, [&](uint32_t, int d) { sum += d; reached += 1; });
+            closeness[s] = reached > 1 ? finish(reached, sum / (reached - 1)) : 0.0;
+        },
+        [](State&) {});
+
+    // Estimado: suma de distancias desde los pivotes de su componente (Eppstein-Wang)
+    if (!pivots.empty()) {
+        std::vector<double> pivotSum(n, 0.0);
+        std::mutex mergeMutex;
+        forEachWithState(pivots.size(), opts.threads,
+            [&] {
+                State st = initState();
+                st.pivotSum.assign(n, 0.0);
+                return st;
+            },
+            [&](State& st, size_t i) {
+                bfs(pivots[i], st.dist, st.order, [&](uint32_t v, int d) { st.pivotSum[v] += d; });
+            },
+            [&](State& st) {
+                std::lock_guard<std::mutex> lock(mergeMutex);
+                for (size_t u = 0; u < n; ++u) pivotSum[u] += st.pivotSum[u];
+            });
+        for (size_t c = 0; c < members.size(); ++c) {
+            double r = static_cast<double>(components.sizes[c]);
+            for (uint32_t u : members[c]) {
+                // Promedio sobre k pivotes, corregido porque un pivote puede ser el propio nodo
+                double avg = pivotSum[u] / k * r / (r - 1.0);
+                closeness[u] = finish(r, avg);
+            }
+        }
+    }
+    return closeness;
+}
+
+// Calcula todas las métricas
+GraphMetrics computeMetrics(const Graph& graph, const CentralityOptions& opts) {
+    GraphMetrics metrics;
+    metrics.degrees = degreeDistribution(graph);
+    metrics.components = connectedComponents(graph, opts.threads);
+    metrics.betweenness = betweennessCentrality(graph, opts);
+    metrics.closeness = closenessCentrality(graph, metrics.components, opts);
+    metrics.sampled = opts.samples > 0 && opts.samples < graph.numActors();
+    return metrics;
+}
+
+// Exporta las métricas por actor a CSV
+bool writeMetricsCSV(const Graph& graph, const GraphMetrics& metrics, const std::string& filename) {
+    std::ofstream out(filename);
+    if (!out.is_open()) return false;
+    out << "id,name,degree,component,betweenness,closeness\n";
+    for (uint32_t u = 0; u < graph.numActors(); ++u) {
+        out << graph.actorId(u) << ',' << csvField(graph.actorName(u)) << ',' << graph.neighbors(u).size() << ','
+            << metrics.components.componentOf[u] << ',' << formatNumber(metrics.betweenness[u]) << ','
+            << formatNumber(metrics.closeness[u]) << '\n';
+    }
+    return static_cast<bool>(out);
+}
+
+// Exporta resumen y métricas por actor a JSON
+bool writeMetricsJSON(const Graph& graph, const GraphMetrics& metrics, const std::string& filename) {
+    std::ofstream out(filename);
+    if (!out.is_open()) return false;
+    json j;
+    j["actors"] = graph.numActors();
+    j["collaborations"] = graph.numCollaborations();
+    j["sampled"] = metrics.sampled;
+    j["degree"] = {
+        {"min", metrics.degrees.minDegree},
+        {"max", metrics.degrees.maxDegree},
+        {"mean", metrics.degrees.meanDegree},
+        {"histogram", metrics.degrees.histogram},
+    };
+    j["components"] = {
+        {"count", metrics.components.sizes.size()},
+        {"sizes", metrics.components.sizes},
+    };
+    json nodes = json::array();
+    for (uint32_t u = 0; u < graph.numActors(); ++u) {
+        nodes.push_back({
+            {"id", graph.actorId(u)},
+            {"name", std::string(graph.actorName(u))},
+            {"degree", graph.neighbors(u).size()},
+            {"component", metrics.components.componentOf[u]},
+            {"betweenness", metrics.betweenness[u]},
+            {"closeness", metrics.closeness[u]},
+        });
+    }
+    j["nodes"] = std::move(nodes);
+    out << j.dump(2, ' ', false, json::error_handler_t::replace) << '\n';
+    return static_cast<bool>(out);
+}
+
+// Atributos DOT por nodo
+Graph::NodeAttributes metricsToDotAttributes(const Graph& graph, const GraphMetrics& metrics) {
+    Graph::NodeAttributes attrs(graph.numActors());
+    for (uint32_t u = 0; u < graph.numActors(); ++u) {
+        attrs[u] = {
+            {"degree", std::to_string(graph.neighbors(u).size())},
+            {"component", std::to_string(metrics.components.componentOf[u])},
+            {"betweenness", formatNumber(metrics.betweenness[u])},
+            {"closeness", formatNumber(metrics.closeness[u])},
+        };
+    }
+    return attrs;
+}
@@ -0,0 +1,78 @@
+// GraphAnalytics.h
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "Graph.h"
+#include "Parallel.h"
+
+// Análisis del grafo de colaboraciones. Todas las funciones trabajan sobre la
+// representación CSR, por lo que requieren un grafo congelado (Graph::freeze()) y
+// lanzan std::logic_error si no lo está. Los vectores por nodo se indexan con el
+// índice denso de Graph (ver Graph::indexOf / Graph::actorId).
+
+// Distribución de grados
+struct DegreeStats {
+    std::vector<size_t> histogram;   // histogram[d] = número de actores con grado d
+    size_t minDegree = 0;
+    size_t maxDegree = 0;
+    double meanDegree = 0;
+};
+
+// Componentes conexas (numeradas de mayor a menor tamaño)
+struct Components {
+    std::vector<uint32_t> componentOf;  // índice de nodo -> componente
+    std::vector<size_t> sizes;          // tamaño de cada componente
+};
+
+// Colaborador de un actor y número de películas compartidas
+struct Collaborator {
+    uint32_t node;
+    uint32_t movies;
+};
+
+// Opciones de las centralidades
+struct CentralityOptions {
+    unsigned threads = defaultThreadCount();
+    size_t samples = 0;       // 0 = exacto; k > 0 = k orígenes aleatorios (aproximación)
+    unsigned seed = 42;
+};
+
+// Resultado agregado de computeMetrics
+struct GraphMetrics {
+    DegreeStats degrees;
+    Components components;
+    std::vector<double> betweenness;  // normalizada como en networkx (2 / ((n-1)(n-2)))
+    std::vector<double> closeness;    // Wasserman-Faust (válida en grafos no conexos)
+    bool sampled = false;
+};
+
+DegreeStats degreeDistribution(const Graph& graph);
+
+// Unión-búsqueda paralela sin locks sobre las aristas
+Components connectedComponents(const Graph& graph, unsigned threads = defaultThreadCount());
+
+// Camino más corto entre dos actores (ids TMDB, ambos extremos incluidos) con BFS bidireccional.
+// Vacío si alguno no existe o no están conectados; los grados de separación son size() - 1.
+std::vector<int> degreesOfSeparation(const Graph& graph, int fromId, int toId);
+
+// Los k colaboradores con más películas compartidas con el nodo u (empate: índice menor)
+std::vector<Collaborator> topCollaborators(const Graph& graph, uint32_t u, size_t k);
+
+// Brandes en paralelo (un BFS por origen)
+std::vector<double> betweennessCentrality(const Graph& graph, const CentralityOptions& opts = {});
+
+// BFS desde cada nodo; con muestreo, estima las distancias desde k pivotes (Eppstein-Wang)
+std::vector<double> closenessCentrality(const Graph& graph, const Components& components,
+                                        const CentralityOptions& opts = {});
+
+// Calcula todas las métricas anteriores
+GraphMetrics computeMetrics(const Graph& graph, const CentralityOptions& opts = {});
+
+// Exporta una fila por actor: id,name,degree,component,betweenness,closeness
+bool writeMetricsCSV(const Graph& graph, const GraphMetrics& metrics, const std::string& filename);
+// Exporta resumen (histograma de grados, componentes) y nodos en JSON
+bool writeMetricsJSON(const Graph& graph, const GraphMetrics& metrics, const std::string& filename);
+// Atributos DOT por nodo (degree, component, betweenness, closeness) para Graph::exportToDot
+Graph::NodeAttributes metricsToDotAttributes(const Graph& graph, const GraphMetrics& metrics);
@@ -0,0 +1,42 @@
+// GraphArena.h
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+// Arena monotónica para el grafo mutable: asigna nodos, conjuntos de vecinos y cadenas en
+// bloques grandes (geométricamente crecientes) tomados de upstream, y no libera nada
+// individualmente; release() devuelve todos los bloques de una vez.
+// Uso: GraphArena arena; Graph graph(&arena); ... graph.clear(); arena.release();
+// No es segura entre hilos (como el grafo mutable). Debe sobrevivir a los grafos que la usan.
+class GraphArena : public std::pmr::memory_resource {
+public:
+    explicit GraphArena(size_t initialBytes = size_t(1) << 20,
+                        std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : arena(initialBytes, upstream) {}
+
+    // Libera en bloque todo lo asignado; los contenedores que la usaban deben estar
+    // vacíos (Graph::clear, Graph::freeze) o destruidos
+    void release() {
+        arena.release();
+        count = 0;
+        bytes = 0;
+    }
+
+    // Asignaciones atendidas y bytes solicitados desde el último release()
+    size_t allocations() const { return count; }
+    size_t bytesAllocated() const { return bytes; }
+
+private:
+    std::pmr::monotonic_buffer_resource arena;
+    size_t count = 0;
+    size_t bytes = 0;
+
+    void* do_allocate(size_t size, size_t alignment) override {
+        ++count;
+        bytes += size;
+        return arena.allocate(size, alignment);
+    }
+    void do_deallocate(void*, size_t, size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
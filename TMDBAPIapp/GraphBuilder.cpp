@@ -0,0 +1,219 @@
+#include "GraphBuilder.h"
+#include <algorithm>
+#include <string_view>
+#include <unordered_map>
+
+// Devuelve el índice de la película (reutiliza la última si coincide)
+uint32_t GraphBuilder::Buffer::movieIndex(int id, const std::string& title, int year) {
+    if (movies.empty() || movies.back().id != id) movies.push_back(Movie{id, title, year});
+    return static_cast<uint32_t>(movies.size() - 1);
+}
+
+// Agrega un actor al búfer
+void GraphBuilder::Buffer::addActor(int id, const std::string& name) {
+    actors.emplace_back(id, name);
+}
+
+// Agrega una colaboración al búfer (la resolución de duplicados ocurre en buildInto)
+void GraphBuilder::Buffer::addCollaboration(int id1, int id2, int movieId, const std::string& movieTitle, int movieYear) {
+    if (id1 == id2) return; // no loops
+    uint32_t movie = movieIndex(movieId, movieTitle, movieYear);
+    edges.push_back(Edge{std::min(id1, id2), std::max(id1, id2), movie});
+}
+
+// Agrega todas las colaboraciones de un reparto
+void GraphBuilder::Buffer::addCast(const std::vector<int>& actorIds, int movieId, const std::string& movieTitle, int movieYear) {
+    uint32_t movie = movieIndex(movieId, movieTitle, movieYear);
+    std::vector<int> ids(actorIds);
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    size_t n = ids.size();
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = i + 1; j < n; ++j) edges.push_back(Edge{ids[i], ids[j], movie});
+    }
+}
+
+// Crea un búfer nuevo (seguro entre hilos)
+GraphBuilder::Buffer& GraphBuilder::createBuffer() {
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    buffers.push_back(std::make_unique<Buffer>());
+    return *buffers.back();
+}
+
+// Fusiona los búferes en paralelo y deja graph congelado
+void GraphBuilder::buildInto(Graph& graph) {
+    std::vector<Buffer*> sources;
+
+    // 0. El contenido previo del grafo entra como un búfer más: su tabla de películas pasa
+    //    tal cual y cada película del historial de una arista es una colaboración
+    Buffer existing;
+    if (graph.frozen) {
+        const Graph::FrozenView& c = graph.csr;
+        for (uint32_t u = 0; u < c.ids.size(); ++u) existing.addActor(c.ids[u], std::string(graph.actorName(u)));
+        for (uint32_t k = 0; k < graph.numMovies(); ++k) {
+            existing.movies.push_back(Buffer::Movie{graph.movieId(k), std::string(graph.movieTitle(k)), graph.movieYear(k)});
+        }
+        for (uint32_t e = 0; e < c.edgeU.size(); ++e) {
+            for (uint32_t k : graph.edgeMovies(e)) existing.edges.push_back(Buffer::Edge{c.ids[c.edgeU[e]], c.ids[c.edgeV[e]], k});
+        }
+    } else {
+        for (const auto& [id, name] : graph.actors) existing.addActor(id, std::string(name));
+        for (const Graph::MovieInfo* movie : graph.moviesById()) {
+            existing.movies.push_back(Buffer::Movie{movie->id, std::string(movie->title), movie->year});
+        }
+        for (const auto& [pair, info] : graph.edgeLabels) {
+            for (uint32_t k : info.movies) existing.edges.push_back(Buffer::Edge{pair.first, pair.second, k});
+        }
+    }
+    sources.push_back(&existing);
+    for (auto& b : buffers) sources.push_back(b.get());
+    const size_t B = sources.size();
+
+    // 1. Ids densos: cada búfer ordena los suyos en paralelo y luego se unen
+    std::vector<std::vector<int>> localIds(B);
+    parallelFor(B, threads, [&](size_t i) {
+        std::vector<int>& ids = localIds[i];
+        for (const auto& [id, _] : sources[i]->actors) ids.push_back(id);
+        for (const Buffer::Edge& e : sources[i]->edges) {
+            ids.push_back(e.a);
+            ids.push_back(e.b);
+        }
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    });
+    Graph::FrozenData f;
+    for (auto& ids : localIds) {
+        f.ids.insert(f.ids.end(), ids.begin(), ids.end());
+        std::vector<int>().swap(ids);
+    }
+    std::sort(f.ids.begin(), f.ids.end());
+    f.ids.erase(std::unique(f.ids.begin(), f.ids.end()), f.ids.end());
+    const size_t n = f.ids.size();
+    auto indexOf = [&](int id) {
+        return static_cast<uint32_t>(std::lower_bound(f.ids.begin(), f.ids.end(), id) - f.ids.begin());
+    };
+
+    // 2. Nombres: el primero registrado para cada id (en orden de búfer)
+    std::vector<const std::string*> names(n, nullptr);
+    for (Buffer* src : sources) {
+        for (const auto& [id, name] : src->actors) {
+            const std::string*& slot = names[indexOf(id)];
+            if (!slot) slot = &name;
+        }
+    }
+    f.nameOffsets.reserve(n + 1);
+    for (size_t u = 0; u < n; ++u) {
+        f.nameOffsets.push_back(static_cast<uint32_t>(f.namePool.size()));
+        if (names[u]) f.namePool += *names[u];
+    }
+    f.nameOffsets.push_back(static_cast<uint32_t>(f.namePool.size()));
+
+    // 3. Reparto de aristas en particiones por rango del extremo menor (en paralelo por búfer)
+    struct Record {
+        uint32_t u, v;
+        int year;
+        uint32_t src, movie;
+    };
+    const size_t S = std::max<size_t>(1, std::min<size_t>(n, static_cast<size_t>(threads) * 8));
+    auto shardOf = [&](uint32_t u) { return static_cast<size_t>(u) * S / n; };
+    std::vector<std::vector<std::vector<Record>>> scattered(B, std::vector<std::vector<Record>>(S));
+    parallelFor(B, threads, [&](size_t i) {
+        const Buffer& src = *sources[i];
+        for (const Buffer::Edge& e : src.edges) {
+            uint32_t u = indexOf(e.a), v = indexOf(e.b);
+            scattered[i][shardOf(u)].push_back(Record{u, v, src.movies[e.movie].year, static_cast<uint32_t>(i), e.movie});
+        }
+    });
+
+    // 4. Cada partición ordena por par y, dentro del par, de la película más reciente a la
+    //    más antigua (a igual año, por título y luego por id), y descarta la misma película
+    //    (mismo id TMDB) repetida (en paralelo por partición)
+    auto titleOf = [&](const Record& r) -> const std::string& { return sources[r.src]->movies[r.movie].title; };
+    auto movieIdOf = [&](const Record& r) { return sources[r.src]->movies[r.movie].id; };
+    std::vector<std::vector<Record>> history(S);
+    parallelFor(S, threads, [&](size_t s) {
+        std::vector<Record> recs;
+        size_t total = 0;
+        for (size_t i = 0; i < B; ++i) total += scattered[i][s].size();
+        recs.reserve(total);
+        for (size_t i = 0; i < B; ++i) {
+            recs.insert(recs.end(), scattered[i][s].begin(), scattered[i][s].end());
+            std::vector<Record>().swap(scattered[i][s]);
+        }
+        std::sort(recs.begin(), recs.end(), [&](const Record& x, const Record& y) {
+            if (x.u != y.u) return x.u < y.u;
+            if (x.v != y.v) return x.v < y.v;
+            if (x.year != y.year) return x.year > y.year;  // más reciente primero
+            int c = titleOf(x).compare(titleOf(y));          // empate: título menor
+            return c != 0 ? c < 0 : movieIdOf(x) < movieIdOf(y);
+        });
+        std::vector<Record>& out = history[s];
+        for (const Record& r : recs) {
+            const Record* last = out.empty() ? nullptr : &out.back();
+            if (last && last->u == r.u && last->v == r.v && movieIdOf(*last) == movieIdOf(r)) continue;
+            out.push_back(r);
+        }
+    });
+
+    // 5. Ensamblar aristas (ya en orden global (u, v)) con su historial; la primera película
+    //    de cada par es la etiqueta. Películas y títulos se internan en orden de aparición.
+    size_t m = 0, collaborations = 0;
+    for (const auto& h : history) {
+        collaborations += h.size();
+        for (size_t i = 0; i < h.size(); ++i) m += i == 0 || h[i].u != h[i - 1].u || h[i].v != h[i - 1].v;
+    }
+    f.edgeU.reserve(m);
+    f.edgeV.reserve(m);
+    f.edgeTitle.reserve(m);
+    f.edgeYear.reserve(m);
+    f.edgeWeight.reserve(m);
+    f.historyOffsets.reserve(m + 1);
+    f.historyMovies.reserve(collaborations);
+    std::vector<std::vector<uint32_t>> movieCache(B);
+    for (size_t i = 0; i < B; ++i) movieCache[i].assign(sources[i]->movies.size(), Graph::npos);
+    std::unordered_map<std::string_view, uint32_t> titleIndex;
+    std::unordered_map<int, uint32_t> movieIndex; // id TMDB -> película
+    for (auto& h : history) {
+        for (size_t i = 0; i < h.size(); ++i) {
+            const Record& r = h[i];
+            uint32_t& k = movieCache[r.src][r.movie];
+            if (k == Graph::npos) {
+                auto [movie, newMovie] = movieIndex.try_emplace(movieIdOf(r), static_cast<uint32_t>(f.movieTitle.size()));
+                if (newMovie) {
+                    const std::string& title = titleOf(r);
+                    auto [t, newTitle] = titleIndex.try_emplace(title, static_cast<uint32_t>(titleIndex.size()));
+                    if (newTitle) {
+                        f.titleOffsets.push_back(static_cast<uint32_t>(f.titlePool.size()));
+                        f.titlePool += title;
+                    }
+                    f.movieId.push_back(movieIdOf(r));
+                    f.movieTitle.push_back(t->second);
+                    f.movieYear.push_back(r.year);
+                }
+                k = movie->second;
+            }
+            if (i == 0 || r.u != h[i - 1].u || r.v != h[i - 1].v) {
+                f.historyOffsets.push_back(static_cast<uint32_t>(f.historyMovies.size()));
+                f.edgeU.push_back(r.u);
+                f.edgeV.push_back(r.v);
+                f.edgeTitle.push_back(f.movieTitle[k]);
+                f.edgeYear.push_back(f.movieYear[k]);
+                f.edgeWeight.push_back(0);
+            }
+            f.historyMovies.push_back(k);
+            ++f.edgeWeight.back();
+        }
+        std::vector<Record>().swap(h);
+    }
+    f.historyOffsets.push_back(static_cast<uint32_t>(f.historyMovies.size()));
+    f.titleOffsets.push_back(static_cast<uint32_t>(f.titlePool.size()));
+
+    // 6. Adyacencia CSR y reemplazo del contenido del grafo
+    Graph::buildAdjacency(f);
+    graph.csr.adopt(std::move(f));
+    graph.frozen = true;
+    graph.releaseMutable();
+
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    buffers.clear();
+}
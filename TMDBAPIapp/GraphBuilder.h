@@ -0,0 +1,62 @@
+// GraphBuilder.h
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+#include "Graph.h"
+#include "Parallel.h"
+
+// Construcción concurrente del grafo sin contención: cada hilo escribe en su propio
+// búfer (sin locks) y al final buildInto() fusiona todos los búferes en paralelo,
+// particionando las aristas por rangos de actor, y deja el grafo congelado (CSR).
+// Conserva las reglas de Graph::addCollaboration: cada par guarda el historial de películas
+// distintas (por id TMDB) y se etiqueta con la más reciente (a igual año, el título
+// lexicográficamente menor).
+class GraphBuilder {
+public:
+    // Búfer local de un hilo: actores y aristas pendientes de fusionar
+    class Buffer {
+    public:
+        void addActor(int id, const std::string& name);
+        void addCollaboration(int id1, int id2, int movieId, const std::string& movieTitle, int movieYear);
+        // Registra la colaboración de todos los pares de un reparto en una película
+        // (un actor repetido en el reparto cuenta una sola vez)
+        void addCast(const std::vector<int>& actorIds, int movieId, const std::string& movieTitle, int movieYear);
+
+        size_t numEdges() const { return edges.size(); }
+
+    private:
+        friend class GraphBuilder;
+        struct Movie {
+            int id;           // id TMDB
+            std::string title;
+            int year;
+        };
+        struct Edge {
+            int a, b;         // ids TMDB (a < b)
+            uint32_t movie;   // índice en movies
+        };
+        std::vector<std::pair<int, std::string>> actors;
+        std::vector<Movie> movies;
+        std::vector<Edge> edges;
+
+        uint32_t movieIndex(int id, const std::string& title, int year);
+    };
+
+    explicit GraphBuilder(unsigned threads = defaultThreadCount()) : threads(threads) {}
+
+    // Crea un búfer nuevo (seguro entre hilos); cada hilo trabajador debe usar el suyo
+    Buffer& createBuffer();
+
+    // Fusiona todos los búferes (y el contenido previo de graph, si lo hay) en graph, que queda congelado.
+    // Los búferes se vacían al terminar.
+    void buildInto(Graph& graph);
+
+private:
+    unsigned threads;
+    std::mutex buffersMutex;
+    std::vector<std::unique_ptr<Buffer>> buffers;
+};
@@ -0,0 +1,167 @@
+#include "GraphExport.h"
+#include "OutputBuffer.h"
+
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+#include <sys/stat.h>
+
+namespace {
+
+constexpr char kEdgeListMagic[8] = {'T', 'M', 'D', 'B', 'E', 'D', 'G', 'E'};
+constexpr uint32_t kEdgeListVersion = 1;
+
+bool endsWith(const std::string& s, std::string_view suffix) {
+    return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+void requireFrozen(const Graph& graph, const char* what) {
+    if (!graph.isFrozen()) throw std::logic_error(std::string(what) + ": requiere un grafo congelado (Graph::freeze)");
+}
+
+} // namespace
+
+// Formato según la extensión del archivo
+ExportFormat exportFormatFor(const std::string& filename) {
+    if (endsWith(filename, ".graphml")) return ExportFormat::GraphML;
+    if (endsWith(filename, ".bin") || endsWith(filename, ".edges")) return ExportFormat::EdgeList;
+    return ExportFormat::Dot;
+}
+
+// Exporta en el formato indicado
+bool exportGraph(const Graph& graph, const std::string& filename, ExportFormat format) {
+    switch (format) {
+        case ExportFormat::GraphML: return exportGraphML(graph, filename);
+        case ExportFormat::EdgeList: return exportEdgeList(graph, filename);
+        case ExportFormat::Dot: break;
+    }
+    return graph.exportToDot(filename);
+}
+
+// Exporta a GraphML
+bool exportGraphML(const Graph& graph, const std::string& filename, const Graph::NodeAttributes* attrs) {
+    requireFrozen(graph, "exportGraphML");
+    OutputBuffer out(filename);
+    if (!out.isOpen()) return false;
+    auto text = [&](std::string_view s) { out.writeEscaped(s, XmlEscape{}); };
+
+    // Claves de los atributos extra, en orden de primera aparición
+    std::vector<std::string> extraKeys;
+    if (attrs) {
+        for (const auto& list : *attrs) {
+            for (const auto& [key, _] : list) {
+                bool known = false;
+                for (const std::string& k : extraKeys) known = known || k == key;
+                if (!known) extraKeys.push_back(key);
+            }
+        }
+    }
+
+    out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        << "<graphml xmlns=\"http://graphml.graphdrawing.org/xmlns\">\n"
+        << "  <key id=\"name\" for=\"node\" attr.name=\"name\" attr.type=\"string\"/>\n";
+    for (const std::string& key : extraKeys) {
+        out << "  <key id=\"a_";
+        text(key);
+        out << "\" for=\"node\" attr.name=\"";
+        text(key);
+        out << "\" attr.type=\"string\"/>\n";
+    }
+    out << "  <key id=\"movie\" for=\"edge\" attr.name=\"movie\" attr.type=\"string\"/>\n"
+        << "  <key id=\"year\" for=\"edge\" attr.name=\"year\" attr.type=\"int\"/>\n"
+        << "  <key id=\"weight\" for=\"edge\" attr.name=\"weight\" attr.type=\"int\"/>\n"
+        << "  <graph id=\"Collaborations\" edgedefault=\"undirected\">\n";
+
+    for (uint32_t u = 0; u < graph.numActors(); ++u) {
+        out << "    <node id=\"n" << graph.actorId(u) << "\"><data key=\"name\">";
+        text(graph.actorName(u));
+        out << "</data>";
+        if (attrs && u < attrs->size()) {
+            for (const auto& [key, value] : (*attrs)[u]) {
+                out << "<data key=\"a_";
+                text(key);
+                out << "\">";
+                text(value);
+                out << "</data>";
+            }
+        }
+        out << "</node>\n";
+    }
+    // Aristas: los títulos escapados se preparan una vez por película, no por arista
+    std::vector<std::string> movieText(graph.numTitles());
+    for (uint32_t t = 0; t < movieText.size(); ++t) {
+        movieText[t] = "\"><data key=\"movie\">";
+        appendEscaped(movieText[t], graph.title(t), XmlEscape{});
+        movieText[t] += "</data><data key=\"year\">";
+    }
+    for (uint32_t e = 0; e < graph.numCollaborations(); ++e) {
+        out << "    <edge source=\"n" << graph.actorId(graph.edgeSource(e)) << "\" target=\"n"
+            << graph.actorId(graph.edgeTarget(e)) << movieText[graph.edgeTitleId(e)] << graph.edgeYear(e)
+            << "</data><data key=\"weight\">" << graph.edgeWeight(e) << "</data></edge>\n";
+    }
+    out << "  </graph>\n</graphml>\n";
+    return out.close();
+}
+
+// Exporta la lista de aristas binaria
+bool exportEdgeList(const Graph& graph, const std::string& filename) {
+    requireFrozen(graph, "exportEdgeList");
+    OutputBuffer out(filename);
+    if (!out.isOpen()) return false;
+    const uint64_t n = graph.numActors(), m = graph.numCollaborations();
+
+    out.write(kEdgeListMagic, sizeof(kEdgeListMagic));
+    out.writeRaw(kEdgeListVersion);
+    out.writeRaw(uint32_t{0});
+    out.writeRaw(n);
+    out.writeRaw(m);
+    for (uint32_t u = 0; u < n; ++u) out.writeRaw(static_cast<int32_t>(graph.actorId(u)));
+    for (uint32_t e = 0; e < m; ++e) out.writeRaw(graph.edgeSource(e));
+    for (uint32_t e = 0; e < m; ++e) out.writeRaw(graph.edgeTarget(e));
+    for (uint32_t e = 0; e < m; ++e) out.writeRaw(graph.edgeWeight(e));
+    for (uint32_t e = 0; e < m; ++e) out.writeRaw(static_cast<int32_t>(graph.edgeYear(e)));
+    return out.close();
+}
+
+// Lee una lista de aristas binaria
+bool readEdgeList(const std::string& filename, EdgeList& out) {
+    std::FILE* file = std::fopen(filename.c_str(), "rb");
+    if (!file) return false;
+    char magic[8];
+    uint32_t version = 0, reserved = 0;
+    uint64_t n = 0, m = 0;
+    bool ok = std::fread(magic, 1, sizeof(magic), file) == sizeof(magic) &&
+              std::memcmp(magic, kEdgeListMagic, sizeof(magic)) == 0 &&
+              std::fread(&version, sizeof(version), 1, file) == 1 && version == kEdgeListVersion &&
+              std::fread(&reserved, sizeof(reserved), 1, file) == 1 &&
+              std::fread(&n, sizeof(n), 1, file) == 1 && std::fread(&m, sizeof(m), 1, file) == 1 &&
+              n <= UINT32_MAX && m <= UINT32_MAX;
+    // Los tamaños de la cabecera deben caber en lo que queda del archivo antes de reservar nada
+    // (un archivo corrupto o truncado devuelve false en lugar de bad_alloc)
+    struct stat st {};
+    if (ok) {
+        const long header = std::ftell(file);
+        const uint64_t payload = n * sizeof(out.ids[0]) +
+                                 m * (sizeof(out.source[0]) + sizeof(out.target[0]) + sizeof(out.weight[0]) +
+                                      sizeof(out.year[0]));
+        ok = header >= 0 && ::fstat(fileno(file), &st) == 0 && st.st_size >= header &&
+             payload <= static_cast<uint64_t>(st.st_size - header);
+    }
+    auto readArray = [&](auto& vec, uint64_t count) {
+        vec.resize(count);
+        ok = ok && std::fread(vec.data(), sizeof(vec[0]), count, file) == count;
+    };
+    if (ok) {
+        readArray(out.ids, n);
+        readArray(out.source, m);
+        readArray(out.target, m);
+        readArray(out.weight, m);
+        readArray(out.year, m);
+    }
+    std::fclose(file);
+    if (ok) {
+        for (uint64_t e = 0; e < m && ok; ++e) ok = out.source[e] < n && out.target[e] < n;
+    }
+    return ok;
+}
@@ -0,0 +1,40 @@
+// GraphExport.h
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "Graph.h"
+
+// Exportación del grafo para otras herramientas. Todos los formatos se escriben a través de
+// OutputBuffer (búfer grande, escape en una pasada) y en orden determinista: nodos por id TMDB
+// ascendente y aristas por (u, v). GraphML y la lista binaria requieren un grafo congelado
+// (lanzan std::logic_error si no lo está); DOT es Graph::exportToDot.
+
+enum class ExportFormat { Dot, GraphML, EdgeList };
+
+// Formato según la extensión: .graphml, .bin/.edges (lista binaria); cualquier otra, DOT
+ExportFormat exportFormatFor(const std::string& filename);
+
+// Exporta en el formato indicado
+bool exportGraph(const Graph& graph, const std::string& filename, ExportFormat format);
+
+// GraphML: nodos con name (y los atributos extra como string), aristas con movie, year y weight
+bool exportGraphML(const Graph& graph, const std::string& filename, const Graph::NodeAttributes* attrs = nullptr);
+
+// Lista de aristas binaria (little-endian, arreglos contiguos alineados a 4 bytes):
+//   cabecera de 32 bytes: "TMDBEDGE", uint32 versión (1), uint32 reservado, uint64 n, uint64 m
+//   int32 ids[n]; uint32 source[m]; uint32 target[m]; uint32 weight[m]; int32 year[m]
+// source/target son índices en ids (source < target); weight = películas compartidas.
+// Con numpy: np.fromfile(f, dtype="<i4", count=n, offset=32), etc.
+bool exportEdgeList(const Graph& graph, const std::string& filename);
+
+// Contenido de una lista binaria leída con readEdgeList
+struct EdgeList {
+    std::vector<int32_t> ids;
+    std::vector<uint32_t> source, target, weight;
+    std::vector<int32_t> year;
+};
+
+// Lee una lista binaria; devuelve false si el archivo no existe o no es válido
+bool readEdgeList(const std::string& filename, EdgeList& out);
@@ -0,0 +1,348 @@
+// Snapshots binarios del grafo congelado (Graph::save / Graph::load / Graph::map).
+//
+// Formato (little-endian, versión 3):
+//   cabecera de 64 bytes: "TMDBGRPH", versión, marca de endianness, tamaño del archivo,
+//                         suma de verificación, número de secciones y metadatos escalares
+//   tabla de secciones:   {id, tamaño de elemento, desplazamiento, cantidad} por sección
+//   secciones:            los arreglos CSR (incluido el historial de películas por arista) tal
+//                         cual están en memoria, alineados a 64 bytes, con el id TMDB de cada
+//                         película, más las películas y actores ya recorridos
+// Al estar alineadas, las secciones de un archivo mapeado se usan directamente como arreglos.
+#include "Graph.h"
+#include "OutputBuffer.h"
+
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr char kMagic[8] = {'T', 'M', 'D', 'B', 'G', 'R', 'P', 'H'};
+constexpr uint32_t kVersion = 3; // 2: historial de películas por arista; 3: id TMDB por película
+constexpr uint32_t kEndianMarker = 0x01020304;
+constexpr uint64_t kAlignment = 64;
+
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t endianMarker;
+    uint64_t fileSize;
+    uint64_t checksum;       // de la tabla de secciones y del contenido de cada sección
+    uint32_t sectionCount;
+    uint32_t reserved;
+    int64_t savedAt;
+    int32_t mainActorId, startYear, endYear, reserved2;
+};
+static_assert(sizeof(Header) == 64);
+
+struct SectionEntry {
+    uint32_t id;
+    uint32_t elemSize;
+    uint64_t offset;
+    uint64_t count;
+};
+static_assert(sizeof(SectionEntry) == 24);
+
+// Identificadores de sección (los desconocidos se ignoran al leer)
+enum Section : uint32_t {
+    Ids = 1, NameOffsets, NamePool, Offsets, Targets, EdgeOf, EdgeU, EdgeV,
+    EdgeTitle, EdgeYear, EdgeWeight, TitleOffsets, TitlePool, FetchedMovies, FetchedActors,
+    HistoryOffsets, HistoryMovies, MovieTitle, MovieYear, MovieId,
+    SectionLimit
+};
+
+// Tamaño de elemento esperado por sección
+uint32_t elemSizeOf(uint32_t id) {
+    return id == NamePool || id == TitlePool ? 1 : 4;
+}
+
+uint64_t rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+// Suma de verificación de 64 bits (no criptográfica): cuatro carriles independientes de
+// xor-rotación-multiplicación sobre bloques de 32 bytes, encadenable mediante seed
+uint64_t hashBytes(const void* data, size_t size, uint64_t seed) {
+    constexpr uint64_t kMul = 0x9E3779B97F4A7C15ULL;
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    uint64_t lane[4] = {seed, seed ^ 0xC2B2AE3D27D4EB4FULL, seed ^ 0x165667B19E3779F9ULL, seed ^ 0x85EBCA77C2B2AE63ULL};
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        for (int k = 0; k < 4; ++k) {
+            uint64_t w;
+            std::memcpy(&w, p + i + 8 * k, 8);
+            lane[k] = rotl(lane[k] ^ w, 29) * kMul;
+        }
+    }
+    for (; i + 8 <= size; i += 8) {
+        uint64_t w;
+        std::memcpy(&w, p + i, 8);
+        lane[0] = rotl(lane[0] ^ w, 29) * kMul;
+    }
+    uint64_t tail = 0;
+    if (size > i) std::memcpy(&tail, p + i, size - i);
+    uint64_t h = (size ^ tail) * kMul;
+    for (int k = 0; k < 4; ++k) h = rotl(h ^ lane[k], 31) * kMul;
+    return h ^ (h >> 32);
+}
+
+// Archivo mapeado en memoria (solo lectura); se desmapea al soltar la última referencia
+std::shared_ptr<const void> mapFile(const std::string& filename, size_t& size) {
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return nullptr;
+    struct stat st {};
+    void* addr = MAP_FAILED;
+    if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+        size = static_cast<size_t>(st.st_size);
+        addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    ::close(fd);
+    if (addr == MAP_FAILED) return nullptr;
+    return std::shared_ptr<const void>(addr, [size](const void* p) { ::munmap(const_cast<void*>(p), size); });
+}
+
+// Comprueba que los índices de la vista no se salen de rango (lo que asumen los accesores)
+template <class T>
+bool monotone(std::span<const T> v, uint64_t limit) {
+    for (size_t i = 0; i + 1 < v.size(); ++i) {
+        if (v[i] > v[i + 1]) return false;
+    }
+    return v.empty() || v.back() <= limit;
+}
+
+bool allBelow(std::span<const uint32_t> v, uint64_t limit) {
+    for (uint32_t x : v) {
+        if (x >= limit) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+// Guarda el grafo congelado y los metadatos del recorrido
+bool Graph::save(const std::string& filename, const CrawlMetadata& meta) const {
+    if (!frozen) throw std::logic_error("Graph::save: requiere un grafo congelado (Graph::freeze)");
+
+    struct Source {
+        uint32_t id;
+        const void* data;
+        uint64_t count;
+    };
+    const Source sources[] = {
+        {Ids, csr.ids.data(), csr.ids.size()},
+        {NameOffsets, csr.nameOffsets.data(), csr.nameOffsets.size()},
+        {NamePool, csr.namePool.data(), csr.namePool.size()},
+        {Offsets, csr.offsets.data(), csr.offsets.size()},
+        {Targets, csr.targets.data(), csr.targets.size()},
+        {EdgeOf, csr.edgeOf.data(), csr.edgeOf.size()},
+        {EdgeU, csr.edgeU.data(), csr.edgeU.size()},
+        {EdgeV, csr.edgeV.data(), csr.edgeV.size()},
+        {EdgeTitle, csr.edgeTitle.data(), csr.edgeTitle.size()},
+        {EdgeYear, csr.edgeYear.data(), csr.edgeYear.size()},
+        {EdgeWeight, csr.edgeWeight.data(), csr.edgeWeight.size()},
+        {TitleOffsets, csr.titleOffsets.data(), csr.titleOffsets.size()},
+        {TitlePool, csr.titlePool.data(), csr.titlePool.size()},
+        {FetchedMovies, meta.fetchedMovies.data(), meta.fetchedMovies.size()},
+        {FetchedActors, meta.fetchedActors.data(), meta.fetchedActors.size()},
+        {HistoryOffsets, csr.historyOffsets.data(), csr.historyOffsets.size()},
+        {HistoryMovies, csr.historyMovies.data(), csr.historyMovies.size()},
+        {MovieTitle, csr.movieTitle.data(), csr.movieTitle.size()},
+        {MovieYear, csr.movieYear.data(), csr.movieYear.size()},
+        {MovieId, csr.movieId.data(), csr.movieId.size()},
+    };
+    constexpr size_t sectionCount = std::size(sources);
+    auto align = [](uint64_t x) { return (x + kAlignment - 1) / kAlignment * kAlignment; };
+
+    // Disposición y suma de verificación (tabla + contenido, en orden de la tabla)
+    SectionEntry table[sectionCount];
+    uint64_t pos = align(sizeof(Header) + sizeof(table));
+    for (size_t i = 0; i < sectionCount; ++i) {
+        table[i] = {sources[i].id, elemSizeOf(sources[i].id), pos, sources[i].count};
+        pos = align(pos + sources[i].count * table[i].elemSize);
+    }
+    uint64_t checksum = hashBytes(table, sizeof(table), 0);
+    for (size_t i = 0; i < sectionCount; ++i) {
+        checksum = hashBytes(sources[i].data, sources[i].count * table[i].elemSize, checksum);
+    }
+
+    Header header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.endianMarker = kEndianMarker;
+    header.fileSize = pos;
+    header.checksum = checksum;
+    header.sectionCount = sectionCount;
+    header.savedAt = meta.savedAt;
+    header.mainActorId = meta.mainActorId;
+    header.startYear = meta.startYear;
+    header.endYear = meta.endYear;
+
+    // Escritura a un temporal y renombrado: el snapshot anterior sigue intacto (y mapeable)
+    // hasta que el nuevo está completo
+    const std::string tmp = filename + ".tmp";
+    {
+        OutputBuffer out(tmp);
+        if (!out.isOpen()) return false;
+        static const char zeros[kAlignment] = {};
+        uint64_t written = 0;
+        auto padTo = [&](uint64_t offset) {
+            out.write(zeros, offset - written);
+            written = offset;
+        };
+        out.writeRaw(header);
+        out.write(reinterpret_cast<const char*>(table), sizeof(table));
+        written = sizeof(Header) + sizeof(table);
+        for (size_t i = 0; i < sectionCount; ++i) {
+            padTo(table[i].offset);
+            uint64_t bytes = table[i].count * table[i].elemSize;
+            if (bytes) out.write(static_cast<const char*>(sources[i].data), bytes);
+            written += bytes;
+        }
+        padTo(pos);
+        if (!out.close()) {
+            std::remove(tmp.c_str());
+            return false;
+        }
+    }
+    if (std::rename(tmp.c_str(), filename.c_str()) != 0) {
+        std::remove(tmp.c_str());
+        return false;
+    }
+    return true;
+}
+
+// Carga un snapshot en memoria propia
+bool Graph::load(const std::string& filename, CrawlMetadata* meta) {
+    size_t size = 0;
+    std::shared_ptr<const void> file = mapFile(filename, size);
+    FrozenView view;
+    if (!file || !parseSnapshot(static_cast<const char*>(file.get()), size, true, view, meta)) return false;
+
+    FrozenData f;
+    f.ids.assign(view.ids.begin(), view.ids.end());
+    f.nameOffsets.assign(view.nameOffsets.begin(), view.nameOffsets.end());
+    f.namePool.assign(view.namePool);
+    f.offsets.assign(view.offsets.begin(), view.offsets.end());
+    f.targets.assign(view.targets.begin(), view.targets.end());
+    f.edgeOf.assign(view.edgeOf.begin(), view.edgeOf.end());
+    f.edgeU.assign(view.edgeU.begin(), view.edgeU.end());
+    f.edgeV.assign(view.edgeV.begin(), view.edgeV.end());
+    f.edgeTitle.assign(view.edgeTitle.begin(), view.edgeTitle.end());
+    f.edgeYear.assign(view.edgeYear.begin(), view.edgeYear.end());
+    f.edgeWeight.assign(view.edgeWeight.begin(), view.edgeWeight.end());
+    f.titleOffsets.assign(view.titleOffsets.begin(), view.titleOffsets.end());
+    f.titlePool.assign(view.titlePool);
+    f.historyOffsets.assign(view.historyOffsets.begin(), view.historyOffsets.end());
+    f.historyMovies.assign(view.historyMovies.begin(), view.historyMovies.end());
+    f.movieId.assign(view.movieId.begin(), view.movieId.end());
+    f.movieTitle.assign(view.movieTitle.begin(), view.movieTitle.end());
+    f.movieYear.assign(view.movieYear.begin(), view.movieYear.end());
+
+    csr.adopt(std::move(f));
+    frozen = true;
+    releaseMutable();
+    return true;
+}
+
+// Mapea un snapshot y usa sus secciones sin copiarlas
+bool Graph::map(const std::string& filename, CrawlMetadata* meta, bool verify) {
+    size_t size = 0;
+    std::shared_ptr<const void> file = mapFile(filename, size);
+    FrozenView view;
+    if (!file || !parseSnapshot(static_cast<const char*>(file.get()), size, verify, view, meta)) return false;
+
+    csr.adopt(view, std::move(file));
+    frozen = true;
+    releaseMutable();
+    return true;
+}
+
+// Valida un snapshot en memoria y apunta view (y meta) a sus secciones
+bool Graph::parseSnapshot(const char* base, size_t size, bool verify, FrozenView& view, CrawlMetadata* meta) {
+    Header header;
+    if (size < sizeof(header)) return false;
+    std::memcpy(&header, base, sizeof(header));
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion ||
+        header.endianMarker != kEndianMarker || header.fileSize != size ||
+        header.sectionCount > (size - sizeof(header)) / sizeof(SectionEntry)) {
+        return false;
+    }
+    const auto* table = reinterpret_cast<const SectionEntry*>(base + sizeof(header));
+
+    // Ubicación de cada sección conocida
+    const char* data[SectionLimit] = {};
+    uint64_t count[SectionLimit] = {};
+    uint64_t checksum = hashBytes(table, header.sectionCount * sizeof(SectionEntry), 0);
+    for (uint32_t i = 0; i < header.sectionCount; ++i) {
+        const SectionEntry& s = table[i];
+        if (s.elemSize == 0 || s.offset % kAlignment != 0 || s.offset > size ||
+            s.count > (size - s.offset) / s.elemSize) {
+            return false;
+        }
+        if (verify) checksum = hashBytes(base + s.offset, s.count * s.elemSize, checksum);
+        if (s.id == 0 || s.id >= SectionLimit) continue;
+        if (s.elemSize != elemSizeOf(s.id) || data[s.id]) return false;
+        data[s.id] = base + s.offset;
+        count[s.id] = s.count;
+    }
+    if (verify && checksum != header.checksum) return false;
+    for (uint32_t id = Ids; id < SectionLimit; ++id) {
+        if (!data[id]) return false;
+    }
+
+    auto u32 = [&](Section id) { return std::span<const uint32_t>(reinterpret_cast<const uint32_t*>(data[id]), count[id]); };
+    auto i32 = [&](Section id) { return std::span<const int>(reinterpret_cast<const int*>(data[id]), count[id]); };
+    view.ids = i32(Ids);
+    view.nameOffsets = u32(NameOffsets);
+    view.namePool = std::string_view(data[NamePool], count[NamePool]);
+    view.offsets = u32(Offsets);
+    view.targets = u32(Targets);
+    view.edgeOf = u32(EdgeOf);
+    view.edgeU = u32(EdgeU);
+    view.edgeV = u32(EdgeV);
+    view.edgeTitle = u32(EdgeTitle);
+    view.edgeYear = i32(EdgeYear);
+    view.edgeWeight = u32(EdgeWeight);
+    view.titleOffsets = u32(TitleOffsets);
+    view.titlePool = std::string_view(data[TitlePool], count[TitlePool]);
+    view.historyOffsets = u32(HistoryOffsets);
+    view.historyMovies = u32(HistoryMovies);
+    view.movieTitle = u32(MovieTitle);
+    view.movieYear = i32(MovieYear);
+    view.movieId = i32(MovieId);
+
+    // Coherencia de tamaños (siempre) y de índices (con verify)
+    const uint64_t n = view.ids.size(), m = view.edgeU.size();
+    if (view.nameOffsets.size() != n + 1 || view.offsets.size() != n + 1 || view.offsets.back() != 2 * m ||
+        view.targets.size() != 2 * m || view.edgeOf.size() != 2 * m || view.edgeV.size() != m ||
+        view.edgeTitle.size() != m || view.edgeYear.size() != m || view.edgeWeight.size() != m ||
+        view.titleOffsets.empty() || view.historyOffsets.size() != m + 1 ||
+        view.historyOffsets.back() != view.historyMovies.size() || view.movieYear.size() != view.movieTitle.size() ||
+        view.movieId.size() != view.movieTitle.size()) {
+        return false;
+    }
+    if (verify) {
+        const uint64_t titles = view.titleOffsets.size() - 1;
+        if (!monotone(view.nameOffsets, view.namePool.size()) || !monotone(view.titleOffsets, view.titlePool.size()) ||
+            !monotone(view.offsets, 2 * m) || !allBelow(view.targets, n) || !allBelow(view.edgeOf, m) ||
+            !allBelow(view.edgeU, n) || !allBelow(view.edgeV, n) || !allBelow(view.edgeTitle, titles) ||
+            !monotone(view.historyOffsets, view.historyMovies.size()) ||
+            !allBelow(view.historyMovies, view.movieTitle.size()) || !allBelow(view.movieTitle, titles)) {
+            return false;
+        }
+    }
+
+    if (meta) {
+        std::span<const int> movies = i32(FetchedMovies), actorIds = i32(FetchedActors);
+        meta->savedAt = header.savedAt;
+        meta->mainActorId = header.mainActorId;
+        meta->startYear = header.startYear;
+        meta->endYear = header.endYear;
+        meta->fetchedMovies.assign(movies.begin(), movies.end());
+        meta->fetchedActors.assign(actorIds.begin(), actorIds.end());
+    }
+    return true;
+}
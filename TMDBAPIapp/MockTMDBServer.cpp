@@ -0,0 +1,339 @@
+// Servidor HTTP mínimo que imita los endpoints de TMDB usados por el crawler.
+// Sirve fixtures grabadas (TMDB_RECORD_DIR) o un "mundo" sintético determinista,
+// con latencia y tasa de errores configurables, para benchmarks reproducibles.
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <unordered_map>
+#include <random>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <charconv>
+#include <cstring>
+#include <csignal>
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+// Parámetros del servidor mock
+struct MockConfig {
+    int port = 8080;
+    int movies = 60;           // Películas del actor principal
+    int castSize = 15;         // Actores por película (incluye al principal)
+    int crewSize = 5;          // Entradas de "crew" (relleno realista del payload)
+    int actors = 2000;         // Tamaño del grupo de actores secundarios
+    int hubId = 6384;          // Actor principal (aparece en todas las películas)
+    std::string hubName = "Keanu Reeves";
+    unsigned seed = 42;
+    int latencyMs = 0;         // Latencia fija por solicitud
+    int jitterMs = 0;          // Latencia aleatoria adicional [0, jitter]
+    double errorRate = 0.0;    // Probabilidad de responder 500
+    std::string fixturesDir;   // Carpeta con respuestas grabadas
+    bool replayOnly = false;   // 404 si no hay fixture (sin mundo sintético)
+};
+
+// Película sintética con su reparto
+struct SyntheticMovie {
+    int id;
+    std::string title;
+    std::string releaseDate;
+    std::vector<int> cast;
+};
+
+// Mundo sintético determinista derivado de la semilla
+class SyntheticWorld {
+public:
+    explicit SyntheticWorld(const MockConfig& cfg) : cfg_(cfg) {
+        std::mt19937 rng(cfg.seed);
+        std::uniform_int_distribution<int> yearDist(1985, 2023), monthDist(1, 12), dayDist(1, 28);
+        std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+        movies_.reserve(cfg.movies);
+        for (int m = 0; m < cfg.movies; ++m) {
+            SyntheticMovie mv;
+            mv.id = 100000 + m;
+            mv.title = "Synthetic Movie " + std::to_string(m);
+            // ~2% sin fecha, como ocurre en la API real
+            if (unit(rng) >= 0.02) {
+                char buf[16];
+                std::snprintf(buf, sizeof(buf), "%04d-%02d-%02d", yearDist(rng), monthDist(rng), dayDist(rng));
+                mv.releaseDate = buf;
+            }
+            mv.cast.push_back(cfg.hubId);
+            // Distribución sesgada: pocos actores aparecen en muchas películas
+            int guard = 0;
+            while (static_cast<int>(mv.cast.size()) < cfg.castSize && guard++ < cfg.castSize * 20) {
+                double u = unit(rng);
+                int actor = 1000000 + static_cast<int>(u * u * cfg.actors);
+                bool dup = false;
+                for (int id : mv.cast) dup = dup || id == actor;
+                if (!dup) mv.cast.push_back(actor);
+            }
+            for (int id : mv.cast) filmography_[id].push_back(m);
+            movieIndex_[mv.id] = m;
+            movies_.push_back(std::move(mv));
+        }
+    }
+
+    // Payload de /person/{id}/movie_credits
+    bool personCredits(int personId, std::string& out) const {
+        std::ostringstream oss;
+        oss << "{\"cast\":[";
+        auto it = filmography_.find(personId);
+        if (it != filmography_.end()) {
+            bool first = true;
+            for (int m : it->second) {
+                const SyntheticMovie& mv = movies_[m];
+                if (!first) oss << ',';
+                first = false;
+                oss << "{\"adult\":false,\"backdrop_path\":\"/b" << mv.id << ".jpg\",\"genre_ids\":[18,28],"
+                    << "\"id\":" << mv.id << ",\"original_language\":\"en\",\"original_title\":\"" << mv.title << "\","
+                    << "\"overview\":\"Synthetic overview for " << mv.title << ".\",\"popularity\":12.5,"
+                    << "\"poster_path\":\"/p" << mv.id << ".jpg\",\"release_date\":\"" << mv.releaseDate << "\","
+                    << "\"title\":\"" << mv.title << "\",\"video\":false,\"vote_average\":6.8,\"vote_count\":1200,"
+                    << "\"character\":\"Character " << personId << "\",\"credit_id\":\"c" << mv.id << "_" << personId << "\","
+                    << "\"order\":0}";
+            }
+        }
+        oss << "],\"crew\":[],\"id\":" << personId << "}";
+        out = oss.str();
+        return it != filmography_.end() || personId == cfg_.hubId;
+    }
+
+    // Payload de /movie/{id}/credits
+    bool movieCredits(int movieId, std::string& out) const {
+        auto it = movieIndex_.find(movieId);
+        if (it == movieIndex_.end()) return false;
+        const SyntheticMovie& mv = movies_[it->second];
+        std::ostringstream oss;
+        oss << "{\"id\":" << mv.id << ",\"cast\":[";
+        for (size_t k = 0; k < mv.cast.size(); ++k) {
+            int id = mv.cast[k];
+            std::string name = id == cfg_.hubId ? cfg_.hubName : "Actor " + std::to_string(id);
+            if (k) oss << ',';
+            oss << "{\"adult\":false,\"gender\":2,\"id\":" << id << ",\"known_for_department\":\"Acting\","
+                << "\"name\":\"" << name << "\",\"original_name\":\"" << name << "\",\"popularity\":3.2,"
+                << "\"profile_path\":\"/a" << id << ".jpg\",\"cast_id\":" << k << ","
+                << "\"character\":\"Role " << k << " in " << mv.title << "\","
+                << "\"credit_id\":\"c" << mv.id << "_" << id << "\",\"order\":" << k << "}";
+        }
+        oss << "],\"crew\":[";
+        for (int k = 0; k < cfg_.crewSize; ++k) {
+            if (k) oss << ',';
+            oss << "{\"adult\":false,\"gender\":1,\"id\":" << (900000 + k) << ",\"known_for_department\":\"Crew\","
+                << "\"name\":\"Crew " << k << "\",\"original_name\":\"Crew " << k << "\",\"popularity\":0.6,"
+                << "\"profile_path\":null,\"credit_id\":\"w" << mv.id << "_" << k << "\","
+                << "\"department\":\"Production\",\"job\":\"Producer\"}";
+        }
+        oss << "]}";
+        out = oss.str();
+        return true;
+    }
+
+    size_t numMovies() const { return movies_.size(); }
+    size_t numActors() const { return filmography_.size(); }
+
+private:
+    const MockConfig& cfg_;
+    std::vector<SyntheticMovie> movies_;
+    std::unordered_map<int, int> movieIndex_;              // movie id -> índice
+    std::unordered_map<int, std::vector<int>> filmography_; // actor id -> índices de películas
+};
+
+static std::atomic<long long> g_requests{0};
+static std::atomic<long long> g_errors{0};
+static std::atomic<uint64_t> g_draws{0};   // Contador para sembrar el generador de cada solicitud
+
+// splitmix64: semillas bien repartidas a partir de valores consecutivos
+static uint64_t splitmix64(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ull;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+// Envía una respuesta HTTP completa y cierra la conexión
+static void sendResponse(int fd, int status, const char* reason, const std::string& body) {
+    std::ostringstream head;
+    head << "HTTP/1.1 " << status << ' ' << reason << "\r\n"
+         << "Content-Type: application/json;charset=utf-8\r\n"
+         << "Content-Length: " << body.size() << "\r\n"
+         << "Connection: close\r\n\r\n";
+    std::string msg = head.str() + body;
+    size_t sent = 0;
+    while (sent < msg.size()) {
+        ssize_t n = ::send(fd, msg.data() + sent, msg.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) break;
+        sent += static_cast<size_t>(n);
+    }
+}
+
+// Extrae el id numérico de rutas tipo /person/{id}/movie_credits
+static bool matchRoute(const std::string& path, const std::string& prefix, const std::string& suffix, int& id) {
+    if (path.size() <= prefix.size() + suffix.size()) return false;
+    if (path.compare(0, prefix.size(), prefix) != 0) return false;
+    if (path.compare(path.size() - suffix.size(), suffix.size(), suffix) != 0) return false;
+    std::string num = path.substr(prefix.size(), path.size() - prefix.size() - suffix.size());
+    if (num.empty() || num.find_first_not_of("0123456789") != std::string::npos) return false;
+    // Un id que no cabe en int no existe (404), no tumba el servidor
+    auto [end, ec] = std::from_chars(num.data(), num.data() + num.size(), id);
+    return ec == std::errc() && end == num.data() + num.size();
+}
+
+// Atiende una conexión: lee la solicitud, aplica latencia/errores y responde
+static void handleClient(int fd, const MockConfig& cfg, const SyntheticWorld& world) {
+    std::string request;
+    char buf[4096];
+    while (request.find("\r\n\r\n") == std::string::npos && request.size() < 16384) {
+        ssize_t n = ::recv(fd, buf, sizeof(buf), 0);
+        if (n <= 0) break;
+        request.append(buf, static_cast<size_t>(n));
+    }
+    ++g_requests;
+
+    // Línea de solicitud: GET /3/movie/603/credits?api_key=... HTTP/1.1
+    std::istringstream line(request.substr(0, request.find("\r\n")));
+    std::string method, target;
+    line >> method >> target;
+    if (target.empty() || target[0] != '/') {
+        sendResponse(fd, 400, "Bad Request", "{\"status_message\":\"Bad request target\"}");
+        ::close(fd);
+        return;
+    }
+    std::string path = target.substr(0, target.find('?'));
+    if (path.rfind("/3/", 0) == 0) path = path.substr(2);
+
+    // Cada hilo atiende una sola conexión (y los ids de hilo se reutilizan): la semilla sale
+    // de cfg.seed y de un contador global, distinta en cada solicitud y reproducible en orden
+    std::mt19937_64 rng(splitmix64(cfg.seed ^ ++g_draws));
+    int delay = cfg.latencyMs;
+    if (cfg.jitterMs > 0) delay += std::uniform_int_distribution<int>(0, cfg.jitterMs)(rng);
+    if (delay > 0) std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+
+    if (method != "GET") {
+        sendResponse(fd, 405, "Method Not Allowed", "{\"status_message\":\"Only GET\"}");
+        ::close(fd);
+        return;
+    }
+    if (cfg.errorRate > 0 && std::uniform_real_distribution<double>(0.0, 1.0)(rng) < cfg.errorRate) {
+        ++g_errors;
+        sendResponse(fd, 500, "Internal Server Error", "{\"status_code\":11,\"status_message\":\"Injected error\"}");
+        ::close(fd);
+        return;
+    }
+
+    // 1) Fixture grabada, si existe
+    if (!cfg.fixturesDir.empty() && path.find("..") == std::string::npos) {
+        fs::path file = fs::path(cfg.fixturesDir) / (path.substr(1) + ".json");
+        std::ifstream in(file, std::ios::binary);
+        if (in.is_open()) {
+            std::ostringstream body;
+            body << in.rdbuf();
+            sendResponse(fd, 200, "OK", body.str());
+            ::close(fd);
+            return;
+        }
+    }
+
+    // 2) Mundo sintético
+    std::string body;
+    int id = 0;
+    bool found = false;
+    if (!cfg.replayOnly) {
+        if (matchRoute(path, "/person/", "/movie_credits", id)) found = world.personCredits(id, body);
+        else if (matchRoute(path, "/movie/", "/credits", id)) found = world.movieCredits(id, body);
+    }
+    if (found) {
+        sendResponse(fd, 200, "OK", body);
+    } else {
+        sendResponse(fd, 404, "Not Found", "{\"status_code\":34,\"status_message\":\"The resource you requested could not be found.\"}");
+    }
+    ::close(fd);
+}
+
+static void printUsage() {
+    std::cout << "Uso: mock-tmdb [--port N] [--movies N] [--cast N] [--crew N] [--actors N]\n"
+              << "                [--hub ID] [--seed N] [--latency-ms N] [--jitter-ms N]\n"
+              << "                [--error-rate P] [--fixtures DIR] [--replay-only]\n";
+}
+
+int main(int argc, char* argv[]) {
+    MockConfig cfg;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        std::string val;
+        auto next = [&]() -> std::string {
+            if (i + 1 >= argc) { printUsage(); std::exit(1); }
+            return val = argv[++i];
+        };
+        try {
+            if (arg == "--port") {
+                cfg.port = std::stoi(next());
+                if (cfg.port <= 0 || cfg.port > 65535) throw std::out_of_range("--port");
+            }
+            else if (arg == "--movies") cfg.movies = std::stoi(next());
+            else if (arg == "--cast") cfg.castSize = std::stoi(next());
+            else if (arg == "--crew") cfg.crewSize = std::stoi(next());
+            else if (arg == "--actors") cfg.actors = std::stoi(next());
+            else if (arg == "--hub") cfg.hubId = std::stoi(next());
+            else if (arg == "--seed") cfg.seed = static_cast<unsigned>(std::stoul(next()));
+            else if (arg == "--latency-ms") cfg.latencyMs = std::stoi(next());
+            else if (arg == "--jitter-ms") cfg.jitterMs = std::stoi(next());
+            else if (arg == "--error-rate") cfg.errorRate = std::stod(next());
+            else if (arg == "--fixtures") cfg.fixturesDir = next();
+            else if (arg == "--replay-only") cfg.replayOnly = true;
+            else { printUsage(); return arg == "--help" ? 0 : 1; }
+        } catch (const std::logic_error&) {   // stoi/stoul/stod: invalid_argument u out_of_range
+            std::cerr << "Valor no válido para " << arg << ": " << val << "\n";
+            printUsage();
+            return 1;
+        }
+    }
+
+    SyntheticWorld world(cfg);
+
+    int server = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (server < 0) {
+        std::cerr << "Error: no se pudo crear el socket: " << std::strerror(errno) << "\n";
+        return 1;
+    }
+    int yes = 1;
+    ::setsockopt(server, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(static_cast<uint16_t>(cfg.port));
+    if (::bind(server, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 || ::listen(server, 512) < 0) {
+        std::cerr << "Error: no se pudo escuchar en el puerto " << cfg.port << ": " << std::strerror(errno) << "\n";
+        return 1;
+    }
+
+    std::cout << "Mock TMDB escuchando en http://0.0.0.0:" << cfg.port << "/3 ("
+              << world.numMovies() << " películas, " << world.numActors() << " actores, latencia "
+              << cfg.latencyMs << "+" << cfg.jitterMs << " ms, errores " << cfg.errorRate * 100 << "%"
+              << (cfg.fixturesDir.empty() ? "" : ", fixtures: " + cfg.fixturesDir) << ")" << std::endl;
+
+    std::signal(SIGPIPE, SIG_IGN);
+    while (true) {
+        int client = ::accept(server, nullptr, nullptr);
+        if (client < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "accept: " << std::strerror(errno) << "\n";
+            break;
+        }
+        // Un hilo por conexión: el crawler limita la concurrencia con su semáforo
+        std::thread(handleClient, client, std::cref(cfg), std::cref(world)).detach();
+    }
+    ::close(server);
+    std::cout << "Solicitudes: " << g_requests << ", errores inyectados: " << g_errors << "\n";
+    return 0;
+}
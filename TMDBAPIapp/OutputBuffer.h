@@ -0,0 +1,151 @@
+// OutputBuffer.h
+#pragma once
+
+#include <array>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+// Escritura secuencial a archivo a través de un búfer grande preasignado: los datos se copian
+// al búfer y se vuelcan con un único fwrite (sin el búfer de stdio) cuando se llena.
+class OutputBuffer {
+public:
+    explicit OutputBuffer(const std::string& filename, size_t capacity = size_t(4) << 20)
+        : file(std::fopen(filename.c_str(), "wb")), buffer(capacity) {
+        if (file) std::setvbuf(file, nullptr, _IONBF, 0);
+    }
+    ~OutputBuffer() { close(); }
+    OutputBuffer(const OutputBuffer&) = delete;
+    OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+    bool isOpen() const { return file != nullptr; }
+
+    void write(const char* data, size_t size) {
+        if (size > buffer.size() - used) {
+            flush();
+            if (size > buffer.size()) {
+                writeFile(data, size);
+                return;
+            }
+        }
+        std::memcpy(buffer.data() + used, data, size);
+        used += size;
+    }
+
+    OutputBuffer& operator<<(std::string_view s) {
+        write(s.data(), s.size());
+        return *this;
+    }
+    OutputBuffer& operator<<(const char* s) { return *this << std::string_view(s); }
+    OutputBuffer& operator<<(char c) {
+        if (used == buffer.size()) flush();
+        buffer[used++] = c;
+        return *this;
+    }
+    // Números con std::to_chars (enteros exactos; reales con la representación más corta)
+    template <class T, std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, char> && !std::is_same_v<T, bool>, int> = 0>
+    OutputBuffer& operator<<(T value) {
+        if (buffer.size() - used < 32) flush();
+        auto result = std::to_chars(buffer.data() + used, buffer.data() + buffer.size(), value);
+        used = static_cast<size_t>(result.ptr - buffer.data());
+        return *this;
+    }
+
+    // Valor en binario (representación en memoria, little-endian en x86/ARM)
+    template <class T>
+    void writeRaw(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+    template <class T>
+    void writeRaw(const std::vector<T>& values) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+    }
+
+    // Escribe s escapando en una sola pasada: los tramos sin caracteres especiales se copian
+    // de una vez. Escape{}(c) devuelve nullptr si c se conserva, o su sustitución ("" = se omite);
+    // se tabula una sola vez por tipo para que el recorrido sea una consulta por carácter.
+    template <class Escape>
+    void writeEscaped(std::string_view s, Escape escape) {
+        static const std::array<bool, 256> special = [] {
+            std::array<bool, 256> table{};
+            for (int c = 0; c < 256; ++c) table[c] = Escape{}(static_cast<char>(c)) != nullptr;
+            return table;
+        }();
+        size_t start = 0;
+        for (size_t i = 0; i < s.size(); ++i) {
+            if (!special[static_cast<unsigned char>(s[i])]) continue;
+            write(s.data() + start, i - start);
+            *this << std::string_view(escape(s[i]));
+            start = i + 1;
+        }
+        write(s.data() + start, s.size() - start);
+    }
+
+    // Vuelca el búfer al archivo
+    void flush() {
+        if (used > 0) writeFile(buffer.data(), used);
+        used = 0;
+    }
+
+    // Vuelca y cierra; devuelve false si hubo algún error de escritura
+    bool close() {
+        if (!file) return false;
+        flush();
+        bool ok = !failed && std::fclose(file) == 0;
+        file = nullptr;
+        return ok;
+    }
+
+private:
+    std::FILE* file;
+    std::vector<char> buffer;
+    size_t used = 0;
+    bool failed = false;
+
+    void writeFile(const char* data, size_t size) {
+        if (file && std::fwrite(data, 1, size, file) != size) failed = true;
+    }
+};
+
+// Igual que OutputBuffer::writeEscaped, pero agregando a un std::string
+template <class Escape>
+void appendEscaped(std::string& out, std::string_view s, Escape escape) {
+    for (char c : s) {
+        if (const char* r = escape(c)) out += r;
+        else out += c;
+    }
+}
+
+// Sustituciones para OutputBuffer::writeEscaped dentro de cadenas DOT entre comillas
+struct DotEscape {
+    const char* operator()(char c) const {
+        switch (c) {
+            case '"': return "\\\"";
+            case '\\': return "\\\\";
+            case '\n': return "\\n";
+            case '\r': return "";
+            default: return nullptr;
+        }
+    }
+};
+
+// Sustituciones para texto y atributos XML (se omiten los caracteres de control no válidos)
+struct XmlEscape {
+    const char* operator()(char c) const {
+        switch (c) {
+            case '&': return "&amp;";
+            case '<': return "&lt;";
+            case '>': return "&gt;";
+            case '"': return "&quot;";
+            case '\'': return "&apos;";
+            case '\t': case '\n': case '\r': return nullptr;
+            default: return static_cast<unsigned char>(c) < 0x20 ? "" : nullptr;
+        }
+    }
+};
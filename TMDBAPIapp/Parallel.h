@@ -0,0 +1,68 @@
+// Parallel.h
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Número de hilos por defecto (al menos 1)
+inline unsigned defaultThreadCount() {
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// Primera excepción lanzada en los hilos de trabajo; se relanza tras el join (una excepción
+// que sale de un std::thread llamaría a std::terminate)
+class WorkerError {
+public:
+    void capture() {
+        std::lock_guard<std::mutex> guard(lock_);
+        if (!error_) error_ = std::current_exception();
+        failed_ = true;
+    }
+    bool failed() const { return failed_.load(std::memory_order_relaxed); }
+    void rethrow() const {
+        if (error_) std::rethrow_exception(error_);
+    }
+
+private:
+    std::mutex lock_;
+    std::exception_ptr error_;
+    std::atomic<bool> failed_{false};
+};
+
+// Ejecuta fn(i) para cada i en [0, n) repartiendo bloques de `grain` índices
+// dinámicamente entre `threads` hilos (el hilo llamador también trabaja). Si fn lanza, los
+// demás hilos dejan de tomar bloques y la primera excepción se relanza aquí.
+template <class F>
+void parallelFor(size_t n, unsigned threads, F&& fn, size_t grain = 1) {
+    if (n == 0) return;
+    grain = std::max<size_t>(1, grain);
+    threads = std::max(1u, std::min<unsigned>(threads, static_cast<unsigned>((n + grain - 1) / grain)));
+    if (threads == 1) {
+        for (size_t i = 0; i < n; ++i) fn(i);
+        return;
+    }
+    std::atomic<size_t> next{0};
+    WorkerError error;
+    auto worker = [&]() {
+        try {
+            for (size_t begin; (begin = next.fetch_add(grain)) < n;) {
+                size_t end = std::min(n, begin + grain);
+                for (size_t i = begin; i < end; ++i) fn(i);
+            }
+        } catch (...) {
+            error.capture();
+            next = n;   // Los demás hilos terminan su bloque y salen
+        }
+    };
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker);
+    worker();
+    for (std::thread& t : pool) t.join();
+    error.rethrow();
+}
@@ -1,11 +1,13 @@
 #include "TMDBAPIUtils.h"
 
+#include "CreditsParser.h"
+
 #include <cpr/cpr.h>
-#include <nlohmann/json.hpp>
 #include <iostream>
 #include <sstream>
-// Para simplificar el uso de nlohmann::json
-using json = nlohmann::json;
+#include <fstream>
+#include <filesystem>
+#include <cstdlib>
 
 // Construye la URL completa para una solicitud a la API
 std::string TMDBAPIUtils::buildURL(const std::string& endpoint, const std::string& query) {
@@ -17,75 +19,75 @@ std::string TMDBAPIUtils::buildURL(const std::string& endpoint, const std::strin
     return oss.str();
 }
 
+void TMDBAPIUtils::setAPIKey(const std::string& key) { api_key = key; }
+void TMDBAPIUtils::setBaseURL(const std::string& url) { base_url = url; }
+void TMDBAPIUtils::setRecordDir(const std::string& dir) { record_dir = dir; }
+const std::string& TMDBAPIUtils::apiKey() { return api_key; }
+const std::string& TMDBAPIUtils::baseURL() { return base_url; }
+
+// Lee la configuración de la API desde variables de entorno
+void TMDBAPIUtils::configureFromEnv() {
+    if (const char* key = std::getenv("TMDB_API_KEY")) setAPIKey(key);
+    if (const char* url = std::getenv("TMDB_BASE_URL")) setBaseURL(url);
+    if (const char* dir = std::getenv("TMDB_RECORD_DIR")) setRecordDir(dir);
+}
+
+// Realiza la solicitud GET y, si está activo, graba la respuesta como fixture
+long TMDBAPIUtils::fetch(const std::string& endpoint, std::string& body) {
+    cpr::Response r = cpr::Get(cpr::Url{buildURL(endpoint)});
+    if (r.status_code == 200 && !record_dir.empty()) {
+        std::filesystem::path file = std::filesystem::path(record_dir) / (endpoint.substr(1) + ".json");
+        std::error_code ec;
+        std::filesystem::create_directories(file.parent_path(), ec);
+        std::ofstream out(file, std::ios::binary);
+        if (out.is_open()) {
+            out << r.text;
+        } else {
+            std::cerr << "No se pudo grabar la respuesta en " << file << std::endl;
+        }
+    }
+    body = std::move(r.text);
+    return r.status_code;
+}
+
 // Obtiene películas en las que participó un actor en un rango de fechas
-std::vector<MovieData> TMDBAPIUtils::getMoviesForActor(int personId, int startYear, int endYear) {
+std::vector<MovieData> TMDBAPIUtils::getMoviesForActor(int personId, int startYear, int endYear, bool* ok) {
     std::vector<MovieData> movies;
     std::string endpoint = "/person/" + std::to_string(personId) + "/movie_credits";
-    std::string url = buildURL(endpoint);
 
     // Realizar la solicitud GET
-    cpr::Response r = cpr::Get(cpr::Url{url});
-    if (r.status_code != 200) {
-        std::cerr << "Error al obtener películas del actor. Código: " << r.status_code << std::endl;
+    std::string body;
+    long status = fetch(endpoint, body);
+    if (ok) *ok = status == 200;
+    if (status != 200) {
+        std::cerr << "Error al obtener películas del actor. Código: " << status << std::endl;
         return movies;
     }
 
-    // Parsear la respuesta JSON
-    json j = json::parse(r.text);
-    // Recorrer las películas y filtrar por rango de años
-    for (const auto& item : j["cast"]) {
-        if (!item.contains("release_date") || !item["release_date"].is_string()) continue;
-
-        std::string release_date = item["release_date"];
-        if (release_date.length() < 4) continue;
-
-        int year = 0;
-        // Extraer el año de la fecha de lanzamiento
-        try {
-            year = std::stoi(release_date.substr(0, 4));
-        } catch (const std::exception& e) {
-            std::cerr << "Error parsing year from release_date: '" << release_date << "' - " << e.what() << std::endl;
-            continue;
-        }
-        // Filtrar por rango de años
-        if (year >= startYear && year <= endYear) {
-            movies.push_back(MovieData{
-                item["id"].get<int>(),
-                year,
-                item["title"].get<std::string>(),
-                release_date
-            });
-        }
-    }
+    // Extraer solo los campos necesarios (SAX, sin construir el DOM) y filtrar por rango de años
+    movies = parseMovieCredits(body, startYear, endYear);
     return movies;
 }
 
 // Obtiene el elenco de una película
 std::vector<ActorData> TMDBAPIUtils::getMovieCast(int movieId, int limit, const std::vector<int>& excludeIds) {
+    return getMovieCast(movieId, limit, std::unordered_set<int>(excludeIds.begin(), excludeIds.end()));
+}
+
+// Obtiene el elenco de una película (exclusión por tabla hash)
+std::vector<ActorData> TMDBAPIUtils::getMovieCast(int movieId, int limit, const std::unordered_set<int>& excludeIds) {
     std::vector<ActorData> cast; // Vector para almacenar el elenco
     std::string endpoint = "/movie/" + std::to_string(movieId) + "/credits"; // Endpoint de la API para obtener créditos de la película
-    std::string url = buildURL(endpoint); // Construir la URL completa
 
     // Realizar la solicitud GET
-    cpr::Response r = cpr::Get(cpr::Url{url});
-    if (r.status_code != 200) {
-        std::cerr << "Error al obtener elenco de la película. Código: " << r.status_code << std::endl;
+    std::string body;
+    long status = fetch(endpoint, body);
+    if (status != 200) {
+        std::cerr << "Error al obtener elenco de la película. Código: " << status << std::endl;
         return cast;
     }
 
-    // Parsear la respuesta JSON
-    json j = json::parse(r.text);
-    // Recorrer el elenco y agregar actores al vector
-    for (const auto& member : j["cast"]) {
-        if (member["order"] >= limit) continue; // Limitar al número especificado
-        int id = member["id"];
-        if (std::find(excludeIds.begin(), excludeIds.end(), id) != excludeIds.end()) continue; // Excluir IDs especificados
-
-        // Agregar actor al elenco
-        cast.push_back(ActorData{
-            id,
-            member["name"]
-        });
-    }
+    // Extraer id/name de los miembros con order < limit que no estén excluidos
+    cast = parseMovieCast(body, limit, excludeIds);
     return cast;
-}
\ No newline at end of file
+}
@@ -2,6 +2,7 @@
 
 #include <string>
 #include <vector>
+#include <unordered_set>
 
 // Estructura para datos de películas
 struct MovieData {
@@ -19,17 +20,36 @@ struct ActorData {
 
 class TMDBAPIUtils {
 public:
-    // Obtiene películas en las que participó un actor en un rango de fechas
-    static std::vector<MovieData> getMoviesForActor(int personId, int startYear, int endYear);
+    // Obtiene películas en las que participó un actor en un rango de fechas; si ok no es nulo,
+    // indica si la solicitud respondió 200 (una lista vacía también puede ser un éxito)
+    static std::vector<MovieData> getMoviesForActor(int personId, int startYear, int endYear, bool* ok = nullptr);
 
     // Obtiene el elenco de una película
     static std::vector<ActorData> getMovieCast(int movieId, int limit = 10, const std::vector<int>& excludeIds = {});
+    static std::vector<ActorData> getMovieCast(int movieId, int limit, const std::unordered_set<int>& excludeIds);
+
+    // Configuración de la API (llamar antes de lanzar hilos)
+    static void setAPIKey(const std::string& key);
+    static void setBaseURL(const std::string& url);
+    // Si no está vacío, guarda cada respuesta 200 en <dir>/<endpoint>.json (fixtures para el servidor mock)
+    static void setRecordDir(const std::string& dir);
+    // Lee TMDB_API_KEY, TMDB_BASE_URL y TMDB_RECORD_DIR del entorno
+    static void configureFromEnv();
+
+    static const std::string& apiKey();
+    static const std::string& baseURL();
+
+    static constexpr const char* default_base_url = "https://api.themoviedb.org/3";
 
 private:
-    // Clave de API y URL base de TMDB
-    static constexpr const char* api_key = "a1bb56cdefd8d5a9d0eb8c4928eb530d";
-    static constexpr const char* base_url = "https://api.themoviedb.org/3";
+    // Clave de API, URL base y carpeta de grabación (vacía = no grabar)
+    static inline std::string api_key;
+    static inline std::string base_url = default_base_url;
+    static inline std::string record_dir;
 
     // Construye la URL completa para una solicitud a la API
     static std::string buildURL(const std::string& endpoint, const std::string& query = "");
-};
\ No newline at end of file
+
+    // Realiza un GET al endpoint; devuelve el código HTTP y deja el cuerpo en body
+    static long fetch(const std::string& endpoint, std::string& body);
+};
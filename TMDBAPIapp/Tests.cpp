@@ -0,0 +1,97 @@
+// Pruebas de regresión del grafo y del parseo de créditos (sin la API): cada caso imprime sus
+// fallos y el programa termina con código 1 si alguno falla.
+// Uso: tests
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include "Graph.h"
+#include "GraphBuilder.h"
+#include "CreditsParser.h"
+
+static int g_failures = 0;
+
+#define CHECK(cond)                                                                      \
+    do {                                                                                 \
+        if (!(cond)) {                                                                   \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": falló " #cond << "\n";        \
+            ++g_failures;                                                                \
+        }                                                                                \
+    } while (0)
+
+// Dos películas distintas con el mismo título y año (p. ej. un remake) cuentan por separado:
+// la identidad de la película es su id TMDB, no (título, año)
+static void testSameTitleSameYear() {
+    // Grafo mutable + freeze
+    Graph graph;
+    graph.addActor(1, "Ana");
+    graph.addActor(2, "Beto");
+    graph.addCollaboration(1, 2, 100, "Hamlet", 1990);
+    graph.addCollaboration(1, 2, 200, "Hamlet", 1990);
+    graph.addCollaboration(1, 2, 100, "Hamlet", 1990); // misma película repetida
+    CHECK(graph.collaborationCount(1, 2) == 2);
+    graph.freeze();
+    CHECK(graph.numMovies() == 2);
+    CHECK(graph.collaborationCount(1, 2) == 2);
+
+    // GraphBuilder: la misma película llega desde dos búferes y el remake desde un tercero
+    Graph built;
+    GraphBuilder builder(2);
+    builder.createBuffer().addCast({1, 2, 3}, 100, "Hamlet", 1990);
+    builder.createBuffer().addCast({2, 1}, 100, "Hamlet", 1990);
+    builder.createBuffer().addCast({1, 2}, 200, "Hamlet", 1990);
+    builder.buildInto(built);
+    CHECK(built.numMovies() == 2);
+    CHECK(built.collaborationCount(1, 2) == 2);
+    CHECK(built.collaborationCount(1, 3) == 1);
+    uint32_t e = built.findEdge(built.indexOf(1), built.indexOf(2));
+    CHECK(e != Graph::npos);
+    if (e != Graph::npos) {
+        std::span<const uint32_t> history = built.edgeMovies(e);
+        CHECK(history.size() == 2);
+        if (history.size() == 2) {
+            CHECK(built.movieId(history[0]) == 100 && built.movieId(history[1]) == 200);
+            CHECK(built.movieTitle(history[0]) == "Hamlet" && built.movieYear(history[1]) == 1990);
+        }
+    }
+
+    // Fusión incremental sobre el grafo congelado y viaje de ida y vuelta por un snapshot
+    GraphBuilder more(2);
+    more.createBuffer().addCast({1, 2}, 200, "Hamlet", 1990);
+    more.createBuffer().addCast({1, 2}, 300, "Hamlet", 1990);
+    more.buildInto(built);
+    CHECK(built.collaborationCount(1, 2) == 3);
+    const std::string file = "tests-snapshot.bin";
+    CHECK(built.save(file));
+    Graph loaded;
+    CHECK(loaded.load(file));
+    CHECK(loaded.numMovies() == 3 && loaded.collaborationCount(1, 2) == 3);
+    std::remove(file.c_str());
+}
+
+// El parser SAX del elenco conserva, como el DOM anterior, los miembros sin "order": el
+// límite solo se aplica a los que lo traen
+static void testCastWithoutOrder() {
+    const std::string body = R"({"id":603,"cast":[)"
+        R"({"id":1,"name":"Ana","order":0},)"
+        R"({"id":2,"name":"Beto"},)"
+        R"({"id":3,"name":"Cata","order":7},)"
+        R"({"id":4,"name":"Dani","order":1}],"crew":[{"id":5,"name":"Eva"}]})";
+    std::vector<ActorData> cast = parseMovieCast(body, 5, {4});
+    CHECK(cast.size() == 2);
+    if (cast.size() == 2) {
+        CHECK(cast[0].id == 1 && cast[0].name == "Ana");
+        CHECK(cast[1].id == 2 && cast[1].name == "Beto");
+    }
+}
+
+int main() {
+    testSameTitleSameYear();
+    testCastWithoutOrder();
+    if (g_failures) {
+        std::cerr << g_failures << " comprobaciones fallidas\n";
+        return 1;
+    }
+    std::cout << "OK\n";
+    return 0;
+}
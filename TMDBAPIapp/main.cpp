@@ -1,112 +1,179 @@
 #include <iostream>
 #include <vector>
 #include <string>
-#include <thread>
-#include <mutex>
 #include <cstdlib>
-#include <semaphore>       // C++20: std::counting_semaphore
+#include <algorithm>
+#include <numeric>
+#include <chrono>
 #include "TMDBAPIUtils.h"  // (Interfaz para la API de TMDB)
 #include "Graph.h"         // (Interfaz para la representación del grafo)
+#include "Crawler.h"       // (Recorrido concurrente de la filmografía)
+#include "GraphAnalytics.h" // (Métricas del grafo: grados, componentes, centralidades)
+#include "Communities.h"    // (Comunidades de Louvain y grafo resumen)
+#include "ForceLayout.h"    // (Disposición de fuerzas y exportación SVG)
+#include "GraphExport.h"    // (Exportación GraphML y lista de aristas binaria)
+
+// A partir de este tamaño las centralidades se aproximan con orígenes muestreados
+constexpr size_t exactMetricsLimit = 5000;
+constexpr size_t metricSamples = 512;
+
+int main(int argc, char* argv[]) {
+    // Opcional: --separacion ID1 ID2 para calcular los grados de separación entre dos actores;
+    // --snapshot RUTA para elegir el snapshot del recorrido y --desde-cero para ignorarlo
+    int separationFrom = 0, separationTo = 0;
+    std::string snapshotFile = "colaboraciones.snapshot";
+    bool fromScratch = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--separacion" && i + 2 < argc) {
+            separationFrom = std::atoi(argv[i + 1]);
+            separationTo = std::atoi(argv[i + 2]);
+        } else if (arg == "--snapshot" && i + 1 < argc) {
+            snapshotFile = argv[i + 1];
+        } else if (arg == "--desde-cero") {
+            fromScratch = true;
+        }
+    }
+
+    // Configuración de la API desde el entorno (TMDB_API_KEY, TMDB_BASE_URL, TMDB_RECORD_DIR)
+    TMDBAPIUtils::configureFromEnv();
+    if (TMDBAPIUtils::apiKey().empty() && TMDBAPIUtils::baseURL() == TMDBAPIUtils::default_base_url) {
+        std::cerr << "Error: defina TMDB_API_KEY (o TMDB_BASE_URL apuntando al servidor mock).\n";
+        return 1;
+    }
 
-int main() {
     // 1. Inicialización: especificar actor principal y rango de años
-    int mainActorId = 6384;                  // ID de Keanu Reeves en TMDB
-    std::string mainActorName = "Keanu Reeves";
-    int startYear = 1985, endYear = 2023;    // Rango de años a considerar
+    CrawlConfig cfg;
+    cfg.mainActorId = 6384;                  // ID de Keanu Reeves en TMDB
+    cfg.mainActorName = "Keanu Reeves";
+    cfg.startYear = 1985;                    // Rango de años a considerar
+    cfg.endYear = 2023;
+    cfg.maxConcurrentCalls = 5;              // Límite de llamadas simultáneas a la API
 
-    std::cout << "Construyendo grafo de colaboraciones para " 
-              << mainActorName << " (" << startYear << "-" << endYear << ")...\n";
+    std::cout << "Construyendo grafo de colaboraciones para "
+              << cfg.mainActorName << " (" << cfg.startYear << "-" << cfg.endYear << ")...\n";
 
-    // Crear instancia del grafo de colaboraciones
+    // 2. Snapshot de una ejecución anterior: se mapea en memoria y solo se piden las películas
+    //    que aún no cubre. Se descarta si es de otro actor o de un rango de años más amplio.
     Graph graph;
-    // Agregar el actor principal al grafo como nodo inicial
-    graph.addActor(mainActorId, mainActorName);
-
-    // 2. Obtener la lista de películas del actor principal en el rango dado
-    //    (Función implementada en TMDBAPIUtils; devuelve, por ejemplo, vector de películas con id, título y año)
-    std::vector<MovieData> filmography = TMDBAPIUtils::getMoviesForActor(mainActorId, startYear, endYear);
-    // MovieData es una estructura definida en TMDBAPIUtils que contiene al menos:
-    //    - id (int): ID de la película en TMDB
-    //    - title (std::string): título de la película
-    //    - year (int): año de estreno de la película
-
-    // Semáforo para limitar a 5 las llamadas simultáneas a la API (por ejemplo)
-    const int MAX_CONCURRENT_CALLS = 5;
-    std::counting_semaphore<MAX_CONCURRENT_CALLS> apiSemaphore(MAX_CONCURRENT_CALLS);
-
-    // Mutex para proteger el acceso concurrente al grafo
-    std::mutex graphMutex;
-
-    // 3. Recorrer cada película de la filmografía y lanzar un hilo para obtener su elenco
-    std::vector<std::thread> threads;
-    for (const MovieData& movie : filmography) {
-        // Adquirir semáforo antes de lanzar un nuevo hilo (limita las llamadas concurrentes)
-        apiSemaphore.acquire();
-        // Copiar datos necesarios para el hilo (para evitar capturas por referencia inválidas)
-        int movieId = movie.id;
-        std::string movieTitle = movie.title;
-        int movieYear = movie.year;
-
-        // Lanzar thread para obtener el elenco de la película
-        threads.emplace_back([&, movieId, movieTitle, movieYear]() {
-            // 4. Dentro del hilo: obtener el reparto completo de la película usando TMDBAPIUtils
-            std::vector<ActorData> cast = TMDBAPIUtils::getMovieCast(movieId);
-            // ActorData es una estructura definida en TMDBAPIUtils que contiene al menos:
-            //    - id (int): ID del actor en TMDB
-            //    - name (std::string): nombre del actor
-
-            // Bloquear el mutex antes de modificar el grafo compartido
-            std::lock_guard<std::mutex> lock(graphMutex);
-            // Agregar todos los actores de este reparto al grafo (nodos)
-            for (const ActorData& actor : cast) {
-                graph.addActor(actor.id, actor.name);
-            }
-            // Agregar aristas de colaboración entre cada par de actores de este reparto
-            // (Esto incluye al actor principal, que también debería estar en `cast`)
-            size_t n = cast.size();
-            for (size_t i = 0; i < n; ++i) {
-                for (size_t j = i + 1; j < n; ++j) {
-                    int actorId1 = cast[i].id;
-                    int actorId2 = cast[j].id;
-                    // Registrar colaboración entre actorId1 y actorId2 en esta película
-                    graph.addCollaboration(actorId1, actorId2, movieTitle, movieYear);
-                }
+    CrawlMetadata meta;
+    if (!fromScratch) {
+        auto t0 = std::chrono::steady_clock::now();
+        if (graph.map(snapshotFile, &meta)) {
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+            if (meta.mainActorId != cfg.mainActorId || meta.startYear < cfg.startYear || meta.endYear > cfg.endYear) {
+                std::cout << "Snapshot " << snapshotFile << " de otro recorrido; se descarta.\n";
+                graph = Graph();
+                meta = CrawlMetadata();
+            } else {
+                std::cout << "Snapshot cargado de " << snapshotFile << " en " << ms << " ms: " << graph.numActors()
+                          << " actores, " << meta.fetchedMovies.size() << " películas ya recorridas\n";
             }
-            // Al salir del bloque, lock_guard libera el mutex automáticamente
-
-            // Liberar el semáforo para permitir que otro hilo inicie su llamada a la API
-            apiSemaphore.release();
-        });
-    }
-
-    // Esperar a que todos los threads terminen (join)
-    for (std::thread& t : threads) {
-        if (t.joinable()) {
-            t.join();
         }
     }
 
+    // 3-4. Obtener la filmografía y, en hilos, el elenco de cada película pendiente
+    //      (el grafo resultante queda congelado en la representación CSR compacta)
+    CrawlStats stats = crawlCollaborations(cfg, graph, &meta);
+
     // 5. (Después de threads) Ahora el grafo contiene todos los actores y colaboraciones recopiladas.
-    std::cout << "Películas procesadas: " << filmography.size() << ". ";
-    std::cout << "Total de actores en grafo: " << graph.numActors() 
+    std::cout << "Películas procesadas: " << stats.moviesProcessed << " (" << stats.moviesSkipped
+              << " ya en el snapshot). ";
+    std::cout << "Total de actores en grafo: " << graph.numActors()
               << ", colaboraciones: " << graph.numCollaborations() << std::endl;
+    if (graph.save(snapshotFile, meta)) {
+        std::cout << "Snapshot guardado en " << snapshotFile << "\n";
+    } else {
+        std::cerr << "Error: no se pudo guardar el snapshot " << snapshotFile << "\n";
+    }
 
-    // 6. Exportar el grafo a un archivo DOT para visualización con Graphviz
-    std::string outputFile = "colaboraciones.dot";
-    if (graph.exportToDot(outputFile)) {
-        std::cout << "Grafo exportado a " << outputFile 
-              << ". Generando imagen SVG con Graphviz...\n";
-              
-        // Ejecutar comando de sistema para generar SVG usando Graphviz
-        int result = std::system("dot -Tsvg colaboraciones.dot -o grafo.svg");
-        if (result == 0) {
-            std::cout << "Imagen generada exitosamente: grafo.svg\n";
+    // 6. Métricas del grafo (exactas en grafos pequeños, muestreadas en grandes)
+    CentralityOptions metricOpts;
+    if (graph.numActors() > exactMetricsLimit) metricOpts.samples = metricSamples;
+    GraphMetrics metrics = computeMetrics(graph, metricOpts);
+    std::cout << "Componentes conexas: " << metrics.components.sizes.size()
+              << ", grado medio: " << metrics.degrees.meanDegree
+              << ", grado máximo: " << metrics.degrees.maxDegree
+              << (metrics.sampled ? " (centralidades aproximadas)" : "") << "\n";
+
+    // Actores más centrales por intermediación
+    std::vector<uint32_t> ranking(graph.numActors());
+    std::iota(ranking.begin(), ranking.end(), 0u);
+    size_t top = std::min<size_t>(5, ranking.size());
+    std::partial_sort(ranking.begin(), ranking.begin() + top, ranking.end(),
+                      [&](uint32_t a, uint32_t b) { return metrics.betweenness[a] > metrics.betweenness[b]; });
+    for (size_t i = 0; i < top; ++i) {
+        uint32_t u = ranking[i];
+        std::cout << "  " << graph.actorName(u) << " (" << graph.actorId(u) << "): intermediación "
+                  << metrics.betweenness[u] << ", cercanía " << metrics.closeness[u] << "\n";
+    }
+    // Colaboradores más frecuentes del actor principal (según el historial de películas)
+    uint32_t mainIndex = graph.indexOf(cfg.mainActorId);
+    if (mainIndex != Graph::npos) {
+        std::cout << "Colaboradores más frecuentes de " << cfg.mainActorName << ":";
+        for (const Collaborator& c : topCollaborators(graph, mainIndex, 5)) {
+            std::cout << " " << graph.actorName(c.node) << " (" << c.movies << ")";
+        }
+        std::cout << "\n";
+    }
+    if (writeMetricsCSV(graph, metrics, "analisis.csv") && writeMetricsJSON(graph, metrics, "analisis.json")) {
+        std::cout << "Métricas exportadas a analisis.csv y analisis.json\n";
+    } else {
+        std::cerr << "Error: no se pudieron exportar las métricas.\n";
+    }
+
+    if (separationFrom != 0) {
+        std::vector<int> path = degreesOfSeparation(graph, separationFrom, separationTo);
+        if (path.empty()) {
+            std::cout << "No hay camino entre " << separationFrom << " y " << separationTo << "\n";
         } else {
-            std::cerr << "Error al ejecutar Graphviz (dot). Código: " << result << "\n";
+            std::cout << "Grados de separación entre " << separationFrom << " y " << separationTo << ": " << path.size() - 1 << " (";
+            for (size_t i = 0; i < path.size(); ++i) {
+                std::cout << (i ? " -> " : "") << graph.actorName(graph.indexOf(path[i]));
+            }
+            std::cout << ")\n";
         }
+    }
+
+    // 7. Comunidades (Louvain ponderado por películas compartidas) y grafo resumen
+    Communities communities = detectCommunities(graph);
+    std::cout << "Comunidades: " << communities.sizes.size() << " (modularidad " << communities.modularity << ")\n";
+    CommunitySummary summary = summarizeCommunities(graph, communities);
+    if (exportCommunityDot(graph, summary, "comunidades.dot")) {
+        std::cout << "Grafo de comunidades exportado a comunidades.dot\n";
+    }
+
+    // 8. Disposición de fuerzas propia y dibujo SVG (sin lanzar Graphviz)
+    Layout layout = computeLayout(graph);
+    SvgOptions svg;
+    svg.colorGroup = communities.communityOf;
+    if (writeSVG(graph, layout, "grafo.svg", svg)) {
+        std::cout << "Imagen generada exitosamente: grafo.svg\n";
+    } else {
+        std::cerr << "Error: no se pudo escribir grafo.svg\n";
+    }
+
+    // 9. Exportar el grafo (agrupado por comunidad, con las métricas y la posición de cada
+    //    nodo como atributos) a DOT; `neato -n2` lo dibuja respetando esas posiciones
+    Graph::NodeAttributes attrs = metricsToDotAttributes(graph, metrics);
+    Graph::NodeAttributes positions = layoutToDotAttributes(layout, svg.size);
+    for (uint32_t u = 0; u < graph.numActors(); ++u) {
+        attrs[u].emplace_back("community", std::to_string(communities.communityOf[u]));
+        attrs[u].push_back(std::move(positions[u].front()));
+    }
+    std::string outputFile = "colaboraciones.dot";
+    if (graph.exportClusteredDot(outputFile, communities.communityOf, attrs)) {
+        std::cout << "Grafo exportado a " << outputFile << " (neato -n2 -Tpng " << outputFile << " -o grafo.png)\n";
     } else {
         std::cerr << "Error: no se pudo exportar el grafo a DOT.\n";
     }
 
+    // 10. Formatos para otras herramientas: GraphML (con los mismos atributos) y lista binaria
+    if (exportGraphML(graph, "colaboraciones.graphml", &attrs) && exportEdgeList(graph, "colaboraciones.edges")) {
+        std::cout << "Grafo exportado también a colaboraciones.graphml y colaboraciones.edges\n";
+    } else {
+        std::cerr << "Error: no se pudo exportar a GraphML o a la lista binaria.\n";
+    }
+
     return 0;
-}
\ No newline at end of file
+}
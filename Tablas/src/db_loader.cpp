@@ -1,4 +1,6 @@
 #include "db_loader.h"
+#include "parallel.h"
+#include "shard_manifest.h"
 #include <filesystem>
 #include <fstream>
 #include <sstream>
@@ -7,13 +9,15 @@
 #include <thread>
 #include <semaphore>
 #include <regex>
+#include <map>
+#include <unordered_map>
 
 using namespace std;
 namespace fs = std::filesystem;
 
 vector<string> parse_csv_line(const string& line) {
     vector<string> result;
-    regex csv_re(R"((?:^|,)(\"(?:[^\"]|\"\")*\"|[^,]*))");
+    static const regex csv_re(R"((?:^|,)(\"(?:[^\"]|\"\")*\"|[^,]*))");   // se compila una vez
     auto begin = sregex_iterator(line.begin(), line.end(), csv_re);
     auto end = sregex_iterator();
 
@@ -55,7 +59,7 @@ DbLoader::DbLoader(const DbConfig& cfg): cfg_(cfg) {
 DbLoader::~DbLoader(){ if(db_) sqlite3_close(db_); }
 
 
-void DbLoader::init_schema(){
+static void create_schema(sqlite3* db){
     const string incidents = R"SQL(
         CREATE TABLE IF NOT EXISTS incidents (
             report_id TEXT PRIMARY KEY,
@@ -91,18 +95,27 @@ void DbLoader::init_schema(){
     )SQL";
 
 
-    exec_sql(db_, incidents);
-    exec_sql(db_, details);
-    exec_sql(db_, outcomes);
+    exec_sql(db, incidents);
+    exec_sql(db, details);
+    exec_sql(db, outcomes);
 }
 
-static void bulk_insert_from_csv(sqlite3* db, const fs::path& file, const string& table, const vector<string>& cols){
-    ifstream in(file);
-    if(!in.is_open()) throw runtime_error("No se pudo abrir: " + file.string());
+void DbLoader::init_schema(){
+    create_schema(db_);
+}
 
-    string line; // Leer encabezado y descartarlo
-    if(!getline(in, line)) return;
+static const vector<string> incident_cols = {"report_id","category","date"};
+static const vector<string> detail_cols = {"report_id","subject","transport_mode","detection"};
+static const vector<string> outcome_cols = {"report_id","outcome","num_ppl_fined","fine","num_ppl_arrested","prison_time","prison_time_unit"};
+
+// Limpieza de texto: sin \r \n \t ni espacios en los extremos
+static string clean_text(const string& val){
+    static const regex controls(R"([\r\n\t])"), edges(R"(^\s+|\s+$)");
+    return regex_replace(regex_replace(val, controls, ""), edges, "");
+}
 
+// INSERT OR IGNORE preparado para las columnas dadas
+static sqlite3_stmt* prepare_insert(sqlite3* db, const string& table, const vector<string>& cols){
     // Crear placeholders e instrucción SQL
     string placeholders;
     for (size_t i = 0; i < cols.size(); ++i) {
@@ -120,46 +133,60 @@ static void bulk_insert_from_csv(sqlite3* db, const fs::path& file, const string
     sqlite3_stmt* stmt = nullptr;
     if (sqlite3_prepare_v2(db, q.c_str(), -1, &stmt, nullptr) != SQLITE_OK)
         throw runtime_error(string("Prepare failed: ") + sqlite3_errmsg(db) + "\nSQL: " + q);
+    return stmt;
+}
 
-    exec_sql(db, "BEGIN TRANSACTION");
-
-    while (getline(in, line)) {
-        vector<string> fields = parse_csv_line(line);
-        if (fields.size() != cols.size()) {
-            fields.resize(cols.size()); // Rellenar si faltan
-        }
-
-        sqlite3_reset(stmt);
-        for (size_t i = 0; i < cols.size(); ++i) {
-            const string& val = fields[i];
-            int col_idx = static_cast<int>(i + 1);
+// Inserta una fila ya separada en campos: enteros, reales o texto limpio; vacío es NULL
+static void insert_fields(sqlite3* db, sqlite3_stmt* stmt, const string& table, vector<string> fields, size_t ncols){
+    if (fields.size() != ncols) {
+        fields.resize(ncols); // Rellenar si faltan
+    }
 
-            if (val.empty()) {
-                sqlite3_bind_null(stmt, col_idx);
+    sqlite3_reset(stmt);
+    for (size_t i = 0; i < ncols; ++i) {
+        const string& val = fields[i];
+        int col_idx = static_cast<int>(i + 1);
+
+        if (val.empty()) {
+            sqlite3_bind_null(stmt, col_idx);
+        } else {
+            // Si parece un entero
+            char* end = nullptr;
+            long lval = strtol(val.c_str(), &end, 10);
+            if (*end == '\0') {
+                sqlite3_bind_int64(stmt, col_idx, lval);
             } else {
-                // Si parece un entero
-                char* end = nullptr;
-                long lval = strtol(val.c_str(), &end, 10);
+                // Si parece un número real
+                double dval = strtod(val.c_str(), &end);
                 if (*end == '\0') {
-                    sqlite3_bind_int64(stmt, col_idx, lval);
+                    sqlite3_bind_double(stmt, col_idx, dval);
                 } else {
-                    // Si parece un número real
-                    double dval = strtod(val.c_str(), &end);
-                    if (*end == '\0') {
-                        sqlite3_bind_double(stmt, col_idx, dval);
-                    } else {
-                        // Si no es número, lo tratamos como texto
-                        string cleaned = regex_replace(val, regex(R"([\r\n\t])"), "");
-                        cleaned = regex_replace(cleaned, regex(R"(^\s+|\s+$)"), "");
-                        sqlite3_bind_text(stmt, col_idx, cleaned.c_str(), static_cast<int>(cleaned.size()), SQLITE_TRANSIENT);
-                    }
+                    // Si no es número, lo tratamos como texto
+                    string cleaned = clean_text(val);
+                    sqlite3_bind_text(stmt, col_idx, cleaned.c_str(), static_cast<int>(cleaned.size()), SQLITE_TRANSIENT);
                 }
             }
         }
+    }
 
-        if (sqlite3_step(stmt) != SQLITE_DONE) {
-            cerr << "Fila saltada en " << table << ": " << sqlite3_errmsg(db) << "\n";
-        }
+    if (sqlite3_step(stmt) != SQLITE_DONE) {
+        cerr << "Fila saltada en " << table << ": " << sqlite3_errmsg(db) << "\n";
+    }
+}
+
+static void bulk_insert_from_csv(sqlite3* db, const fs::path& file, const string& table, const vector<string>& cols){
+    ifstream in(file);
+    if(!in.is_open()) throw runtime_error("No se pudo abrir: " + file.string());
+
+    string line; // Leer encabezado y descartarlo
+    if(!getline(in, line)) return;
+
+    sqlite3_stmt* stmt = prepare_insert(db, table, cols);
+
+    exec_sql(db, "BEGIN TRANSACTION");
+
+    while (getline(in, line)) {
+        insert_fields(db, stmt, table, parse_csv_line(line), cols.size());
     }
 
     exec_sql(db, "COMMIT");
@@ -179,7 +206,7 @@ void DbLoader::load_incidents(){
         dbc,
         std::filesystem::path(cfg_.data_dir) / "incidents.csv",
         "incidents",
-        {"report_id","category","date"}
+        incident_cols
     );
 
     sqlite3_close(dbc);
@@ -198,7 +225,7 @@ void DbLoader::load_details(){
         dbc,
         std::filesystem::path(cfg_.data_dir) / "details.csv",
         "details",
-        {"report_id","subject","transport_mode","detection"}
+        detail_cols
     );
 
     sqlite3_close(dbc);
@@ -217,7 +244,7 @@ void DbLoader::load_outcomes(){
         dbc,
         std::filesystem::path(cfg_.data_dir) / "outcomes.csv",
         "outcomes",
-        {"report_id","outcome","num_ppl_fined","fine","num_ppl_arrested","prison_time","prison_time_unit"}
+        outcome_cols
     );
 
     sqlite3_close(dbc);
@@ -237,4 +264,132 @@ void DbLoader::load_all_csv_parallel(){
 
 
     t1.join(); t2.join(); t3.join();
-}
\ No newline at end of file
+}
+
+
+// Líneas de datos de un CSV (sin el encabezado), leídas igual que en la carga normal
+static vector<string> read_csv_lines(const fs::path& file){
+    ifstream in(file);
+    if(!in.is_open()) throw runtime_error("No se pudo abrir: " + file.string());
+    vector<string> lines;
+    string line;
+    if(!getline(in, line)) return lines;
+    while (getline(in, line)) lines.push_back(std::move(line));
+    return lines;
+}
+
+// Año de una fecha con el mismo criterio que las consultas (sin \r \n ni espacios y con forma
+// YYYY-MM-DD); 0 si no es válida
+static int shard_year(const string& date){
+    string d;
+    for (char c : date) if (c != '\r' && c != '\n' && c != ' ') d += c;
+    static const regex iso(R"([1-2][0-9]{3}-[0-1][0-9]-[0-3][0-9])");
+    return regex_match(d, iso) ? stoi(d.substr(0, 4)) : 0;
+}
+
+static string shard_file(int year){
+    return year ? "incidents_" + to_string(year) + ".db" : "incidents_sin_fecha.db";
+}
+
+// Tres fases: separar los campos de todas las líneas en paralelo, asignar cada fila al año del
+// incidente de su report_id (details y outcomes no tienen fecha) y escribir cada shard en su
+// propio archivo, varios a la vez. Todas las filas de un report_id quedan en el mismo shard, así
+// los JOIN por report_id se resuelven dentro de cada uno
+void DbLoader::load_year_shards(){
+    const fs::path data(cfg_.data_dir), dir(cfg_.shard_dir);
+    const unsigned threads = max(1u, cfg_.threads);
+
+    struct Table {
+        const char* name;
+        const vector<string>* cols;
+        vector<vector<string>> rows;
+    };
+    Table tables[] = {{"incidents", &incident_cols, {}},
+                      {"details", &detail_cols, {}},
+                      {"outcomes", &outcome_cols, {}}};
+
+    // 1. Parseo en paralelo por bloques de líneas
+    for (Table& t : tables) {
+        vector<string> lines = read_csv_lines(data / (string(t.name) + ".csv"));
+        t.rows.resize(lines.size());
+        const size_t block = 2048;
+        parallel_for((lines.size() + block - 1) / block, threads, [&](size_t b, unsigned) {
+            for (size_t i = b * block; i < min(lines.size(), (b + 1) * block); ++i) t.rows[i] = parse_csv_line(lines[i]);
+        });
+    }
+
+    // 2. Cada fila de incidents va al año de su propia fecha (limpia, como la guarda la base).
+    //    Igual que INSERT OR IGNORE en la base única, de cada report_id solo se conserva la
+    //    primera fila; las filas sin report_id se guardan como NULL y no chocan entre sí.
+    //    details y outcomes siguen al año del incidente que conservó su report_id.
+    struct Shard {
+        ShardInfo info;
+        vector<size_t> rows[3];   // índices de las filas de cada tabla
+    };
+    map<int, Shard> shards;
+    auto route = [&](size_t k, size_t i, int year) {
+        Shard& shard = shards[year];
+        shard.info.year = year;
+        shard.rows[k].push_back(i);
+    };
+    auto null_key = [](const vector<string>& r) { return r.empty() || r[0].empty(); };
+
+    unordered_map<string, int> year_of;
+    year_of.reserve(tables[0].rows.size());
+    for (size_t i = 0; i < tables[0].rows.size(); ++i) {
+        const auto& r = tables[0].rows[i];
+        const int year = r.size() > 2 ? shard_year(clean_text(r[2])) : 0;
+        if (null_key(r) || year_of.emplace(clean_text(r[0]), year).second) route(0, i, year);
+    }
+    for (size_t k = 1; k < 3; ++k) {
+        const auto& rows = tables[k].rows;
+        for (size_t i = 0; i < rows.size(); ++i) {
+            auto it = null_key(rows[i]) ? year_of.end() : year_of.find(clean_text(rows[i][0]));
+            route(k, i, it == year_of.end() ? 0 : it->second);
+        }
+    }
+
+    // 3. Un archivo nuevo por shard; el manifiesto se escribe al final
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    vector<Shard*> pending;
+    for (auto& [year, shard] : shards) {
+        shard.info.file = shard_file(year);
+        pending.push_back(&shard);
+    }
+    parallel_for(pending.size(), threads, [&](size_t s, unsigned) {
+        Shard& shard = *pending[s];
+        ShardInfo& info = shard.info;
+        const string path = (dir / info.file).string();
+        sqlite3* dbc = nullptr;
+        if (sqlite3_open(path.c_str(), &dbc) != SQLITE_OK) {
+            string msg = sqlite3_errmsg(dbc);
+            sqlite3_close(dbc);
+            throw runtime_error("Cannot open shard " + path + ": " + msg);
+        }
+        try {
+            // Archivo recién creado: si la carga falla se vuelve a generar, no hace falta journal
+            exec_sql(dbc, "PRAGMA journal_mode=OFF;");
+            exec_sql(dbc, "PRAGMA synchronous=OFF;");
+            create_schema(dbc);
+            exec_sql(dbc, "BEGIN TRANSACTION");
+            size_t* counts[] = {&info.incidents, &info.details, &info.outcomes};
+            for (size_t k = 0; k < 3; ++k) {
+                const Table& t = tables[k];
+                sqlite3_stmt* stmt = prepare_insert(dbc, t.name, *t.cols);
+                for (size_t i : shard.rows[k]) insert_fields(dbc, stmt, t.name, t.rows[i], t.cols->size());
+                *counts[k] = shard.rows[k].size();
+                sqlite3_finalize(stmt);
+            }
+            exec_sql(dbc, "COMMIT");
+        } catch (...) {
+            sqlite3_close(dbc);
+            throw;
+        }
+        sqlite3_close(dbc);
+    });
+
+    vector<ShardInfo> manifest;
+    for (const auto& [_, shard] : shards) manifest.push_back(shard.info);
+    write_shard_manifest(dir.string(), manifest);
+}
@@ -1,12 +1,16 @@
 #pragma once
+#include <algorithm>
 #include <string>
 #include <semaphore>
+#include <thread>
 #include <sqlite3.h>
 
 
 struct DbConfig {
 std::string db_path {"/app/outputs/incidents.db"};
 std::string data_dir {"/app/data"};
+std::string shard_dir {"/app/outputs/db/shards"};   // un archivo por año + manifest.tsv
+unsigned threads {std::max(1u, std::thread::hardware_concurrency())};
 };
 
 
@@ -18,6 +22,8 @@ explicit DbLoader(const DbConfig& cfg);
 
 void init_schema();
 void load_all_csv_parallel();
+// Reparte las tres tablas por año del incidente en shards SQLite independientes
+void load_year_shards();
 
 
 private:
@@ -1,9 +1,12 @@
 #include <iostream>
+#include <chrono>
 #include <filesystem>
 #include <fstream>
 #include "db_loader.h"
 #include "analytics.h"
 #include "chart.h"
+#include "sketch_analytics.h"
+#include "sharded_analytics.h"
 
 using namespace std;
 namespace fs = std::filesystem;
@@ -16,84 +19,127 @@ ResultSetKV convert_ts_to_kv(const TimeSeries& ts) {
     return kv;
 }
 
-int main(int argc, char* argv[]) {
-    try {
-        bool modo_diagnostico = false;
-        if (argc > 1 && std::string(argv[1]) == "--diagnostico") {
-            modo_diagnostico = true;
-        }
+// Incisos (a)-(e) con sus gráficas; An es Analytics (una base) o ShardedAnalytics (shards por año)
+template <class An>
+void run_reports(An& an) {
+    // (a)
+    auto a = an.incident_totals_by_year(2018, 2020);
+    double total_historico = an.total_incident_count();
 
-        DbConfig cfg;
-        cfg.db_path = "/app/outputs/db/incidents.db";  // fuera del volumen montado
-        DbLoader loader(cfg);
-        loader.init_schema();
-        loader.load_all_csv_parallel();
+    double subtotal = 0;
+    for (auto& [_, count] : a.points) subtotal += count;
 
-        Analytics an(cfg.db_path);
+    double pct_global = (total_historico > 0) ? (subtotal / total_historico) * 100.0 : 0.0;
 
-        if (modo_diagnostico) {
-            std::filesystem::create_directories("/app/outputs");
-            std::ofstream diag_out("/app/outputs/images/diagnostico.txt");
-            an.run_diagnostics(std::cout);
-            an.run_diagnostics(diag_out);
-            std::cout << "\nDiagnóstico exportado a /app/outputs/images/diagnostico.txt\n";
-            return 0;
-        }
+    cout << "(a) Incidentes por año (2018–2020):\n";
+    for (auto& [year, count] : a.points) {
+        cout << "  " << year << ": " << count << "\n";
+    }
 
-        // (a)
-        auto a = an.incident_totals_by_year(2018, 2020);
-        double total_historico = an.total_incident_count();
+    std::ostringstream title;
+    title << "Incidentes por año (2018–2020), " << std::fixed << std::setprecision(2) << pct_global << "% del total";
 
-        double subtotal = 0;
-        for (auto& [_, count] : a.points) subtotal += count;
+    Chart::save_bar(convert_ts_to_kv(a), title.str(), "/app/outputs/images/a_incidents_2018_2020.png", "Incidentes");
 
-        double pct_global = (total_historico > 0) ? (subtotal / total_historico) * 100.0 : 0.0;
+    // (b)
+    auto b = an.top3_transport_by_intelligence();
+    
+    cout << "(b) Top 3 transporte (detection=intelligence):\n";
+    for (const auto& [transport, count] : b.rows) {
+        cout << "  " << transport << ": " << count << "\n";
+    }
+    Chart::save_bar(b, "Top 3 transporte (detection=intelligence)", "/app/outputs/images/b_top3_transport_intelligence.png", "Conteo");
 
-        cout << "(a) Incidentes por año (2018–2020):\n";
-        for (auto& [year, count] : a.points) {
-            cout << "  " << year << ": " << count << "\n";
-        }
 
-        std::ostringstream title;
-        title << "Incidentes por año (2018–2020), " << std::fixed << std::setprecision(2) << pct_global << "% del total";
+    // (c)
+    auto c = an.detection_by_avg_arrests(10);
+    cout << "(c) Detección por promedio de arrestos (top 10):\n";
+    for (const auto& [detection, avg_arrests] : c.rows) {
+        cout << "  " << detection << ": " << avg_arrests << "\n";
+    }
+    Chart::save_bar(c, "Detección por promedio de arrestos", "/app/outputs/images/c_detection_avg_arrests.png", "Promedio arrestos");
 
-        Chart::save_bar(convert_ts_to_kv(a), title.str(), "/app/outputs/images/a_incidents_2018_2020.png", "Incidentes");
+    // (d)
+    auto d = an.categories_with_longest_sentences_days(10);
+    cout << "(d) Categorías con mayores sentencias (días):\n";
+    for (const auto& [category, avg_days] : d.rows) {
+        cout << "  " << category << ": " << avg_days << "\n";
+    }
+    Chart::save_bar(d, "Categorías con mayores sentencias (días)", "/app/outputs/images/d_categories_longest_sentences_days.png", "Días (promedio)");
 
-        // (b)
-        auto b = an.top3_transport_by_intelligence();
-        
-        cout << "(b) Top 3 transporte (detection=intelligence):\n";
-        for (const auto& [transport, count] : b.rows) {
-            cout << "  " << transport << ": " << count << "\n";
-        }
-        Chart::save_bar(b, "Top 3 transporte (detection=intelligence)", "/app/outputs/images/b_top3_transport_intelligence.png", "Conteo");
 
+    // (e)
+    auto e = an.fine_totals_per_year();
+    cout << "(e) Multas totales por año:\n";
+    for (const auto& [year, total] : e.points) {
+        cout << "  " << year << ": " << total << "\n";
+    }
+    Chart::save_line(e, "Serie anual de multas (total)", "/app/outputs/images/e_fine_totals_per_year.png", "Multa total");
+}
 
-        // (c)
-        auto c = an.detection_by_avg_arrests(10);
-        cout << "(c) Detección por promedio de arrestos (top 10):\n";
-        for (const auto& [detection, avg_arrests] : c.rows) {
-            cout << "  " << detection << ": " << avg_arrests << "\n";
+int main(int argc, char* argv[]) {
+    try {
+        bool modo_diagnostico = false;
+        bool modo_sketch = false;
+        bool modo_shards = false;
+        SketchConfig sketch_cfg;
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg == "--diagnostico") modo_diagnostico = true;
+            else if (arg == "--sketch") modo_sketch = true;
+            else if (arg == "--shards") modo_shards = true;
+            else if (arg == "--data" && i + 1 < argc) sketch_cfg.data_dir = argv[++i];
+            else if (arg == "--threads" && i + 1 < argc) sketch_cfg.threads = std::max(1, std::stoi(argv[++i]));
+            else if (arg == "--chunk-kb" && i + 1 < argc) sketch_cfg.chunk_bytes = std::stoul(argv[++i]) * 1024;
         }
-        Chart::save_bar(c, "Detección por promedio de arrestos", "/app/outputs/images/c_detection_avg_arrests.png", "Promedio arrestos");
 
-        // (d)
-        auto d = an.categories_with_longest_sentences_days(10);
-        cout << "(d) Categorías con mayores sentencias (días):\n";
-        for (const auto& [category, avg_days] : d.rows) {
-            cout << "  " << category << ": " << avg_days << "\n";
+        // Modo sketch: una pasada sobre los CSV sin cargar SQLite
+        if (modo_sketch) {
+            SketchAnalytics sk(sketch_cfg);
+            sk.scan();
+            std::filesystem::create_directories("/app/outputs/images");
+            std::ofstream sketch_out("/app/outputs/images/sketch.txt");
+            sk.print_report(std::cout);
+            sk.print_report(sketch_out);
+            std::cout << "\nReporte exportado a /app/outputs/images/sketch.txt\n";
+            return 0;
         }
-        Chart::save_bar(d, "Categorías con mayores sentencias (días)", "/app/outputs/images/d_categories_longest_sentences_days.png", "Días (promedio)");
 
+        DbConfig cfg;
+        cfg.db_path = "/app/outputs/db/incidents.db";  // fuera del volumen montado
+        cfg.data_dir = sketch_cfg.data_dir;
+        cfg.threads = sketch_cfg.threads;
+        DbLoader loader(cfg);
 
-        // (e)
-        auto e = an.fine_totals_per_year();
-        cout << "(e) Multas totales por año:\n";
-        for (const auto& [year, total] : e.points) {
-            cout << "  " << year << ": " << total << "\n";
+        if (modo_diagnostico) {
+            loader.init_schema();
+            loader.load_all_csv_parallel();
+            Analytics an(cfg.db_path);
+            std::filesystem::create_directories("/app/outputs");
+            std::ofstream diag_out("/app/outputs/images/diagnostico.txt");
+            an.run_diagnostics(std::cout);
+            an.run_diagnostics(diag_out);
+            std::cout << "\nDiagnóstico exportado a /app/outputs/images/diagnostico.txt\n";
+            return 0;
         }
-        Chart::save_line(e, "Serie anual de multas (total)", "/app/outputs/images/e_fine_totals_per_year.png", "Multa total");
 
+        if (modo_shards) {
+            auto t0 = std::chrono::steady_clock::now();
+            loader.load_year_shards();
+            auto t1 = std::chrono::steady_clock::now();
+            ShardedAnalytics an(cfg.shard_dir, cfg.threads);
+            run_reports(an);
+            auto t2 = std::chrono::steady_clock::now();
+            cout << "Shards: " << an.shards().size() << " archivos en " << cfg.shard_dir << " (carga "
+                 << std::chrono::duration<double, std::milli>(t1 - t0).count() << " ms, consultas y gráficas "
+                 << std::chrono::duration<double, std::milli>(t2 - t1).count() << " ms, "
+                 << cfg.threads << " hilos)\n";
+        } else {
+            loader.init_schema();
+            loader.load_all_csv_parallel();
+            Analytics an(cfg.db_path);
+            run_reports(an);
+        }
 
         cout << "Listo. Revisa /outputs para los PNG y /outputs/incidents.db para la BD.\n";
     } catch(const std::exception& e){
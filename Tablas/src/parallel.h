@@ -0,0 +1,34 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+// Ejecuta fn(i, worker) para i en [0, n) con `threads` hilos que toman tareas por turno.
+// La primera excepción de cualquier tarea se relanza al terminar todos los hilos
+template <class F>
+void parallel_for(size_t n, unsigned threads, F&& fn) {
+    threads = std::max(1u, std::min<unsigned>(threads, static_cast<unsigned>(std::max<size_t>(n, 1))));
+    std::atomic<size_t> next {0};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    auto worker = [&](unsigned self) {
+        for (size_t i; (i = next.fetch_add(1)) < n;) {
+            try {
+                fn(i, self);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error) error = std::current_exception();
+                next = n;
+            }
+        }
+    };
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker, t);
+    worker(0);
+    for (auto& t : pool) t.join();
+    if (error) std::rethrow_exception(error);
+}
@@ -0,0 +1,45 @@
+#include "shard_manifest.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+using namespace std;
+namespace fs = std::filesystem;
+
+string shard_manifest_path(const string& shard_dir){
+    return (fs::path(shard_dir) / "manifest.tsv").string();
+}
+
+// Se escribe a un temporal y se renombra: un manifiesto a medias nunca queda visible
+void write_shard_manifest(const string& shard_dir, const vector<ShardInfo>& shards){
+    const string path = shard_manifest_path(shard_dir);
+    {
+        ofstream out(path + ".tmp");
+        if (!out) throw runtime_error("No se pudo escribir: " + path);
+        out << "# year\tfile\tincidents\tdetails\toutcomes\n";
+        for (const auto& s : shards) {
+            out << s.year << "\t" << s.file << "\t" << s.incidents << "\t" << s.details << "\t" << s.outcomes << "\n";
+        }
+        if (!out) throw runtime_error("No se pudo escribir: " + path);
+    }
+    fs::rename(path + ".tmp", path);
+}
+
+vector<ShardInfo> read_shard_manifest(const string& shard_dir){
+    const string path = shard_manifest_path(shard_dir);
+    ifstream in(path);
+    if (!in) throw runtime_error("No se pudo abrir el manifiesto: " + path);
+    vector<ShardInfo> shards;
+    string line;
+    while (getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        istringstream row(line);
+        ShardInfo s;
+        if (!(row >> s.year) || !(row >> s.file >> s.incidents >> s.details >> s.outcomes)) {
+            throw runtime_error("Manifiesto de shards mal formado: " + line);
+        }
+        shards.push_back(s);
+    }
+    return shards;
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include <string>
+#include <vector>
+
+
+// Un archivo SQLite con todas las filas de los report_id de un año de incidente.
+// year 0: fecha no válida o report_id sin fila en incidents
+struct ShardInfo {
+    int year {0};
+    std::string file;          // relativo al directorio de shards
+    size_t incidents {0}, details {0}, outcomes {0};
+};
+
+
+// manifest.tsv: una línea por shard (year, file, filas de cada tabla)
+std::string shard_manifest_path(const std::string& shard_dir);
+void write_shard_manifest(const std::string& shard_dir, const std::vector<ShardInfo>& shards);
+std::vector<ShardInfo> read_shard_manifest(const std::string& shard_dir);
@@ -0,0 +1,265 @@
+#include "sharded_analytics.h"
+#include "parallel.h"
+#include <algorithm>
+#include <filesystem>
+#include <map>
+#include <stdexcept>
+
+namespace {
+
+// Fila de una consulta parcial: clave (texto o año) y hasta dos valores
+struct Row {
+    std::string key;
+    int year {0};
+    double value {0};
+    double count {0};
+};
+
+std::vector<Row> query_rows(sqlite3* db, const std::string& sql){
+    sqlite3_stmt* st=nullptr;
+    if(sqlite3_prepare_v2(db, sql.c_str(), -1, &st, nullptr)!=SQLITE_OK)
+        throw std::runtime_error(sqlite3_errmsg(db));
+    std::vector<Row> rows;
+    const int cols = sqlite3_column_count(st);
+    while(sqlite3_step(st)==SQLITE_ROW){
+        Row r;
+        const unsigned char* s = sqlite3_column_text(st, 0);
+        r.key = s ? reinterpret_cast<const char*>(s) : "(null)";
+        r.year = sqlite3_column_int(st, 0);
+        if (cols > 1) r.value = sqlite3_column_double(st, 1);
+        if (cols > 2) r.count = sqlite3_column_double(st, 2);
+        rows.push_back(std::move(r));
+    }
+    sqlite3_finalize(st);
+    return rows;
+}
+
+// Ejecuta sql en los shards indicados, en paralelo; un resultado por shard, en el mismo orden
+std::vector<std::vector<Row>> scatter(const std::vector<sqlite3*>& dbs, const std::vector<size_t>& targets,
+                                      unsigned threads, const std::string& sql){
+    std::vector<std::vector<Row>> parts(targets.size());
+    parallel_for(targets.size(), threads, [&](size_t i, unsigned) { parts[i] = query_rows(dbs[targets[i]], sql); });
+    return parts;
+}
+
+std::vector<size_t> every_shard(size_t n){
+    std::vector<size_t> all(n);
+    for (size_t i = 0; i < n; ++i) all[i] = i;
+    return all;
+}
+
+// Ordena de mayor a menor y se queda con los n primeros
+ResultSetKV top_rows(const std::map<std::string, double>& values, size_t n){
+    ResultSetKV rs;
+    rs.rows.assign(values.begin(), values.end());
+    std::stable_sort(rs.rows.begin(), rs.rows.end(), [](const auto& a, const auto& b) { return a.second > b.second; });
+    if (rs.rows.size() > n) rs.rows.resize(n);
+    return rs;
+}
+
+// Literal de texto SQL (comillas simples duplicadas)
+std::string sql_quote(const std::string& text){
+    std::string out = "'";
+    for (char c : text) {
+        out += c;
+        if (c == '\'') out += c;
+    }
+    return out + "'";
+}
+
+// Misma expresión de limpieza de detection que Analytics
+const std::string detection_label =
+    "LOWER(TRIM(REPLACE(REPLACE(d.detection, CHAR(13), ''), CHAR(10), '')))";
+
+} // namespace
+
+// Abre todos los shards del manifiesto en solo lectura
+ShardedAnalytics::ShardedAnalytics(const std::string& shard_dir, unsigned threads)
+    : shards_(read_shard_manifest(shard_dir)), threads_(std::max(1u, threads)) {
+    for (const auto& s : shards_) {
+        const std::string path = (std::filesystem::path(shard_dir) / s.file).string();
+        sqlite3* db = nullptr;
+        if (sqlite3_open_v2(path.c_str(), &db, SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX, nullptr) != SQLITE_OK) {
+            std::string msg = sqlite3_errmsg(db);
+            sqlite3_close(db);
+            for (sqlite3* open : dbs_) sqlite3_close(open);
+            throw std::runtime_error("open shard " + path + ": " + msg);
+        }
+        dbs_.push_back(db);
+    }
+}
+
+ShardedAnalytics::~ShardedAnalytics(){
+    for (sqlite3* db : dbs_) sqlite3_close(db);
+}
+
+// Todos los shards (también el de fechas no válidas)
+double ShardedAnalytics::total_incident_count() {
+    const std::vector<size_t> all = every_shard(dbs_.size());
+    double total = 0;
+    for (const auto& part : scatter(dbs_, all, threads_, "SELECT 'incidents', COUNT(*) FROM incidents"))
+        for (const auto& r : part) total += r.value;
+    return total;
+}
+
+// (a) La consulta original en los shards del rango, sumando los conteos por año. Un shard
+// puede tener filas que la consulta descarta: el reparto por año ignora espacios internos de
+// la fecha ("2019 -05-01") y el GLOB no
+TimeSeries ShardedAnalytics::incident_totals_by_year(int from_year, int to_year) {
+    std::vector<size_t> targets;
+    for (size_t i = 0; i < shards_.size(); ++i) {
+        if (shards_[i].year && shards_[i].year >= from_year && shards_[i].year <= to_year) targets.push_back(i);
+    }
+    auto parts = scatter(dbs_, targets, threads_, R"SQL(
+        WITH cleaned AS (
+            SELECT 
+                CAST(SUBSTR(TRIM(REPLACE(REPLACE(date, CHAR(13), ''), CHAR(10), '')), 1, 4) AS INT) AS yr
+            FROM incidents
+            WHERE TRIM(REPLACE(REPLACE(date, CHAR(13), ''), CHAR(10), '')) 
+                  GLOB '[1-2][0-9][0-9][0-9]-[0-1][0-9]-[0-3][0-9]'
+        )
+        SELECT yr, COUNT(*) AS total
+        FROM cleaned
+        WHERE yr BETWEEN )SQL" + std::to_string(from_year) + " AND " + std::to_string(to_year) + R"SQL(
+        GROUP BY yr
+    )SQL");
+    std::map<int, double> totals;
+    for (const auto& part : parts)
+        for (const auto& r : part) totals[r.year] += r.value;
+    TimeSeries ts;
+    for (const auto& [year, total] : totals) ts.points.emplace_back(year, total);
+    return ts;
+}
+
+// (b) Conteos por transport_mode de cada shard, sumados
+ResultSetKV ShardedAnalytics::top3_transport_by_intelligence() {
+    const std::vector<size_t> all = every_shard(dbs_.size());
+    auto parts = scatter(dbs_, all, threads_, R"SQL(
+        SELECT transport_mode, COUNT(*) AS c
+        FROM details
+        WHERE LOWER(COALESCE(detection, '')) LIKE '%intelligence%' 
+        AND TRIM(COALESCE(transport_mode, '')) != ''
+        GROUP BY transport_mode
+    )SQL");
+    std::map<std::string, double> counts;
+    for (const auto& part : parts)
+        for (const auto& r : part) counts[r.key] += r.value;
+    return top_rows(counts, 3);
+}
+
+// (c) Como en Analytics, el umbral de 10 filas se cuenta por valor exacto de detection (el
+// GROUP BY de detection_counts agrupa por la columna, no por la etiqueta normalizada: "Foo" y
+// "foo" no se suman) y una etiqueta entra si alguna de sus variantes lo alcanza. Los conteos
+// por valor se suman entre shards; las variantes que pasan vuelven a cada shard como
+// detection_counts y los promedios se combinan con (suma, filas)
+ResultSetKV ShardedAnalytics::detection_by_avg_arrests(size_t topN) {
+    const std::vector<size_t> all = every_shard(dbs_.size());
+    auto counts = scatter(dbs_, all, threads_, R"SQL(
+        SELECT d.detection, COUNT(*)
+        FROM details d
+        WHERE TRIM(REPLACE(REPLACE(d.detection, CHAR(13), ''), CHAR(10), '')) != ''
+        AND d.detection IS NOT NULL
+        GROUP BY d.detection
+    )SQL");
+    std::map<std::string, double> value_rows;
+    for (const auto& part : counts)
+        for (const auto& r : part) value_rows[r.key] += r.value;
+    std::string frequent;
+    for (const auto& [value, rows] : value_rows) {
+        if (rows < 10) continue;
+        frequent += frequent.empty() ? "(" : ", (";
+        frequent += sql_quote(value) + ")";
+    }
+    if (frequent.empty()) return {};
+
+    auto joined = scatter(dbs_, all, threads_, R"SQL(
+        WITH detection_counts AS (
+            SELECT LOWER(TRIM(REPLACE(REPLACE(column1, CHAR(13), ''), CHAR(10), ''))) AS detection
+            FROM (VALUES )SQL" + frequent + R"SQL()
+        ),
+        joined AS (
+            SELECT 
+                )SQL" + detection_label + R"SQL( AS label,
+                COALESCE(o.num_ppl_arrested, 0) AS arrested
+            FROM details d
+            INNER JOIN outcomes o ON o.report_id = d.report_id
+            INNER JOIN detection_counts dc ON dc.detection = )SQL" + detection_label + R"SQL(
+            WHERE TRIM(REPLACE(REPLACE(d.detection, CHAR(13), ''), CHAR(10), '')) != ''
+        )
+        SELECT label, SUM(arrested), COUNT(*)
+        FROM joined
+        GROUP BY label
+    )SQL");
+    std::map<std::string, std::pair<double, double>> sums;
+    for (const auto& part : joined)
+        for (const auto& r : part) {
+            sums[r.key].first += r.value;
+            sums[r.key].second += r.count;
+        }
+    std::map<std::string, double> avg;
+    for (const auto& [label, s] : sums) {
+        if (!label.empty() && s.second > 0) avg[label] = s.first / s.second;
+    }
+    return top_rows(avg, topN);
+}
+
+// (d) (suma de días, filas) por categoría en cada shard
+ResultSetKV ShardedAnalytics::categories_with_longest_sentences_days(size_t topN) {
+    const std::vector<size_t> all = every_shard(dbs_.size());
+    auto parts = scatter(dbs_, all, threads_, R"SQL(
+        WITH norm_outcomes AS (
+            SELECT report_id,
+                CASE
+                    WHEN LOWER(TRIM(COALESCE(prison_time_unit, ''))) IN ('year', 'years') THEN COALESCE(prison_time, 0)*365.0
+                    WHEN LOWER(TRIM(COALESCE(prison_time_unit, ''))) IN ('month', 'months') THEN COALESCE(prison_time, 0)*30.0
+                    WHEN LOWER(TRIM(COALESCE(prison_time_unit, ''))) IN ('week', 'weeks') THEN COALESCE(prison_time, 0)*7.0
+                    WHEN LOWER(TRIM(COALESCE(prison_time_unit, ''))) IN ('day', 'days') THEN COALESCE(prison_time, 0)
+                    ELSE 0.0
+                END AS days
+            FROM outcomes
+            WHERE prison_time IS NOT NULL AND prison_time > 0
+        )
+        SELECT i.category, SUM(o.days), COUNT(*)
+        FROM incidents i
+        JOIN norm_outcomes o 
+          ON TRIM(REPLACE(REPLACE(o.report_id, CHAR(13), ''), CHAR(10), '')) = 
+             TRIM(REPLACE(REPLACE(i.report_id, CHAR(13), ''), CHAR(10), ''))
+        WHERE i.category IS NOT NULL AND o.days > 0
+        GROUP BY i.category
+    )SQL");
+    std::map<std::string, std::pair<double, double>> sums;
+    for (const auto& part : parts)
+        for (const auto& r : part) {
+            sums[r.key].first += r.value;
+            sums[r.key].second += r.count;
+        }
+    std::map<std::string, double> avg;
+    for (const auto& [category, s] : sums) avg[category] = s.first / s.second;
+    return top_rows(avg, topN);
+}
+
+// (e) Los shards con fecha válida; cada uno aporta la suma de su año
+TimeSeries ShardedAnalytics::fine_totals_per_year() {
+    std::vector<size_t> targets;
+    for (size_t i = 0; i < shards_.size(); ++i) if (shards_[i].year) targets.push_back(i);
+    auto parts = scatter(dbs_, targets, threads_, R"SQL(
+        WITH cleaned AS (
+            SELECT 
+                i.report_id,
+                CAST(SUBSTR(REPLACE(REPLACE(REPLACE(i.date, CHAR(13), ''), CHAR(10), ''), ' ', ''), 1, 4) AS INT) AS yr
+            FROM incidents i
+            WHERE REPLACE(REPLACE(REPLACE(i.date, CHAR(13), ''), CHAR(10), ''), ' ', '') 
+                GLOB '[1-2][0-9][0-9][0-9]-[0-1][0-9]-[0-3][0-9]'
+        )
+        SELECT c.yr, SUM(COALESCE(o.fine, 0)) AS total_fine
+        FROM cleaned c
+        JOIN outcomes o ON o.report_id = c.report_id
+        GROUP BY c.yr
+    )SQL");
+    std::map<int, double> totals;
+    for (const auto& part : parts)
+        for (const auto& r : part) totals[r.year] += r.value;
+    TimeSeries ts;
+    for (const auto& [year, total] : totals) ts.points.emplace_back(year, total);
+    return ts;
+}
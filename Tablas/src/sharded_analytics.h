@@ -0,0 +1,32 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <sqlite3.h>
+#include "analytics.h"
+#include "shard_manifest.h"
+
+
+// Mismas consultas que Analytics sobre los shards por año de DbLoader::load_year_shards().
+// Cada consulta elige los shards que pueden aportar filas (por el rango de años), los consulta
+// en paralelo y combina los agregados parciales: conteos y sumas se suman, y los promedios
+// viajan como (suma, filas) hasta el final
+class ShardedAnalytics {
+public:
+    ShardedAnalytics(const std::string& shard_dir, unsigned threads);
+    ~ShardedAnalytics();
+    ShardedAnalytics(const ShardedAnalytics&) = delete;
+    ShardedAnalytics& operator=(const ShardedAnalytics&) = delete;
+
+    double total_incident_count();
+    TimeSeries incident_totals_by_year(int from_year, int to_year);
+    ResultSetKV top3_transport_by_intelligence();
+    ResultSetKV detection_by_avg_arrests(size_t topN);
+    ResultSetKV categories_with_longest_sentences_days(size_t topN);
+    TimeSeries fine_totals_per_year();
+    const std::vector<ShardInfo>& shards() const { return shards_; }
+
+private:
+    std::vector<ShardInfo> shards_;
+    std::vector<sqlite3*> dbs_;   // una conexión de solo lectura por shard
+    unsigned threads_;
+};
@@ -0,0 +1,242 @@
+#include "sketch.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <stdexcept>
+
+// FNV-1a con mezcla final para repartir bien los bits altos (HyperLogLog usa los primeros p)
+uint64_t hash64(std::string_view s) {
+    uint64_t h = 1469598103934665603ull;
+    for (unsigned char c : s) {
+        h ^= c;
+        h *= 1099511628211ull;
+    }
+    h ^= h >> 30; h *= 0xbf58476d1ce4e5b9ull;
+    h ^= h >> 27; h *= 0x94d049bb133111ebull;
+    h ^= h >> 31;
+    return h;
+}
+
+// ---------------- HyperLogLog ----------------
+
+HyperLogLog::HyperLogLog(int p): p_(p), registers_(size_t(1) << p, 0) {
+    if (p < 4 || p > 18) throw std::invalid_argument("HyperLogLog: p fuera de rango");
+}
+
+// Registro = primeros p bits; valor = posición del primer 1 en el resto
+void HyperLogLog::add(uint64_t hash) {
+    size_t idx = hash >> (64 - p_);
+    uint64_t rest = (hash << p_) | (uint64_t(1) << (p_ - 1));
+    uint8_t rank = static_cast<uint8_t>(__builtin_clzll(rest) + 1);
+    registers_[idx] = std::max(registers_[idx], rank);
+}
+
+void HyperLogLog::merge(const HyperLogLog& other) {
+    if (other.p_ != p_) throw std::invalid_argument("HyperLogLog: precisiones distintas");
+    for (size_t i = 0; i < registers_.size(); ++i) registers_[i] = std::max(registers_[i], other.registers_[i]);
+}
+
+// Media armónica con corrección de rango bajo (conteo lineal)
+double HyperLogLog::estimate() const {
+    const double m = static_cast<double>(registers_.size());
+    double sum = 0;
+    size_t zeros = 0;
+    for (uint8_t r : registers_) {
+        sum += std::ldexp(1.0, -r);
+        zeros += r == 0;
+    }
+    double e = 0.7213 / (1.0 + 1.079 / m) * m * m / sum;
+    if (e <= 2.5 * m && zeros > 0) e = m * std::log(m / static_cast<double>(zeros));
+    return e;
+}
+
+double HyperLogLog::relative_error() const {
+    return 1.04 / std::sqrt(static_cast<double>(registers_.size()));
+}
+
+// ---------------- t-digest ----------------
+
+TDigest::TDigest(double compression)
+    : compression_(compression), min_(std::numeric_limits<double>::infinity()),
+      max_(-std::numeric_limits<double>::infinity()) {}
+
+void TDigest::add(double x, double weight) {
+    if (!(weight > 0) || std::isnan(x)) return;
+    buffer_.push_back({x, weight});
+    total_ += weight;
+    min_ = std::min(min_, x);
+    max_ = std::max(max_, x);
+    if (buffer_.size() >= static_cast<size_t>(compression_) * 8) compress();
+}
+
+void TDigest::merge(const TDigest& other) {
+    other.compress();
+    buffer_.insert(buffer_.end(), other.merged_.begin(), other.merged_.end());
+    total_ += other.total_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+    compress();
+}
+
+double TDigest::count() const { return total_; }
+
+size_t TDigest::centroids() const {
+    compress();
+    return merged_.size();
+}
+
+// Fusión voraz ordenada por media: un centroide puede crecer mientras su tramo de cuantiles
+// ocupe como mucho una unidad de la función de escala k1(q) = δ/(2π) asin(2q - 1)
+void TDigest::compress() const {
+    if (buffer_.empty()) return;
+    buffer_.insert(buffer_.end(), merged_.begin(), merged_.end());
+    std::sort(buffer_.begin(), buffer_.end(), [](const Centroid& a, const Centroid& b) { return a.mean < b.mean; });
+    auto k = [&](double q) { return compression_ / (2.0 * std::numbers::pi) * std::asin(2.0 * q - 1.0); };
+
+    merged_.clear();
+    Centroid cur = buffer_.front();
+    double before = 0;   // Peso a la izquierda de cur
+    for (size_t i = 1; i < buffer_.size(); ++i) {
+        const Centroid& next = buffer_[i];
+        double q0 = before / total_, q1 = (before + cur.weight + next.weight) / total_;
+        if (k(std::min(q1, 1.0)) - k(q0) <= 1.0) {
+            cur.mean += (next.mean - cur.mean) * next.weight / (cur.weight + next.weight);
+            cur.weight += next.weight;
+        } else {
+            merged_.push_back(cur);
+            before += cur.weight;
+            cur = next;
+        }
+    }
+    merged_.push_back(cur);
+    buffer_.clear();
+}
+
+// Interpolación lineal entre los centros de los centroides (su peso acumulado a mitad)
+double TDigest::quantile(double q) const {
+    compress();
+    if (merged_.empty()) return std::numeric_limits<double>::quiet_NaN();
+    q = std::clamp(q, 0.0, 1.0);
+    const double target = q * total_;
+    double cum = 0;
+    double prev_center = 0, prev_mean = min_;
+    for (const Centroid& c : merged_) {
+        double center = cum + c.weight / 2.0;
+        if (target <= center) {
+            double span = center - prev_center;
+            double t = span > 0 ? (target - prev_center) / span : 0.0;
+            return prev_mean + t * (c.mean - prev_mean);
+        }
+        prev_center = center;
+        prev_mean = c.mean;
+        cum += c.weight;
+    }
+    double span = total_ - prev_center;
+    double t = span > 0 ? (target - prev_center) / span : 1.0;
+    return prev_mean + t * (max_ - prev_mean);
+}
+
+std::pair<double, double> TDigest::quantile_bounds(double q) const {
+    compress();
+    if (merged_.empty()) return {std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN()};
+    const double target = std::clamp(q, 0.0, 1.0) * total_;
+    double cum = 0;
+    for (size_t i = 0; i < merged_.size(); ++i) {
+        if (target <= cum + merged_[i].weight) {
+            double lo = i > 0 ? merged_[i - 1].mean : min_;
+            double hi = i + 1 < merged_.size() ? merged_[i + 1].mean : max_;
+            return {std::min(lo, merged_[i].mean), std::max(hi, merged_[i].mean)};
+        }
+        cum += merged_[i].weight;
+    }
+    return {merged_.back().mean, max_};
+}
+
+// ---------------- Count-Min ----------------
+
+CountMinSketch::CountMinSketch(size_t width, size_t depth)
+    : width_(std::bit_ceil(std::max<size_t>(width, 1))), depth_(depth), table_(width_ * depth, 0) {
+    if (width == 0 || depth == 0) throw std::invalid_argument("CountMinSketch: dimensiones vacías");
+}
+
+// Fila i: h1 + i * h2 (doble hash a partir de las dos mitades del hash); el ancho es potencia
+// de dos para reducir con una máscara. Devuelve la estimación ya actualizada
+uint64_t CountMinSketch::add(uint64_t hash, uint64_t count) {
+    uint64_t h1 = hash & 0xffffffffu, h2 = (hash >> 32) | 1;
+    uint64_t best = std::numeric_limits<uint64_t>::max();
+    for (size_t i = 0; i < depth_; ++i) {
+        uint64_t& cell = table_[i * width_ + ((h1 + i * h2) & (width_ - 1))];
+        cell += count;
+        best = std::min(best, cell);
+    }
+    total_ += count;
+    return best;
+}
+
+uint64_t CountMinSketch::estimate(uint64_t hash) const {
+    uint64_t h1 = hash & 0xffffffffu, h2 = (hash >> 32) | 1;
+    uint64_t best = std::numeric_limits<uint64_t>::max();
+    for (size_t i = 0; i < depth_; ++i) best = std::min(best, table_[i * width_ + ((h1 + i * h2) & (width_ - 1))]);
+    return best;
+}
+
+void CountMinSketch::merge(const CountMinSketch& other) {
+    if (other.width_ != width_ || other.depth_ != depth_) throw std::invalid_argument("CountMinSketch: dimensiones distintas");
+    for (size_t i = 0; i < table_.size(); ++i) table_[i] += other.table_[i];
+    total_ += other.total_;
+}
+
+double CountMinSketch::epsilon() const { return std::numbers::e / static_cast<double>(width_); }
+double CountMinSketch::delta() const { return std::exp(-static_cast<double>(depth_)); }
+
+// ---------------- Heavy hitters ----------------
+
+HeavyHitters::HeavyHitters(size_t capacity, size_t width, size_t depth): capacity_(capacity), cms_(width, depth) {}
+
+// Deja los capacity_ candidatos con mayor estimación y fija el umbral de entrada; los empates
+// se rompen por término, así el resultado no depende del orden de la tabla hash
+void HeavyHitters::prune() {
+    std::vector<std::pair<std::string, uint64_t>> all;
+    all.reserve(candidates_.size());
+    for (auto& [term, _] : candidates_) all.emplace_back(term, cms_.estimate(hash64(term)));
+    std::sort(all.begin(), all.end(), [](const auto& a, const auto& b) {
+        return a.second != b.second ? a.second > b.second : a.first < b.first;
+    });
+    if (all.size() > capacity_) all.resize(capacity_);
+    candidates_.clear();
+    for (auto& [term, c] : all) candidates_.emplace(std::move(term), c);
+    floor_ = candidates_.size() < capacity_ ? 0 : all.back().second;
+}
+
+// Un término entra en los candidatos si supera el umbral; se poda cuando hay el doble de los
+// que se guardan, así el coste de ordenar se reparte entre muchas inserciones
+void HeavyHitters::add(std::string_view term) {
+    const uint64_t h = hash64(term);
+    const uint64_t est = cms_.add(h);
+    if (est <= floor_) return;
+    if (auto it = candidates_.find(term); it != candidates_.end()) {
+        it->second = est;
+        return;
+    }
+    candidates_.emplace(term, est);
+    if (candidates_.size() >= 2 * capacity_) prune();
+}
+
+// Se suman las tablas y se reestiman todos los candidatos con la tabla conjunta
+void HeavyHitters::merge(const HeavyHitters& other) {
+    cms_.merge(other.cms_);
+    for (const auto& [term, _] : other.candidates_) candidates_.emplace(term, 0);
+    prune();
+}
+
+std::vector<std::pair<std::string, uint64_t>> HeavyHitters::top(size_t n) const {
+    std::vector<std::pair<std::string, uint64_t>> all;
+    for (const auto& [term, _] : candidates_) all.emplace_back(term, cms_.estimate(hash64(term)));
+    std::sort(all.begin(), all.end(), [](const auto& a, const auto& b) {
+        return a.second != b.second ? a.second > b.second : a.first < b.first;
+    });
+    if (all.size() > n) all.resize(n);
+    return all;
+}
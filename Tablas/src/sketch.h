@@ -0,0 +1,100 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Hash de 64 bits para cadenas (FNV-1a + mezcla final de splitmix64)
+uint64_t hash64(std::string_view s);
+
+// HyperLogLog con 2^p registros: cardinalidad aproximada con error estándar 1.04/sqrt(2^p)
+class HyperLogLog {
+public:
+    explicit HyperLogLog(int p = 14);
+
+    void add(uint64_t hash);
+    void merge(const HyperLogLog& other);
+    double estimate() const;
+    // Error relativo estándar (1 sigma)
+    double relative_error() const;
+    size_t bytes() const { return registers_.size(); }
+
+private:
+    int p_;
+    std::vector<uint8_t> registers_;
+};
+
+// t-digest con fusión (Dunning): cuantiles aproximados con centroides pequeños en las colas
+class TDigest {
+public:
+    explicit TDigest(double compression = 200.0);
+
+    void add(double x, double weight = 1.0);
+    void merge(const TDigest& other);
+    double count() const;
+    double quantile(double q) const;
+    // Medias de los centroides que rodean a q. Solo acota el cuantil real si cada centroide
+    // cubre un tramo contiguo de los datos ordenados; tras varias compresiones o un merge()
+    // los tramos pueden solaparse, así que es una referencia, no una garantía
+    std::pair<double, double> quantile_bounds(double q) const;
+    size_t centroids() const;
+
+private:
+    struct Centroid { double mean; double weight; };
+    double compression_;
+    double min_, max_;
+    double total_ {0.0};
+    mutable std::vector<Centroid> merged_;
+    mutable std::vector<Centroid> buffer_;
+
+    void compress() const;
+};
+
+// Count-Min: frecuencias que nunca se subestiman y se sobreestiman como mucho en
+// epsilon() * total() con probabilidad 1 - delta(). El ancho se redondea a potencia de dos
+class CountMinSketch {
+public:
+    CountMinSketch(size_t width = 2048, size_t depth = 4);
+
+    // Suma count y devuelve la nueva estimación
+    uint64_t add(uint64_t hash, uint64_t count = 1);
+    uint64_t estimate(uint64_t hash) const;
+    void merge(const CountMinSketch& other);
+    uint64_t total() const { return total_; }
+    double epsilon() const;
+    double delta() const;
+    size_t bytes() const { return table_.size() * sizeof(uint64_t); }
+
+private:
+    size_t width_, depth_;
+    uint64_t total_ {0};
+    std::vector<uint64_t> table_;
+};
+
+// Términos más frecuentes: Count-Min más un conjunto acotado de candidatos
+class HeavyHitters {
+public:
+    explicit HeavyHitters(size_t capacity = 256, size_t width = 2048, size_t depth = 4);
+
+    void add(std::string_view term);
+    void merge(const HeavyHitters& other);
+    // Los n candidatos con mayor frecuencia estimada
+    std::vector<std::pair<std::string, uint64_t>> top(size_t n) const;
+    const CountMinSketch& sketch() const { return cms_; }
+
+private:
+    size_t capacity_;
+    CountMinSketch cms_;
+    // Búsqueda por string_view sin construir la clave
+    struct TermHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view s) const { return hash64(s); }
+    };
+    std::unordered_map<std::string, uint64_t, TermHash, std::equal_to<>> candidates_;
+    uint64_t floor_ {0};   // Umbral de entrada: menor estimación tras la última poda
+
+    void prune();
+};
@@ -0,0 +1,539 @@
+#include "sketch_analytics.h"
+#include "parallel.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <fcntl.h>
+#include <filesystem>
+#include <iomanip>
+#include <set>
+#include <stdexcept>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// Archivo mapeado en solo lectura, recorrido de principio a fin
+class MappedFile {
+public:
+    explicit MappedFile(const fs::path& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("No se pudo abrir: " + path.string());
+        struct stat st {};
+        if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+            size_ = static_cast<size_t>(st.st_size);
+            void* p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) {
+                data_ = static_cast<const char*>(p);
+                ::madvise(p, size_, MADV_SEQUENTIAL);
+            }
+        }
+        ::close(fd);
+        if (size_ > 0 && !data_) throw std::runtime_error("No se pudo mapear: " + path.string());
+    }
+    ~MappedFile() { if (data_) ::munmap(const_cast<char*>(data_), size_); }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    const char* data_ {nullptr};
+    size_t size_ {0};
+};
+
+// Rangos [inicio, fin) de registros completos tras la cabecera. Un salto de línea solo separa
+// registros fuera de comillas: se cuentan las comillas de cada bloque en paralelo y cada bloque
+// busca su primer salto de línea real sabiendo si empieza dentro de un campo entre comillas
+std::vector<std::pair<size_t, size_t>> record_ranges(const MappedFile& file, size_t chunk_bytes, unsigned threads) {
+    const char* data = file.data();
+    const size_t size = file.size();
+    const char* header_end = size ? static_cast<const char*>(memchr(data, '\n', size)) : nullptr;
+    const size_t start = header_end ? static_cast<size_t>(header_end - data) + 1 : size;
+    const size_t chunks = std::max<size_t>(1, (size - start + chunk_bytes - 1) / chunk_bytes);
+
+    std::vector<uint8_t> parity(chunks, 0);
+    parallel_for(chunks, threads, [&](size_t c, unsigned) {
+        const size_t b = start + c * chunk_bytes, e = std::min(size, b + chunk_bytes);
+        parity[c] = static_cast<uint8_t>(std::count(data + b, data + e, '"') & 1);
+    });
+    std::vector<size_t> bounds(chunks + 1, size);
+    bounds[0] = start;
+    std::vector<uint8_t> in_quotes(chunks, 0);
+    for (size_t c = 1; c < chunks; ++c) in_quotes[c] = in_quotes[c - 1] ^ parity[c - 1];
+    parallel_for(chunks - 1, threads, [&](size_t i, unsigned) {
+        const size_t c = i + 1;
+        bool quoted = in_quotes[c];
+        size_t p = start + c * chunk_bytes;
+        for (; p < size; ++p) {
+            if (data[p] == '"') quoted = !quoted;
+            else if (data[p] == '\n' && !quoted) break;
+        }
+        bounds[c] = std::min(size, p + 1);
+    });
+    std::vector<std::pair<size_t, size_t>> ranges;
+    // Un registro más largo que un bloque deja bloques vacíos (mismo límite que el siguiente)
+    for (size_t c = 0; c < chunks; ++c) {
+        if (bounds[c] < bounds[c + 1]) ranges.emplace_back(bounds[c], bounds[c + 1]);
+    }
+    return ranges;
+}
+
+// Lector de registros CSV: campos separados por comas, entre comillas con "" escapadas y
+// saltos de línea permitidos dentro de las comillas
+class CsvReader {
+public:
+    CsvReader(const char* begin, const char* end): p_(begin), end_(end) {}
+
+    const char* position() const { return p_; }
+
+    bool next(std::vector<std::string_view>& fields) {
+        fields.clear();
+        if (p_ >= end_) return false;
+        for (size_t f = 0;; ++f) {
+            if (p_ < end_ && *p_ == '"') {
+                const char* b = ++p_;
+                bool escaped = false;
+                while (p_ < end_) {
+                    if (*p_ == '"') {
+                        if (p_ + 1 < end_ && p_[1] == '"') { escaped = true; p_ += 2; continue; }
+                        break;
+                    }
+                    ++p_;
+                }
+                std::string_view raw(b, static_cast<size_t>(p_ - b));
+                if (p_ < end_) ++p_;   // comilla de cierre
+                if (escaped) {
+                    if (scratch_.size() <= f) scratch_.resize(f + 1);
+                    std::string& s = scratch_[f];
+                    s.clear();
+                    for (size_t i = 0; i < raw.size(); ++i) {
+                        s += raw[i];
+                        if (raw[i] == '"') ++i;
+                    }
+                    raw = s;
+                }
+                fields.push_back(raw);
+                while (p_ < end_ && *p_ != ',' && *p_ != '\n') ++p_;   // basura tras la comilla
+            } else {
+                const char* b = p_;
+                while (p_ < end_ && *p_ != ',' && *p_ != '\n') ++p_;
+                const char* e = p_;
+                if (e > b && e[-1] == '\r') --e;
+                fields.emplace_back(b, static_cast<size_t>(e - b));
+            }
+            if (p_ >= end_ || *p_ == '\n') {
+                if (p_ < end_) ++p_;
+                return true;
+            }
+            ++p_;   // coma
+        }
+    }
+
+private:
+    const char* p_;
+    const char* end_;
+    std::deque<std::string> scratch_;   // campos con comillas escapadas (deque: no mueve los anteriores)
+};
+
+// Limpieza del cargador: quita \r \n \t y espacios de los extremos
+std::string clean(std::string_view v) {
+    std::string s;
+    s.reserve(v.size());
+    for (char c : v) if (c != '\r' && c != '\n' && c != '\t') s += c;
+    size_t b = s.find_first_not_of(" \f\v"), e = s.find_last_not_of(" \f\v");
+    return b == std::string::npos ? std::string() : s.substr(b, e - b + 1);
+}
+
+std::string lower(std::string s) {
+    for (char& c : s) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    return s;
+}
+
+// Valor numérico como en SQLite: vacío o no numérico cuenta como 0
+double number(std::string_view v) {
+    std::string s = clean(v);
+    if (s.empty()) return 0.0;
+    char* end = nullptr;
+    double d = strtod(s.c_str(), &end);
+    return *end == '\0' ? d : 0.0;
+}
+
+// Año de una fecha YYYY-MM-DD ya limpia, 0 si no tiene exactamente ese formato (el GLOB de las
+// consultas: un espacio interno la invalida)
+int year_of(std::string_view s) {
+    auto digit = [&](size_t i, char lo = '0', char hi = '9') { return s[i] >= lo && s[i] <= hi; };
+    if (s.size() != 10 || s[4] != '-' || s[7] != '-' || !digit(0, '1', '2') || !digit(1) || !digit(2) || !digit(3) ||
+        !digit(5, '0', '1') || !digit(6) || !digit(8, '0', '3') || !digit(9)) {
+        return 0;
+    }
+    return (s[0] - '0') * 1000 + (s[1] - '0') * 100 + (s[2] - '0') * 10 + (s[3] - '0');
+}
+
+// La consulta (e) quita además todos los espacios antes del GLOB ("2019 -05-01" es 2019)
+std::string without_spaces(std::string s) {
+    s.erase(std::remove(s.begin(), s.end(), ' '), s.end());
+    return s;
+}
+
+// Sentencia en días según la unidad (como la consulta (d))
+double prison_days(double time, std::string_view unit) {
+    std::string u = lower(clean(unit));
+    if (u == "year" || u == "years") return time * 365.0;
+    if (u == "month" || u == "months") return time * 30.0;
+    if (u == "week" || u == "weeks") return time * 7.0;
+    if (u == "day" || u == "days") return time;
+    return 0.0;
+}
+
+// Términos de subject: palabras de al menos 3 letras, en minúsculas, sin palabras vacías
+// (ninguna pasa de 5 letras)
+void subject_terms(std::string_view subject, HeavyHitters& out) {
+    static const std::vector<std::string_view> stop = {"the", "and", "for", "with", "from", "was", "were", "are",
+                                                       "has", "had", "into", "after", "over", "who", "that", "this",
+                                                       "their", "its", "his", "her", "they", "been", "while"};
+    std::string term;
+    auto flush = [&] {
+        if (term.size() >= 3 && (term.size() > 5 || std::find(stop.begin(), stop.end(), term) == stop.end())) {
+            out.add(term);
+        }
+        term.clear();
+    };
+    for (char c : subject) {
+        if (std::isalpha(static_cast<unsigned char>(c))) term += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        else flush();
+    }
+    flush();
+}
+
+// Suma filas de details de una detección a las de un report_id
+void add_detection(ReportKeys& k, uint64_t detection, uint32_t rows) {
+    for (auto& [d, n] : k.detections) {
+        if (d == detection) {
+            n += rows;
+            return;
+        }
+    }
+    k.detections.emplace_back(detection, rows);
+}
+
+enum class CsvKind { Incidents, Details, Outcomes };
+
+struct Task {
+    CsvKind kind;
+    const MappedFile* file;
+    std::pair<size_t, size_t> range;
+};
+
+// Acumula un bloque de registros en st (keys: índice ya combinado, solo para outcomes)
+void process(const Task& task, SketchState& st, const std::unordered_map<uint64_t, ReportKeys>& keys) {
+    const char* base = task.file->data();
+    CsvReader reader(base + task.range.first, base + task.range.second);
+    std::vector<std::string_view> f;
+    for (const char* row = reader.position(); reader.next(f); row = reader.position()) {
+        if (f.size() == 1 && f[0].empty()) continue;   // línea vacía
+        // Un campo vacío se guarda como NULL: ese report_id no cruza con nada
+        const bool null_id = f[0].empty();
+        switch (task.kind) {
+        case CsvKind::Incidents: {
+            f.resize(3);
+            std::string id = clean(f[0]), category = clean(f[1]), date = clean(f[2]);
+            const int year = year_of(date);
+            ++st.incident_rows;
+            if (!category.empty()) ++st.categories[category];
+            if (null_id) {
+                ++st.null_incidents;
+                if (year) ++st.incidents_by_year[year];
+                break;
+            }
+            st.incident_ids.add(hash64(id));
+            ReportKeys& k = st.keys[hash64(id)];
+            const uint64_t pos = static_cast<uint64_t>(row - base);
+            if (pos < k.incident_pos) {
+                k.incident_pos = pos;
+                k.category = category.empty() ? 0 : hash64(category);
+                k.year = year;
+                k.fine_year = year_of(without_spaces(date));
+            }
+            break;
+        }
+        case CsvKind::Details: {
+            f.resize(4);
+            std::string id = clean(f[0]), transport = clean(f[2]), detection = clean(f[3]);
+            const std::string label = lower(detection);
+            ++st.detail_rows;
+            st.detail_ids.add(hash64(id));
+            subject_terms(f[1], st.subject_terms);
+            if (!transport.empty()) {
+                ++st.transports[transport];
+                if (label.find("intelligence") != std::string::npos) ++st.intelligence_transports[transport];
+            }
+            if (!label.empty()) {
+                ++st.detections[detection];
+                if (!null_id) add_detection(st.keys[hash64(id)], hash64(label), 1);
+            }
+            break;
+        }
+        case CsvKind::Outcomes: {
+            f.resize(7);
+            std::string id = clean(f[0]);
+            const double fine = number(f[3]), arrested = number(f[4]), time = number(f[5]);
+            const double days = time > 0 ? prison_days(time, f[6]) : 0.0;
+            ++st.outcome_rows;
+            const uint64_t h = hash64(id);
+            st.outcome_ids.add(h);
+            if (fine > 0) st.fines.add(fine);
+            if (days > 0) st.prison_days.add(days);
+            auto it = null_id ? keys.end() : keys.find(h);
+            if (it == keys.end()) break;
+            for (const auto& [detection, rows] : it->second.detections) {
+                auto& a = st.arrests_by_detection[detection];
+                a.first += arrested * rows;
+                a.second += rows;
+            }
+            if (it->second.category && days > 0) {
+                auto& d = st.days_by_category[it->second.category];
+                d.first += days;
+                ++d.second;
+            }
+            if (it->second.fine_year) st.fines_by_year[it->second.fine_year] += fine;
+            break;
+        }
+        }
+    }
+}
+
+template <class Map>
+void add_counts(Map& into, Map&& from) {
+    for (auto& [k, v] : from) into[k] += v;
+}
+
+// Ordena de mayor a menor y se queda con los n primeros
+ResultSetKV top_rows(std::vector<std::pair<std::string, double>> rows, size_t n) {
+    std::sort(rows.begin(), rows.end(), [](const auto& a, const auto& b) {
+        return a.second != b.second ? a.second > b.second : a.first < b.first;
+    });
+    if (rows.size() > n) rows.resize(n);
+    ResultSetKV rs;
+    rs.rows = std::move(rows);
+    return rs;
+}
+
+} // namespace
+
+// Combina dos estados parciales (todo lo que guardan es sumable)
+void SketchState::merge(SketchState&& other) {
+    add_counts(categories, std::move(other.categories));
+    add_counts(detections, std::move(other.detections));
+    add_counts(transports, std::move(other.transports));
+    add_counts(intelligence_transports, std::move(other.intelligence_transports));
+    add_counts(incidents_by_year, std::move(other.incidents_by_year));
+    add_counts(fines_by_year, std::move(other.fines_by_year));
+    null_incidents += other.null_incidents;
+    incident_rows += other.incident_rows;
+    detail_rows += other.detail_rows;
+    outcome_rows += other.outcome_rows;
+    incident_ids.merge(other.incident_ids);
+    detail_ids.merge(other.detail_ids);
+    outcome_ids.merge(other.outcome_ids);
+    subject_terms.merge(other.subject_terms);
+    fines.merge(other.fines);
+    prison_days.merge(other.prison_days);
+    for (auto& [k, v] : other.arrests_by_detection) {
+        auto& a = arrests_by_detection[k];
+        a.first += v.first;
+        a.second += v.second;
+    }
+    for (auto& [k, v] : other.days_by_category) {
+        auto& d = days_by_category[k];
+        d.first += v.first;
+        d.second += v.second;
+    }
+    if (keys.empty()) {
+        keys = std::move(other.keys);
+        return;
+    }
+    // La fila de incidents que cuenta es la primera del archivo, no la del último bloque combinado
+    for (auto& [h, k] : other.keys) {
+        ReportKeys& dst = keys[h];
+        if (k.incident_pos < dst.incident_pos) {
+            dst.incident_pos = k.incident_pos;
+            dst.category = k.category;
+            dst.year = k.year;
+            dst.fine_year = k.fine_year;
+        }
+        for (const auto& [detection, rows] : k.detections) add_detection(dst, detection, rows);
+    }
+}
+
+SketchAnalytics::SketchAnalytics(const SketchConfig& cfg): cfg_(cfg) {}
+
+// Una pasada: incidents y details a la vez, después outcomes cruzado con el índice
+void SketchAnalytics::scan() {
+    auto t0 = std::chrono::steady_clock::now();
+    const fs::path dir(cfg_.data_dir);
+    MappedFile incidents(dir / "incidents.csv"), details(dir / "details.csv"), outcomes(dir / "outcomes.csv");
+    bytes_read_ = incidents.size() + details.size() + outcomes.size();
+    const unsigned threads = std::max(1u, cfg_.threads);
+    const size_t chunk = std::max<size_t>(4096, cfg_.chunk_bytes);
+
+    auto run_phase = [&](std::vector<Task> tasks) {
+        std::vector<SketchState> partial(std::min<size_t>(threads, std::max<size_t>(1, tasks.size())));
+        parallel_for(tasks.size(), threads, [&](size_t i, unsigned w) { process(tasks[i], partial[w], state_.keys); });
+        for (SketchState& p : partial) state_.merge(std::move(p));
+        chunks_ += tasks.size();
+    };
+    auto tasks_of = [&](CsvKind kind, const MappedFile& file, std::vector<Task>& tasks) {
+        for (const auto& r : record_ranges(file, chunk, threads)) tasks.push_back({kind, &file, r});
+    };
+
+    std::vector<Task> first;
+    tasks_of(CsvKind::Incidents, incidents, first);
+    tasks_of(CsvKind::Details, details, first);
+    run_phase(std::move(first));
+    for (const auto& [_, k] : state_.keys) {
+        if (k.incident_pos != UINT64_MAX && k.year) ++state_.incidents_by_year[k.year];
+    }
+    std::vector<Task> second;
+    tasks_of(CsvKind::Outcomes, outcomes, second);
+    run_phase(std::move(second));
+    seconds_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+// Total de incidentes: report_id distintos (la tabla incidents los tiene como clave primaria)
+// más las filas sin report_id, que SQLite guarda todas
+Estimate SketchAnalytics::total_incident_count() const {
+    double distinct = state_.incident_ids.estimate();
+    return {distinct + static_cast<double>(state_.null_incidents),
+            2.0 * state_.incident_ids.relative_error() * distinct};
+}
+
+// (a) Conteo exacto por año: una fila por report_id (la primera) más las filas sin report_id
+TimeSeries SketchAnalytics::incident_totals_by_year(int from_year, int to_year) const {
+    TimeSeries ts;
+    for (const auto& [year, count] : state_.incidents_by_year) {
+        if (year >= from_year && year <= to_year) ts.points.emplace_back(year, static_cast<double>(count));
+    }
+    return ts;
+}
+
+// (b) Contador exacto de transport_mode con detección por inteligencia
+ResultSetKV SketchAnalytics::top3_transport_by_intelligence() const {
+    std::vector<std::pair<std::string, double>> rows;
+    for (const auto& [transport, count] : state_.intelligence_transports) rows.emplace_back(transport, static_cast<double>(count));
+    return top_rows(std::move(rows), 3);
+}
+
+// (c) Promedio de arrestos por detección. Como en la consulta SQL, el umbral de 10 filas se
+// cuenta por valor exacto de detection ("Foo" y "foo" por separado) y la etiqueta en minúsculas
+// entra si alguno de sus valores lo alcanza
+ResultSetKV SketchAnalytics::detection_by_avg_arrests(size_t topN) const {
+    std::set<std::string> labels;
+    for (const auto& [detection, count] : state_.detections) {
+        if (count >= 10) labels.insert(lower(detection));
+    }
+    std::vector<std::pair<std::string, double>> rows;
+    for (const std::string& label : labels) {
+        auto it = state_.arrests_by_detection.find(hash64(label));
+        if (it != state_.arrests_by_detection.end() && it->second.second) {
+            rows.emplace_back(label, it->second.first / static_cast<double>(it->second.second));
+        }
+    }
+    return top_rows(std::move(rows), topN);
+}
+
+// (d) Promedio de días de sentencia por categoría
+ResultSetKV SketchAnalytics::categories_with_longest_sentences_days(size_t topN) const {
+    std::vector<std::pair<std::string, double>> rows;
+    for (const auto& [category, _] : state_.categories) {
+        auto it = state_.days_by_category.find(hash64(category));
+        if (it != state_.days_by_category.end() && it->second.second) {
+            rows.emplace_back(category, it->second.first / static_cast<double>(it->second.second));
+        }
+    }
+    return top_rows(std::move(rows), topN);
+}
+
+// (e) Suma de multas por año del incidente
+TimeSeries SketchAnalytics::fine_totals_per_year() const {
+    TimeSeries ts;
+    for (const auto& [year, total] : state_.fines_by_year) ts.points.emplace_back(year, total);
+    return ts;
+}
+
+void SketchAnalytics::print_report(std::ostream& out) const {
+    const double mib = bytes_read_ / 1048576.0;
+    const size_t sketch_bytes = 3 * state_.incident_ids.bytes() + state_.subject_terms.sketch().bytes() +
+                                16 * (state_.fines.centroids() + state_.prison_days.centroids());
+    out << std::fixed << std::setprecision(2);
+    out << "\n--- Modo sketch (una pasada sobre los CSV, sin SQLite) ---\n";
+    out << "Leídos " << mib << " MiB en " << seconds_ * 1000 << " ms (" << mib / seconds_ << " MiB/s), "
+        << chunks_ << " bloques, " << cfg_.threads << " hilos\n";
+    size_t index_bytes = 0;   // nodos de la tabla hash (con su puntero y hash) y listas de detecciones
+    for (const auto& [_, k] : state_.keys) {
+        index_bytes += sizeof(std::pair<const uint64_t, ReportKeys>) + 2 * sizeof(void*) +
+                       k.detections.capacity() * sizeof(k.detections[0]);
+    }
+    out << "Memoria: sketches " << sketch_bytes / 1024 << " KiB (fija); índice de cruces "
+        << state_.keys.size() << " report_id (~" << index_bytes / 1024 << " KiB)\n";
+
+    // (a)
+    auto a = incident_totals_by_year(2018, 2020);
+    Estimate total = total_incident_count();
+    double subtotal = 0;
+    for (const auto& [_, count] : a.points) subtotal += count;
+    out << "(a) Incidentes por año (2018–2020) [conteo exacto]:\n";
+    for (const auto& [year, count] : a.points) out << "  " << year << ": " << count << "\n";
+    if (total.value > 0) {
+        const double pct = subtotal / total.value * 100.0;
+        out << "  Total histórico ≈ " << std::setprecision(0) << total.value << " ± " << total.error
+            << " (HyperLogLog, 95 %; " << state_.incident_rows << " filas)" << std::setprecision(2) << " -> "
+            << pct << " % ± " << pct * total.error / total.value << " % del total\n";
+    }
+
+    // (b)
+    out << "(b) Top 3 transporte (detection=intelligence) [conteo exacto]:\n";
+    for (const auto& [transport, count] : top3_transport_by_intelligence().rows) {
+        out << "  " << transport << ": " << std::setprecision(0) << count << "\n";
+    }
+
+    // (c)-(e): exactos salvo colisiones del hash de 64 bits de report_id
+    out << std::setprecision(2) << "(c) Detección por promedio de arrestos (top 10) [cruce por hash de report_id]:\n";
+    for (const auto& [detection, avg] : detection_by_avg_arrests(10).rows) out << "  " << detection << ": " << avg << "\n";
+    out << "(d) Categorías con mayores sentencias (días) [cruce por hash de report_id]:\n";
+    for (const auto& [category, avg] : categories_with_longest_sentences_days(10).rows) {
+        out << "  " << category << ": " << avg << "\n";
+    }
+    out << "(e) Multas totales por año [cruce por hash de report_id]:\n";
+    for (const auto& [year, fines] : fine_totals_per_year().points) out << "  " << year << ": " << fines << "\n";
+
+    // Sketches adicionales
+    out << "report_id distintos (HyperLogLog, ±" << 200.0 * state_.incident_ids.relative_error() << " % al 95 %):\n"
+        << std::setprecision(0) << "  incidents ≈ " << state_.incident_ids.estimate() << " (" << state_.incident_rows
+        << " filas), details ≈ " << state_.detail_ids.estimate() << " (" << state_.detail_rows
+        << " filas), outcomes ≈ " << state_.outcome_ids.estimate() << " (" << state_.outcome_rows << " filas)\n";
+    auto quantiles = [&](const char* name, const TDigest& d) {
+        out << name << " (t-digest, " << std::setprecision(0) << d.count() << " valores, " << d.centroids()
+            << " centroides; entre corchetes, los centroides vecinos):\n";
+        for (double q : {0.5, 0.9, 0.99}) {
+            auto [lo, hi] = d.quantile_bounds(q);
+            out << "  p" << std::setprecision(0) << q * 100 << ": " << std::setprecision(1) << d.quantile(q) << " [" << lo << ", " << hi << "]\n";
+        }
+    };
+    quantiles("Multas > 0", state_.fines);
+    quantiles("Sentencias en días", state_.prison_days);
+    const CountMinSketch& cms = state_.subject_terms.sketch();
+    out << "Términos más frecuentes en subject (Count-Min: sobreestiman como mucho " << std::setprecision(0)
+        << cms.epsilon() * cms.total() << " de " << cms.total() << " términos con prob. "
+        << std::setprecision(3) << 1.0 - cms.delta() << "):\n";
+    for (const auto& [term, count] : state_.subject_terms.top(10)) out << "  " << term << ": " << count << "\n";
+}
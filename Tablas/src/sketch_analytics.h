@@ -0,0 +1,91 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "analytics.h"
+#include "sketch.h"
+
+
+struct SketchConfig {
+    std::string data_dir {"/app/data"};
+    unsigned threads {std::max(1u, std::thread::hardware_concurrency())};
+    size_t chunk_bytes {size_t(1) << 20};   // Tamaño de bloque de lectura por tarea
+};
+
+
+struct Estimate { // valor aproximado con su cota de error
+    double value {0};
+    double error {0};
+};
+
+
+// Dimensiones de un report_id necesarias para (a) y los cruces (c), (d) y (e)
+struct ReportKeys {
+    // Posición de la primera fila en incidents.csv: la única que conserva la clave primaria
+    // de la tabla incidents (las demás filas con el mismo report_id se ignoran)
+    uint64_t incident_pos {UINT64_MAX};
+    uint64_t category {0};    // hash de la categoría (0: sin incidente o sin categoría)
+    int year {0};             // (a): 0 si no hay incidente o la fecha no es válida
+    int fine_year {0};        // (e): año de la fecha sin sus espacios, como esa consulta
+    // (hash de la detección normalizada, filas de details): el JOIN de (c) cuenta cada outcome
+    // una vez por fila de details
+    std::vector<std::pair<uint64_t, uint32_t>> detections;
+};
+
+
+// Todo lo que se acumula al leer un bloque; los bloques se combinan con merge()
+struct SketchState {
+    // Contadores exactos de baja cardinalidad (detections por valor exacto, sin minúsculas)
+    std::unordered_map<std::string, uint64_t> categories, detections, transports, intelligence_transports;
+    // (a): report_id vacío (NULL en SQLite, nunca choca con la clave primaria) durante la
+    // lectura; tras la primera fase se suman las primeras filas de cada report_id del índice
+    std::map<int, uint64_t> incidents_by_year;
+    uint64_t null_incidents {0};
+    uint64_t incident_rows {0}, detail_rows {0}, outcome_rows {0};
+    // report_id distintos por archivo
+    HyperLogLog incident_ids, detail_ids, outcome_ids;
+    // Términos de subject
+    HeavyHitters subject_terms;
+    // Cuantiles de multas (> 0) y de sentencias en días
+    TDigest fines, prison_days;
+    // Agregados de los cruces con outcomes: (suma, filas) por clave
+    std::unordered_map<uint64_t, std::pair<double, uint64_t>> arrests_by_detection, days_by_category;
+    std::map<int, double> fines_by_year;
+    // Índice compacto report_id -> dimensiones (solo incidents y details)
+    std::unordered_map<uint64_t, ReportKeys> keys;
+
+    void merge(SketchState&& other);
+};
+
+
+// Modo --sketch: una sola pasada en paralelo sobre incidents/details/outcomes.csv, sin SQLite.
+// Los archivos se mapean y se parten en bloques alineados a registros (con la paridad de
+// comillas de los bloques anteriores, porque subject puede tener saltos de línea entre
+// comillas); cada bloque acumula un SketchState y al final se combinan. incidents y details
+// se leen a la vez y después outcomes, que se cruza con el índice compacto de los anteriores.
+class SketchAnalytics {
+public:
+    explicit SketchAnalytics(const SketchConfig& cfg);
+
+    void scan();
+
+    Estimate total_incident_count() const;
+    TimeSeries incident_totals_by_year(int from_year, int to_year) const;
+    ResultSetKV top3_transport_by_intelligence() const;
+    ResultSetKV detection_by_avg_arrests(size_t topN) const;
+    ResultSetKV categories_with_longest_sentences_days(size_t topN) const;
+    TimeSeries fine_totals_per_year() const;
+    void print_report(std::ostream& out) const;
+
+private:
+    SketchConfig cfg_;
+    SketchState state_;
+    double seconds_ {0};
+    size_t bytes_read_ {0};
+    size_t chunks_ {0};
+};